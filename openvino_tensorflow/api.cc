@@ -9,22 +9,34 @@
 #endif
 #include <sys/stat.h>
 
+#include <atomic>
+#include <mutex>
+
 #include "tensorflow/core/lib/core/errors.h"
 
 #include "api.h"
 #include "backend_manager.h"
+#include "openvino_tensorflow/model_resources.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/placement_profile.h"
 
 namespace tensorflow {
 namespace openvino_tensorflow {
 namespace api {
 
-static bool _is_enabled = true;
-static bool _is_logging_placement = false;
+// The rewrite passes of concurrently created sessions read these while the
+// application may update them, so they are atomic or guarded by a mutex
+static std::atomic<bool> _is_enabled{true};
+static std::atomic<bool> _is_logging_placement{false};
 static std::set<std::string> disabled_op_types{};
+static std::mutex disabled_op_types_mutex;
 static char* backendName = nullptr;
 static char* backendList[4];
 static char* clusterInfo = nullptr;
 static char* errMsg = nullptr;
+static char* metricsStr = nullptr;
+static char* modelUsageStr = nullptr;
+static char* placementFiles = nullptr;
 
 extern "C" {
 void enable() { Enable(); }
@@ -82,13 +94,19 @@ void stop_logging_placement() { StopLoggingPlacement(); }
 bool is_logging_placement() { return IsLoggingPlacement(); }
 void EXPORT_SYMBOL freeClusterInfo() { free(clusterInfo); }
 void EXPORT_SYMBOL freeErrMsg() { free(errMsg); }
+void EXPORT_SYMBOL freeMetrics() { free(metricsStr); }
+void EXPORT_SYMBOL freeModelUsage() { free(modelUsageStr); }
+void EXPORT_SYMBOL freePlacementFiles() { free(placementFiles); }
 
 extern void set_disabled_ops(const char* op_type_list) {
   SetDisabledOps(std::string(op_type_list));
 }
 
 extern const char* get_disabled_ops() {
-  return ngraph::join(GetDisabledOps(), ",").c_str();
+  // Kept per thread so that the returned string outlives this call
+  static thread_local std::string disabled_ops;
+  disabled_ops = ngraph::join(GetDisabledOps(), ",");
+  return disabled_ops.c_str();
 }
 
 void enable_dynamic_fallback() { EnableDynamicFallback(); }
@@ -106,6 +124,42 @@ bool export_ir(const char* output_dir, char** cluster_info, char** err_msg) {
   *cluster_info = clusterInfo;
   return true;
 }
+
+void get_metrics(char** metrics) {
+  string str_metrics;
+  GetMetrics(str_metrics);
+  metricsStr = strdup(str_metrics.c_str());
+  *metrics = metricsStr;
+}
+
+void reset_metrics() { ResetMetrics(); }
+
+void get_model_usage(char** usage) {
+  string str_usage;
+  GetModelUsage(str_usage);
+  modelUsageStr = strdup(str_usage.c_str());
+  *usage = modelUsageStr;
+}
+
+void record_node_times(const char* node_times) {
+  RecordNodeTimes(string(node_times));
+}
+
+bool export_placement_profile(const char* output_dir, char** files,
+                              char** err_msg) {
+  string str_files("");
+  string str_err_msg("");
+  if (!ExportPlacementProfile(string(output_dir), str_files, str_err_msg)) {
+    errMsg = strdup(str_err_msg.c_str());
+    *err_msg = errMsg;
+    return false;
+  }
+  placementFiles = strdup(str_files.c_str());
+  *files = placementFiles;
+  return true;
+}
+
+void reset_placement_profile() { ResetPlacementProfile(); }
 }
 
 // note that TensorFlow always uses camel case for the C++ API, but not for
@@ -141,6 +195,8 @@ std::set<string> GetDisabledOps() {
     string disabled_ops_str = disabled_ops_char_ptr;
     SetDisabledOps(disabled_ops_str);
   }
+  // Callers get their own copy, which stays valid while the set is updated
+  std::lock_guard<std::mutex> guard(disabled_op_types_mutex);
   return disabled_op_types;
 }
 
@@ -157,7 +213,8 @@ void SetDisabledOps(string disabled_ops_str) {
 }
 
 void SetDisabledOps(set<string> disabled_ops_set) {
-  disabled_op_types = disabled_ops_set;
+  std::lock_guard<std::mutex> guard(disabled_op_types_mutex);
+  disabled_op_types = std::move(disabled_ops_set);
 }
 
 void EnableDynamicFallback() { NGraphClusterManager::EnableClusterFallback(); }
@@ -182,6 +239,36 @@ bool ExportIR(const string& output_dir, string& cluster_info, string& err_msg) {
   return true;
 }
 
+void GetMetrics(string& metrics) { Metrics::Dump(metrics); }
+
+void ResetMetrics() { Metrics::Reset(); }
+
+void GetModelUsage(string& usage) { ModelResources::Dump(usage); }
+
+void RecordNodeTimes(const string& node_times) {
+  PlacementProfile::RecordNodeTimes(node_times);
+}
+
+bool ExportPlacementProfile(const string& output_dir, string& files,
+                            string& err_msg) {
+  struct stat st;
+  if (stat(output_dir.c_str(), &st) != 0) {
+    err_msg = "Directory \"" + output_dir + "\" does not exist.";
+    return false;
+  }
+  vector<string> exported_files;
+  Status status = PlacementProfile::Export(output_dir, exported_files);
+  if (!status.ok()) {
+    err_msg = status.error_message();
+    return false;
+  }
+  files = ngraph::join(exported_files, "\n");
+  err_msg = "";
+  return true;
+}
+
+void ResetPlacementProfile() { PlacementProfile::Reset(); }
+
 }  // namespace api
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
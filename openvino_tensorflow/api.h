@@ -49,6 +49,16 @@ extern EXPORT_SYMBOL void disable_dynamic_fallback();
 
 extern EXPORT_SYMBOL bool export_ir(const char* output_dir, char** cluster_info,
                                     char** err_msg);
+
+extern EXPORT_SYMBOL void get_metrics(char** metrics);
+extern EXPORT_SYMBOL void reset_metrics();
+extern EXPORT_SYMBOL void get_model_usage(char** usage);
+
+extern EXPORT_SYMBOL void record_node_times(const char* node_times);
+extern EXPORT_SYMBOL bool export_placement_profile(const char* output_dir,
+                                                   char** files,
+                                                   char** err_msg);
+extern EXPORT_SYMBOL void reset_placement_profile();
 }
 
 extern void Enable();
@@ -73,6 +83,17 @@ extern void DisableDynamicFallback();
 
 extern bool ExportIR(const string& output_dir, string& cluster_info,
                      string& err_msg);
+
+extern void GetMetrics(string& metrics);
+extern void ResetMetrics();
+// One "<model>\t<counter> <value>" line per counter
+extern void GetModelUsage(string& usage);
+
+extern void RecordNodeTimes(const string& node_times);
+// Returns the paths of the exported files, one per line
+extern bool ExportPlacementProfile(const string& output_dir, string& files,
+                                   string& err_msg);
+extern void ResetPlacementProfile();
 }  // namespace api
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -277,6 +277,10 @@ void MergeClusters(Edge* edge,
 // Adds an attribute "_ovtf_cluster" (cluster_id) to each Node that can be
 // encapsulated
 Status AssignClusters(Graph* graph) {
+  // Read once, so that toggling placement logging while the pass runs can't
+  // leave the collected information half filled
+  const bool log_placement = api::IsLoggingPlacement();
+
   std::map<Node*, std::shared_ptr<Cluster>> cluster_map;
 
   std::unique_ptr<DeadnessAnalysis> deadness_analyzer;
@@ -605,7 +609,7 @@ Status AssignClusters(Graph* graph) {
       }
     }
 
-    if (!changed && api::IsLoggingPlacement()) {
+    if (!changed && log_placement) {
       // This will be entered only once if logging is enabled
       // When entered, it will force the do-while to run one last time,
       // collecting information
@@ -677,7 +681,7 @@ Status AssignClusters(Graph* graph) {
       // TODO(amprocte): move attr name to a constant
       node->AddAttr("_ovtf_cluster", (int)cluster_idx);
 
-      if (api::IsLoggingPlacement()) {
+      if (log_placement) {
         // map from cluster id to ovtf_cluster id
         cluster_to_encapsulate[cluster->index] = cluster_idx;
       }
@@ -687,7 +691,7 @@ Status AssignClusters(Graph* graph) {
   }
   OVTF_VLOG(2) << "Tagging done";
 
-  if (api::IsLoggingPlacement()) {
+  if (log_placement) {
     int num_reasons = 6;  // the number of elements in the reasons enum
     // histogram of reasons of non-contraction of clusters
     vector<int> reason_count_clusters(num_reasons, 0);
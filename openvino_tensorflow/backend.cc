@@ -8,8 +8,10 @@
 
 #include <ie_core.hpp>
 #include "contexts.h"
+#include "logging/ovtf_log.h"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/opsets/opset.hpp"
+#include "openvino_tensorflow/ie_autotuner.h"
 
 using namespace std;
 using namespace ngraph;
@@ -69,14 +71,26 @@ Backend::Backend(const string& config) {
   }
 }
 
-shared_ptr<Executable> Backend::Compile(shared_ptr<ngraph::Function> func,
-                                        bool) {
-  return make_shared<Executable>(func, m_device, m_device_type);
+shared_ptr<Executable> Backend::Compile(
+    shared_ptr<ngraph::Function> func, bool,
+    const map<string, string>& plugin_config) {
+  return make_shared<Executable>(func, m_device, m_device_type,
+                                 plugin_config);
 }
 
 GlobalContext& Backend::GetGlobalContext() {
-  if (!g_global_context)
+  if (!g_global_context) {
     g_global_context = unique_ptr<GlobalContext>(new GlobalContext);
+#if !defined(OPENVINO_2021_2) && !defined(OPENVINO_2021_3)
+    // Enable the compiled network cache of the Inference Engine. The
+    // auto-tuned configurations are stored in the same directory.
+    auto cache_dir = IE_AutoTuner::GetCacheDir();
+    if (!cache_dir.empty()) {
+      OVTF_VLOG(1) << "Using compiled network cache directory " << cache_dir;
+      g_global_context->ie_core.SetConfig({{"CACHE_DIR", cache_dir}});
+    }
+#endif
+  }
   return *g_global_context;
 }
 
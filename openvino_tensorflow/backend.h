@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -32,8 +33,9 @@ class Backend {
     ReleaseGlobalContext();
   }
 
-  shared_ptr<Executable> Compile(shared_ptr<ngraph::Function> func,
-                                 bool enable_performance_data = false);
+  shared_ptr<Executable> Compile(
+      shared_ptr<ngraph::Function> func, bool enable_performance_data = false,
+      const map<string, string>& plugin_config = {});
 
   static GlobalContext& GetGlobalContext();
   static void ReleaseGlobalContext();
@@ -15,12 +15,12 @@ std::vector<GraphDef*> NGraphClusterManager::s_cluster_graphs;
 std::vector<bool> NGraphClusterManager::s_cluster_fallback;
 std::vector<std::shared_ptr<Executable>>
     NGraphClusterManager::s_mru_executables;
-std::mutex NGraphClusterManager::s_cluster_graphs_mutex;
-bool NGraphClusterManager::s_cluster_fallback_enabled = true;
+std::mutex NGraphClusterManager::s_cluster_manager_mutex;
+std::atomic<bool> NGraphClusterManager::s_cluster_fallback_enabled{true};
 std::map<size_t, std::string> NGraphClusterManager::s_cluster_info;
 
 size_t NGraphClusterManager::NewCluster() {
-  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
 
   size_t new_idx = s_cluster_graphs.size();
   s_cluster_graphs.push_back(new GraphDef());
@@ -30,22 +30,28 @@ size_t NGraphClusterManager::NewCluster() {
 }
 
 GraphDef* NGraphClusterManager::GetClusterGraph(size_t idx) {
-  std::lock_guard<std::mutex> guard(s_cluster_graphs_mutex);
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   return idx < s_cluster_graphs.size() ? s_cluster_graphs[idx] : nullptr;
 }
 
 size_t NGraphClusterManager::NumberOfClusters() {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   return s_cluster_graphs.size();
 }
 
 void NGraphClusterManager::EvictAllClusters() {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   s_cluster_graphs.clear();
   s_cluster_fallback.clear();
 }
 
-void NGraphClusterManager::EvictMRUClusters() { s_mru_executables.clear(); }
+void NGraphClusterManager::EvictMRUClusters() {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
+  s_mru_executables.clear();
+}
 
 bool NGraphClusterManager::CheckClusterFallback(const size_t idx) {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   return (s_cluster_fallback_enabled && idx < s_cluster_fallback.size())
              ? s_cluster_fallback[idx]
              : false;
@@ -53,6 +59,7 @@ bool NGraphClusterManager::CheckClusterFallback(const size_t idx) {
 
 void NGraphClusterManager::SetClusterFallback(const size_t idx,
                                               const bool fallback) {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   if (s_cluster_fallback_enabled && idx < s_cluster_fallback.size())
     s_cluster_fallback[idx] = fallback;
 }
@@ -71,22 +78,31 @@ bool NGraphClusterManager::IsClusterFallbackEnabled() {
 
 void NGraphClusterManager::SetMRUExecutable(
     const size_t idx, std::shared_ptr<Executable> mru_executable_ptr) {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   if (idx < s_mru_executables.size())
     s_mru_executables[idx] = mru_executable_ptr;
 }
 
 void NGraphClusterManager::ExportMRUIRs(const string& output_dir) {
-  for (int i = 0; i < s_mru_executables.size(); i++) {
-    if (s_mru_executables[i]) s_mru_executables[i]->ExportIR(output_dir);
+  // Exporting can be slow, so it is done on a copy, outside of the lock
+  std::vector<std::shared_ptr<Executable>> mru_executables;
+  {
+    std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
+    mru_executables = s_mru_executables;
+  }
+  for (int i = 0; i < mru_executables.size(); i++) {
+    if (mru_executables[i]) mru_executables[i]->ExportIR(output_dir);
   }
 }
 
 void NGraphClusterManager::SetClusterInfo(const size_t idx,
                                           const string cluster_info) {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   s_cluster_info[idx] = cluster_info;
 }
 
 void NGraphClusterManager::DumpClusterInfos(string& cluster_infos) {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   cluster_infos = "";
   for (int i = 0; i < s_mru_executables.size(); i++) {
     if (s_mru_executables[i]) cluster_infos += s_cluster_info[i] + "\n";
@@ -94,6 +110,7 @@ void NGraphClusterManager::DumpClusterInfos(string& cluster_infos) {
 }
 
 void NGraphClusterManager::ClearMRUClusters() {
+  std::lock_guard<std::mutex> guard(s_cluster_manager_mutex);
   s_mru_executables.assign(s_mru_executables.size(), nullptr);
 }
 }  // namespace openvino_tensorflow
@@ -6,6 +6,7 @@
 #ifndef OPENVINO_TF_CLUSTER_MANAGER_H_
 #define OPENVINO_TF_CLUSTER_MANAGER_H_
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -16,6 +17,9 @@
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// Registry of the cluster graphs and of their most recently used executables.
+// The rewrite passes of concurrently created sessions and the encapsulate ops
+// access it from different threads, so every method is thread-safe.
 class NGraphClusterManager {
  public:
   static size_t NewCluster();
@@ -40,8 +44,8 @@ class NGraphClusterManager {
   static std::vector<std::shared_ptr<Executable>> s_mru_executables;
   static std::map<size_t, std::string> s_cluster_info;
   static std::vector<bool> s_cluster_fallback;
-  static bool s_cluster_fallback_enabled;
-  static std::mutex s_cluster_graphs_mutex;
+  static std::atomic<bool> s_cluster_fallback_enabled;
+  static std::mutex s_cluster_manager_mutex;
 };
 
 }  // namespace openvino_tensorflow
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/compile_scheduler.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_timer.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex CompileScheduler::s_mutex;
+std::condition_variable CompileScheduler::s_cv;
+int CompileScheduler::s_running = 0;
+int64 CompileScheduler::s_reserved_bytes = 0;
+uint64 CompileScheduler::s_next_id = 0;
+std::deque<uint64> CompileScheduler::s_queue;
+
+CompileScheduler::Ticket::~Ticket() {
+  CompileScheduler::Release(m_estimated_bytes);
+}
+
+int CompileScheduler::GetMaxConcurrentCompiles() {
+  string env = util::GetEnv("OPENVINO_TF_MAX_CONCURRENT_COMPILES");
+  return env.empty() ? 0 : max(0, atoi(env.c_str()));
+}
+
+int64 CompileScheduler::GetMemoryBudget() {
+  string env = util::GetEnv("OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB");
+  return env.empty() ? 0 : max<int64>(0, atoll(env.c_str())) * 1024 * 1024;
+}
+
+bool CompileScheduler::IsEnabled() {
+  return GetMaxConcurrentCompiles() > 0 || GetMemoryBudget() > 0;
+}
+
+bool CompileScheduler::CanStart(int64 estimated_bytes) {
+  if (s_running == 0) return true;
+  int max_compiles = GetMaxConcurrentCompiles();
+  if (max_compiles > 0 && s_running >= max_compiles) return false;
+  int64 budget = GetMemoryBudget();
+  return budget == 0 || s_reserved_bytes + estimated_bytes <= budget;
+}
+
+unique_ptr<CompileScheduler::Ticket> CompileScheduler::TryAdmit(
+    int64 estimated_bytes) {
+  lock_guard<mutex> lock(s_mutex);
+  if (!s_queue.empty() || !CanStart(estimated_bytes)) {
+    return nullptr;
+  }
+  s_running++;
+  s_reserved_bytes += estimated_bytes;
+  Metrics::Increment("compile_admissions");
+  return unique_ptr<Ticket>(new Ticket(estimated_bytes));
+}
+
+unique_ptr<CompileScheduler::Ticket> CompileScheduler::Admit(
+    int64 estimated_bytes, const function<bool()>& cancelled) {
+  Timer queue_wait;
+  unique_lock<mutex> lock(s_mutex);
+  uint64 id = s_next_id++;
+  s_queue.push_back(id);
+  Metrics::UpdateMax("compile_queue_max_length", s_queue.size());
+  while (s_queue.front() != id || !CanStart(estimated_bytes)) {
+    if (cancelled()) {
+      s_queue.erase(find(s_queue.begin(), s_queue.end(), id));
+      s_cv.notify_all();
+      Metrics::Increment("compile_queue_abandoned");
+      return nullptr;
+    }
+    // Woken up by a released ticket; the timeout polls for cancellation
+    s_cv.wait_for(lock, chrono::milliseconds(10));
+  }
+  s_queue.pop_front();
+  s_running++;
+  s_reserved_bytes += estimated_bytes;
+  // The next compile in the queue may fit as well
+  s_cv.notify_all();
+
+  int64 wait_us = queue_wait.ElapsedInMicroSec();
+  OVTF_VLOG(1) << "Compile admitted after waiting " << wait_us << " us, "
+               << s_running << " compiles running, " << s_reserved_bytes
+               << " bytes reserved";
+  Metrics::Increment("compile_admissions");
+  Metrics::Increment("compile_queue_waits");
+  Metrics::Increment("compile_queue_wait_us", wait_us);
+  Metrics::UpdateMax("compile_queue_max_wait_us", wait_us);
+  return unique_ptr<Ticket>(new Ticket(estimated_bytes));
+}
+
+void CompileScheduler::Release(int64 estimated_bytes) {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    s_running--;
+    s_reserved_bytes -= estimated_bytes;
+  }
+  s_cv.notify_all();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_COMPILE_SCHEDULER_H_
+#define OPENVINO_TF_COMPILE_SCHEDULER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Process-wide admission control of the compiles, i.e. of the translation,
+// the creation of the executable and the loading of the network on its first
+// call. At most OPENVINO_TF_MAX_CONCURRENT_COMPILES compiles run at the same
+// time, and their total estimated memory stays within
+// OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB, except that a compile is always
+// admitted when no other one is running. Waiting compiles are admitted in
+// arrival order.
+class CompileScheduler {
+ public:
+  // Holds a compile slot and its share of the memory budget until destroyed
+  class Ticket {
+   public:
+    ~Ticket();
+
+   private:
+    friend class CompileScheduler;
+    explicit Ticket(int64 estimated_bytes)
+        : m_estimated_bytes(estimated_bytes) {}
+    int64 m_estimated_bytes;
+  };
+
+  // Returns true if either limit is set
+  static bool IsEnabled();
+  // Returns a ticket if the compile can start right away, nullptr otherwise
+  static std::unique_ptr<Ticket> TryAdmit(int64 estimated_bytes);
+  // Waits for the compile to be admitted. Returns nullptr if cancelled
+  // returns true while waiting.
+  static std::unique_ptr<Ticket> Admit(int64 estimated_bytes,
+                                       const std::function<bool()>& cancelled);
+
+  static int GetMaxConcurrentCompiles();
+  static int64 GetMemoryBudget();
+
+ private:
+  // Requires s_mutex
+  static bool CanStart(int64 estimated_bytes);
+  static void Release(int64 estimated_bytes);
+
+  static std::mutex s_mutex;
+  static std::condition_variable s_cv;
+  static int s_running;
+  static int64 s_reserved_bytes;
+  static uint64 s_next_id;
+  static std::deque<uint64> s_queue;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_COMPILE_SCHEDULER_H_
@@ -47,10 +47,36 @@ static bool cmp(pair<int, std::set<Node*>>& a, pair<int, std::set<Node*>>& b) {
   return a.second.size() > b.second.size();
 }
 
-unordered_map<string, int> deassigned_histogram;
-int num_nodes_marked_before_deassign = 0;
+// State of a single DeassignClusters invocation. Graphs of concurrently
+// created sessions are rewritten in parallel, so nothing here may be global.
+struct DeassignContext {
+  unordered_map<string, int> deassigned_histogram;
+  int num_nodes_marked_before_deassign = 0;
+  // Snapshot of api::IsLoggingPlacement(), so that the summary stays
+  // consistent if placement logging is toggled while the pass runs
+  bool log_placement = false;
+};
+
+// Removes the cluster assignment of the given nodes
+static void DeassignNodes(const std::set<Node*>& nodes,
+                          DeassignContext& context) {
+  for (auto node : nodes) {
+    OVTF_VLOG(2) << "Busting node: " << node->name() << " ["
+                 << node->type_string() << "]";
+
+    // TODO(amprocte): move attr name to a constant
+    node->ClearAttr("_ovtf_cluster");
+    // TODO(amprocte): move attr name to a constant
+    node->ClearAttr("_ovtf_marked_for_clustering");
+
+    context.deassigned_histogram[node->type_string()]++;
+  }
+}
 
-static void MaybeLogPlacement(const Graph* graph) {
+static void MaybeLogPlacement(const Graph* graph,
+                              const DeassignContext& context) {
+  const int num_nodes_marked_before_deassign =
+      context.num_nodes_marked_before_deassign;
   std::map<int, std::set<const Node*>> final_cluster_map;
   int number_of_nodes = 0, nodes_marked_for_clustering = 0,
       nodes_assigned_a_cluster = 0, functional_nodes = 0;
@@ -92,7 +118,7 @@ static void MaybeLogPlacement(const Graph* graph) {
             << perc_assigned_clusters_of_total
             << "%) are now running with OpenVINO™ backend" << std::endl;
 
-  if (api::IsLoggingPlacement()) {
+  if (context.log_placement) {
     std::cout << "\n";  // insert a new line at the start of OVTF_SUMMARY
     std::cout << "OVTF_SUMMARY: Number of nodes in the graph: "
               << number_of_nodes << std::endl;
@@ -128,18 +154,18 @@ static void MaybeLogPlacement(const Graph* graph) {
                                  ": " + std::to_string(perc_nodes_assigned) +
                                  "%";
       NGraphClusterManager::SetClusterInfo(cluster_idx, cluster_info);
-      if (api::IsLoggingPlacement()) {
+      if (context.log_placement) {
         std::cout << "OVTF_SUMMARY: Size of nGraph Cluster[" << cluster_idx
                   << "]:\t" << kv.second.size() << std::endl;
       }
     }
   }
 
-  if (!api::IsLoggingPlacement()) return;
+  if (!context.log_placement) return;
 
   // log the ops gets deassigned
   std::cout << "OVTF_SUMMARY: Op_deassigned: ";
-  util::PrintNodeHistogram(deassigned_histogram);
+  util::PrintNodeHistogram(context.deassigned_histogram);
 
   for (auto kv : final_cluster_map) {
     int cluster_idx = kv.first;
@@ -160,23 +186,23 @@ static void MaybeLogPlacement(const Graph* graph) {
 }
 
 Status DeassignClusters(Graph* graph) {
+  DeassignContext context;
+  context.log_placement = api::IsLoggingPlacement();
+
   //
   // When running unit tests, we do not want to see trivial clusters
   // deassigned. This flag (used by the Python tests) makes this possible.
   //
-  num_nodes_marked_before_deassign = 0;  // reset for every TF graph
-  deassigned_histogram.clear();          // reset the histogram
-
   if (std::getenv("OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS") != nullptr) {
     // still need to calculate num_nodes_marked_before_deassign
     for (auto node : graph->nodes()) {
       int cluster_idx;
 
       if (GetNodeCluster(node, &cluster_idx) == Status::OK()) {
-        num_nodes_marked_before_deassign++;
+        context.num_nodes_marked_before_deassign++;
       }
     }
-    MaybeLogPlacement(graph);
+    MaybeLogPlacement(graph, context);
     return Status::OK();
   }
 
@@ -188,7 +214,7 @@ Status DeassignClusters(Graph* graph) {
       continue;
     }
 
-    num_nodes_marked_before_deassign++;
+    context.num_nodes_marked_before_deassign++;
     cluster_map[cluster_idx].insert(node);
   }
 
@@ -212,9 +238,9 @@ Status DeassignClusters(Graph* graph) {
       }
     }
 
-    int min_non_trivial_nodes = num_nodes_marked_before_deassign >> 5;
+    int min_non_trivial_nodes = context.num_nodes_marked_before_deassign >> 5;
     int avg_nodes_marked_before_deassign =
-        num_nodes_marked_before_deassign / cluster_map.size();
+        context.num_nodes_marked_before_deassign / cluster_map.size();
     if (min_non_trivial_nodes < avg_nodes_marked_before_deassign * 2) {
       min_non_trivial_nodes >>= 2;
     }
@@ -229,17 +255,7 @@ Status DeassignClusters(Graph* graph) {
 
     if (non_trivial_count < min_non_trivial_nodes) {
       OVTF_VLOG(2) << "Busting cluster " << cluster_idx;
-      for (auto node : nodes) {
-        OVTF_VLOG(2) << "Busting node: " << node->name() << " ["
-                     << node->type_string() << "]";
-
-        // TODO(amprocte): move attr name to a constant
-        node->ClearAttr("_ovtf_cluster");
-        // TODO(amprocte): move attr name to a constant
-        node->ClearAttr("_ovtf_marked_for_clustering");
-
-        deassigned_histogram[node->type_string()]++;
-      }
+      DeassignNodes(nodes, context);
       continue;
     }
     // Disable dynamic to static
@@ -280,17 +296,7 @@ Status DeassignClusters(Graph* graph) {
     }
     if (invalid_dyn_op) {
       OVTF_VLOG(2) << "Busting cluster " << cluster_idx;
-      for (auto node : nodes) {
-        OVTF_VLOG(2) << "Busting node: " << node->name() << " ["
-                     << node->type_string() << "]";
-
-        // TODO(amprocte): move attr name to a constant
-        node->ClearAttr("_ovtf_cluster");
-        // TODO(amprocte): move attr name to a constant
-        node->ClearAttr("_ovtf_marked_for_clustering");
-
-        deassigned_histogram[node->type_string()]++;
-      }
+      DeassignNodes(nodes, context);
       continue;
     }
 
@@ -321,11 +327,7 @@ Status DeassignClusters(Graph* graph) {
       if (omit_cluster) break;
     }
     if (omit_cluster) {
-      for (auto node : nodes) {
-        node->ClearAttr("_ovtf_cluster");
-        node->ClearAttr("_ovtf_marked_for_clustering");
-        deassigned_histogram[node->type_string()]++;
-      }
+      DeassignNodes(nodes, context);
       continue;
     }
 
@@ -360,11 +362,7 @@ Status DeassignClusters(Graph* graph) {
         }
       }
       if (omit_cluster) {
-        for (auto node : nodes) {
-          node->ClearAttr("_ovtf_cluster");
-          node->ClearAttr("_ovtf_marked_for_clustering");
-          deassigned_histogram[node->type_string()]++;
-        }
+        DeassignNodes(nodes, context);
         continue;
       }
     }
@@ -383,13 +381,7 @@ Status DeassignClusters(Graph* graph) {
     for (int i = 0; i < alive_clusters.size(); i++) {
       int alive_cluster_idx = alive_clusters[i];
       if (alive_cluster_idx != max_cluster_idx) {
-        set<Node*>& nodes = cluster_map[alive_cluster_idx];
-
-        for (auto node : nodes) {
-          node->ClearAttr("_ovtf_cluster");
-          node->ClearAttr("_ovtf_marked_for_clustering");
-          deassigned_histogram[node->type_string()]++;
-        }
+        DeassignNodes(cluster_map[alive_cluster_idx], context);
       }
     }
   }
@@ -398,7 +390,7 @@ Status DeassignClusters(Graph* graph) {
   // At this point we have made our final decision about cluster assignment, so
   // we will log the cluster assignment now.
   //
-  MaybeLogPlacement(graph);
+  MaybeLogPlacement(graph, context);
 
   return Status::OK();
 }
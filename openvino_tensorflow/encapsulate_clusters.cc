@@ -38,6 +38,8 @@
 #include "openvino_tensorflow/encapsulate_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_timer.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 #include "openvino_tensorflow/version.h"
 
@@ -69,11 +71,16 @@ void Encapsulator::AddInput(NodeDef* dst, StringPiece src_name, int src_slot) {
 Status EncapsulateClusters(
     Graph* graph, int graph_id,
     const std::unordered_map<std::string, std::string>& device_config) {
+  Timer encapsulate_time;
   Encapsulator enc(graph);
   OVTF_VLOG(3) << "Running AnalysisPass in EncapsulateClusters";
   TF_RETURN_IF_ERROR(enc.AnalysisPass());
   OVTF_VLOG(3) << "Running RewritePass in EncapsulateClusters";
   TF_RETURN_IF_ERROR(enc.RewritePass(graph_id, device_config));
+  int64 encapsulate_us = encapsulate_time.ElapsedInMicroSec();
+  Metrics::Increment("encapsulate_us", encapsulate_us);
+  OVTF_VLOG(1) << "Encapsulated the clusters of graph " << graph_id << " in "
+               << encapsulate_us << " us";
 
   set<int> newly_created_cluster_ids;
   TF_RETURN_IF_ERROR(enc.GetNewClusterIDs(newly_created_cluster_ids));
@@ -109,6 +116,56 @@ Status EncapsulateClusters(
 Encapsulator::Encapsulator(Graph* g)
     : graph(g), analysis_done(false), rewrite_done(false) {}
 
+int Encapsulator::NodeCluster(const Node* node) const {
+  return node->id() < static_cast<int>(node_cluster_map.size())
+             ? node_cluster_map[node->id()]
+             : -1;
+}
+
+const Encapsulator::RemapEntry* Encapsulator::FindRemapEntry(
+    const std::vector<RemapEntry>& entries, int src_output, int cluster_idx) {
+  // A node has only a handful of outputs crossing cluster boundaries, so a
+  // linear search is faster than any map here
+  for (const auto& entry : entries) {
+    if (entry.src_output == src_output && entry.cluster_idx == cluster_idx) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void Encapsulator::FindInputSource(const Edge* edge, int cluster_idx,
+                                   Node** src, int* src_output) const {
+  *src = edge->src();
+  *src_output = edge->src_output();
+  static const std::set<string> identity_ops = {"Identity", "Snapshot",
+                                                "StopGradient"};
+  while (identity_ops.count((*src)->type_string()) &&
+         NodeCluster(*src) == -1 && !IsRefType((*src)->input_type(0))) {
+    const Edge* input_edge = nullptr;
+    bool has_control_input = false;
+    for (auto in_edge : (*src)->in_edges()) {
+      if (in_edge->IsControlEdge()) {
+        has_control_input = true;
+      } else {
+        input_edge = in_edge;
+      }
+    }
+    // A control input delays the identity, and a device change copies the
+    // tensor, so the identity is kept in both cases. The value must also
+    // still come from outside the cluster.
+    if (has_control_input || input_edge == nullptr ||
+        !input_edge->src()->IsOp() ||
+        NodeCluster(input_edge->src()) == cluster_idx ||
+        input_edge->src()->assigned_device_name() !=
+            (*src)->assigned_device_name()) {
+      return;
+    }
+    *src = input_edge->src();
+    *src_output = input_edge->src_output();
+  }
+}
+
 Status Encapsulator::AnalysisPass() {
   if (rewrite_done) {
     return errors::Internal(
@@ -120,14 +177,23 @@ Status Encapsulator::AnalysisPass() {
     return errors::Internal(
         "In Encapsulator, AnalysisPass called more than once");
   }
+
+  node_cluster_map.assign(graph->num_node_ids(), -1);
+  output_remap_map.resize(graph->num_node_ids());
+  input_remap_map.resize(graph->num_node_ids());
+
   // Pass 1: Populate the cluster-index-to-device name map for each existing
   // cluster. PIGGYBACKING BACKEND TEST HERE, THEY WILL GET COMBINED INTO ONE
+  // The cluster of each node is cached here, so that the "_ovtf_cluster"
+  // attribute is looked up only once per node.
   for (auto node : graph->op_nodes()) {
     int cluster_idx;
 
     if (GetNodeCluster(node, &cluster_idx) != Status::OK()) {
       continue;
     }
+    node_cluster_map[node->id()] = cluster_idx;
+    cluster_nodes_map[cluster_idx].push_back(node);
 
     auto it = device_name_map.find(cluster_idx);
     if (it != device_name_map.end()) {
@@ -148,8 +214,53 @@ Status Encapsulator::AnalysisPass() {
     }
   }
 
+  // Pass 1b: Find the clustered nodes that have a data path to an output of
+  // their cluster, going backwards from the nodes read outside of it. A
+  // cluster without any output is kept whole.
+  node_needed_map.assign(graph->num_node_ids(), false);
+  std::vector<Node*> needed_nodes;
+  for (auto& kv : cluster_nodes_map) {
+    for (auto node : kv.second) {
+      for (auto edge : node->out_edges()) {
+        if (!edge->IsControlEdge() && NodeCluster(edge->dst()) != kv.first) {
+          node_needed_map[node->id()] = true;
+          needed_nodes.push_back(node);
+          break;
+        }
+      }
+    }
+  }
+  while (!needed_nodes.empty()) {
+    Node* node = needed_nodes.back();
+    needed_nodes.pop_back();
+    for (auto edge : node->in_edges()) {
+      Node* src = edge->src();
+      if (!edge->IsControlEdge() && NodeCluster(src) == NodeCluster(node) &&
+          !node_needed_map[src->id()]) {
+        node_needed_map[src->id()] = true;
+        needed_nodes.push_back(src);
+      }
+    }
+  }
+  for (auto& kv : cluster_nodes_map) {
+    bool any_needed = false;
+    for (auto node : kv.second) {
+      any_needed |= node_needed_map[node->id()];
+    }
+    if (!any_needed) {
+      for (auto node : kv.second) {
+        node_needed_map[node->id()] = true;
+      }
+    }
+  }
+
   // Pass 2: Find all nodes that are feeding into/out of each cluster, and
   // add inputs for them to the corresponding FunctionDef(s).
+  // The (src node, src output, cluster) read by all the clustered nodes and by
+  // the needed ones, before looking through the identities, to count the
+  // inputs that were pruned or merged
+  std::set<std::tuple<int, int, int>> read_inputs, needed_inputs;
+  int num_args = 0;
   std::map<int, int> retval_index_count;
   std::map<int, int> arg_index_count;
   int count_arg = 0, count_retval = 0, count_both_arg_retval = 0,
@@ -174,16 +285,14 @@ Status Encapsulator::AnalysisPass() {
       continue;
     }
 
-    int dst_cluster_idx;
-    bool dst_clustered =
-        (GetNodeCluster(dst, &dst_cluster_idx) == Status::OK());
+    int dst_cluster_idx = NodeCluster(dst);
+    bool dst_clustered = (dst_cluster_idx != -1);
 
-    int src_cluster_idx;
-    bool src_clustered =
-        (GetNodeCluster(src, &src_cluster_idx) == Status::OK());
+    int src_cluster_idx = NodeCluster(src);
+    bool src_clustered = (src_cluster_idx != -1);
 
     // Ignore edges within a cluster. (Note that this test also works when
-    // both nodes are unclustered; GetNodeCluster gives us -1 in that case.
+    // both nodes are unclustered; NodeCluster gives us -1 in that case.
     if (dst_cluster_idx == src_cluster_idx) {
       count_encapsulated++;
       continue;
@@ -191,30 +300,27 @@ Status Encapsulator::AnalysisPass() {
 
     // Some debug logging...
     DataType dt = dst->input_type(edge->dst_input());
-    std::string flow_kind = dst_clustered && src_clustered
-                                ? "cross-flow"
-                                : dst_clustered ? "in-flow" : "out-flow";
-
-    OVTF_VLOG(4) << "found " << flow_kind << ": " << src->name() << "["
-                 << edge->src_output() << "] in " << src_cluster_idx << " to "
-                 << dst->name() << "[" << edge->dst_input() << "] in "
-                 << dst_cluster_idx << ", datatype: " << dt;
+    OVTF_VLOG(4) << "found "
+                 << (dst_clustered && src_clustered
+                         ? "cross-flow"
+                         : dst_clustered ? "in-flow" : "out-flow")
+                 << ": " << src->name() << "[" << edge->src_output() << "] in "
+                 << src_cluster_idx << " to " << dst->name() << "["
+                 << edge->dst_input() << "] in " << dst_cluster_idx
+                 << ", datatype: " << dt;
 
     bool edge_is_retval = false, edge_is_arg = false;
 
     // If the source node lies within a cluster, we must create an output for
     // it from the source cluster. For the moment we will just store this
     // fact in the output_remap_map.
-    if (src_clustered &&
-        output_remap_map.find(std::make_tuple(src->id(), edge->src_output())) ==
-            output_remap_map.end()) {
-      output_remap_map[std::make_tuple(src->id(), edge->src_output())] =
-          std::make_tuple(src_cluster_idx,
-                          cluster_output_dt_map[src_cluster_idx].size());
+    auto& src_outputs = output_remap_map[src->id()];
+    if (src_clustered && FindRemapEntry(src_outputs, edge->src_output(),
+                                        src_cluster_idx) == nullptr) {
+      auto& output_dts = cluster_output_dt_map[src_cluster_idx];
+      src_outputs.push_back(RemapEntry{edge->src_output(), src_cluster_idx,
+                                       static_cast<int>(output_dts.size())});
 
-      std::stringstream ss;
-      ss << "ngraph_output_" << cluster_output_dt_map[src_cluster_idx].size();
-      string output_name = ss.str();
       auto new_output_node_def =
           NGraphClusterManager::GetClusterGraph(src_cluster_idx)->add_node();
 
@@ -223,14 +329,13 @@ Status Encapsulator::AnalysisPass() {
       *new_output_node_def = src_node_def;
       new_output_node_def->Clear();
 #endif
-      new_output_node_def->set_name(output_name);
+      new_output_node_def->set_name(
+          strings::StrCat("ngraph_output_", output_dts.size()));
       new_output_node_def->set_op("_Retval");
       edge_is_retval = true;
 
-      std::stringstream ss_input_to_retval;
-      ss_input_to_retval << src->name() << ":" << edge->src_output();
-
-      new_output_node_def->add_input(ss_input_to_retval.str());
+      new_output_node_def->add_input(
+          strings::StrCat(src->name(), ":", edge->src_output()));
 
       SetAttrValue(dt, &((*(new_output_node_def->mutable_attr()))["T"]));
       SetAttrValue(retval_index_count[src_cluster_idx],
@@ -238,55 +343,67 @@ Status Encapsulator::AnalysisPass() {
 
       retval_index_count[src_cluster_idx]++;
 
-      cluster_output_dt_map[src_cluster_idx].push_back(dt);
+      output_dts.push_back(dt);
     }
 
     // If the destination node lies within a cluster, we must create an input
     // for the source node to the destination cluster. For the moment we will
     // just store this fact in the input_remap_map.
-    if (dst_clustered &&
-        input_remap_map.find(
-            std::make_tuple(dst_cluster_idx, src->id(), edge->src_output())) ==
-            input_remap_map.end()) {
-      input_remap_map[std::make_tuple(dst_cluster_idx, src->id(),
-                                      edge->src_output())] =
-          cluster_input_map[dst_cluster_idx].size();
-
-      std::stringstream ss;
-      ss << "ngraph_input_" << cluster_input_map[dst_cluster_idx].size();
-      std::string new_input_name = ss.str();
-
-      input_rename_map[std::make_tuple(dst_cluster_idx, src->name(),
-                                       edge->src_output())] = new_input_name;
-      string input_prov_tag = src->name();
-
-      auto new_input_node_def =
-          NGraphClusterManager::GetClusterGraph(dst_cluster_idx)->add_node();
+    if (dst_clustered) {
+      read_inputs.emplace(src->id(), edge->src_output(), dst_cluster_idx);
+    }
+    if (dst_clustered && node_needed_map[dst->id()]) {
+      needed_inputs.emplace(src->id(), edge->src_output(), dst_cluster_idx);
+      Node* input_src;
+      int input_src_output;
+      FindInputSource(edge, dst_cluster_idx, &input_src, &input_src_output);
+      auto& src_inputs = input_remap_map[input_src->id()];
+      const RemapEntry* input_entry =
+          FindRemapEntry(src_inputs, input_src_output, dst_cluster_idx);
+      if (input_entry == nullptr) {
+        auto& inputs = cluster_input_map[dst_cluster_idx];
+        src_inputs.push_back(RemapEntry{input_src_output, dst_cluster_idx,
+                                        static_cast<int>(inputs.size())});
+        input_entry = &src_inputs.back();
+
+        auto new_input_node_def =
+            NGraphClusterManager::GetClusterGraph(dst_cluster_idx)->add_node();
 
 #ifdef _WIN32
-      auto src_node_def = src->def();
-      *new_input_node_def = src_node_def;
-      new_input_node_def->Clear();
+        auto src_node_def = src->def();
+        *new_input_node_def = src_node_def;
+        new_input_node_def->Clear();
 #endif
-      new_input_node_def->set_name(new_input_name);
-      new_input_node_def->set_op("_Arg");
-      edge_is_arg = true;
-
-      SetAttrValue(dt, &((*(new_input_node_def->mutable_attr()))["T"]));
-      SetAttrValue(arg_index_count[dst_cluster_idx],
-                   &((*(new_input_node_def->mutable_attr()))["index"]));
-      SetAttrValue(input_prov_tag,
-                   &((*(new_input_node_def->mutable_attr()))["_prov_tag"]));
-
-      if (src->type_string() == "ReadVariableOp") {
-        SetAttrValue(
-            true, &((*(new_input_node_def->mutable_attr()))["_is_variable"]));
-      }
+        new_input_node_def->set_name(
+            strings::StrCat("ngraph_input_", inputs.size()));
+        new_input_node_def->set_op("_Arg");
+        edge_is_arg = true;
+
+        SetAttrValue(dt, &((*(new_input_node_def->mutable_attr()))["T"]));
+        SetAttrValue(arg_index_count[dst_cluster_idx],
+                     &((*(new_input_node_def->mutable_attr()))["index"]));
+        SetAttrValue(input_src->name(),
+                     &((*(new_input_node_def->mutable_attr()))["_prov_tag"]));
+
+        if (input_src->type_string() == "ReadVariableOp") {
+          SetAttrValue(
+              true, &((*(new_input_node_def->mutable_attr()))["_is_variable"]));
+        }
+
+        arg_index_count[dst_cluster_idx]++;
+        num_args++;
 
-      arg_index_count[dst_cluster_idx]++;
+        inputs.push_back(
+            std::make_tuple(input_src->id(), input_src_output, dt));
+      }
 
-      cluster_input_map[dst_cluster_idx].push_back(
-          std::make_tuple(src->id(), edge->src_output(), dt));
+      // The input of the cluster is static if any of its consumers requires
+      // it to be. This is known from the node attributes set while marking,
+      // so there is no need to rebuild the cluster graph to find it out.
+      if (InputIsStatic(dst, edge->dst_input())) {
+        OVTF_VLOG(5) << "Marking edge static: " << edge->DebugString();
+        cluster_static_inputs_map[dst_cluster_idx].insert(input_entry->index);
+      }
     }
 
     if (api::IsLoggingPlacement()) {
@@ -302,7 +419,23 @@ Status Encapsulator::AnalysisPass() {
     }
   }
 
+  int num_pruned_inputs = read_inputs.size() - needed_inputs.size();
+  int num_merged_inputs = needed_inputs.size() - num_args;
+  if (num_pruned_inputs > 0) {
+    Metrics::Increment("pruned_cluster_inputs", num_pruned_inputs);
+  }
+  if (num_merged_inputs > 0) {
+    Metrics::Increment("merged_cluster_inputs", num_merged_inputs);
+  }
+  OVTF_VLOG(1) << "Cluster inputs: " << num_args << ", pruned (only read by "
+               << "nodes not needed for any output): " << num_pruned_inputs
+               << ", merged (same tensor through identities): "
+               << num_merged_inputs;
+
   if (api::IsLoggingPlacement()) {
+    std::cout << "OVTF_SUMMARY: Cluster inputs: " << num_args
+              << ", pruned: " << num_pruned_inputs
+              << ", merged: " << num_merged_inputs << endl;
     int computed_edge_number = count_arg + count_retval +
                                count_both_arg_retval + count_free +
                                count_encapsulated;
@@ -335,78 +468,79 @@ Status Encapsulator::AnalysisPass() {
   // copy into the ClusterManager
   // This is taken care of in the "if (edge->IsControlEdge())" line in the for
   // loop over all edges
-  for (auto node : graph->op_nodes()) {
-    int cluster_idx;
-
-    if (GetNodeAttr(node->attrs(), "_ovtf_cluster", &cluster_idx) !=
-        Status::OK()) {
-      continue;
-    }
+  std::vector<const Edge*> inputs;
+  for (auto& kv : cluster_nodes_map) {
+    int cluster_idx = kv.first;
+    GraphDef* gdef = NGraphClusterManager::GetClusterGraph(cluster_idx);
+    gdef->mutable_node()->Reserve(gdef->node_size() + kv.second.size());
 
-    // Because the input names may have changed from the original node def,
-    // we will need to borrow some code from Graph::ToGraphDefSubRange in
-    // tensorflow/core/graph/graph.cc that rewrites the node's input list.
-
-    // begin code copied and pasted (and modified) from graph.cc...
-    NodeDef original_def = node->def();
-
-    // Get the inputs for this Node.  We make sure control inputs are
-    // after data inputs, as required by GraphDef.
-    std::vector<const Edge*> inputs;
-    inputs.resize(node->num_inputs(), nullptr);
-    for (const Edge* edge : node->in_edges()) {
-      if (edge->IsControlEdge()) {
-        int src_cluster_idx;
-        auto ctrl_src = edge->src();
-        auto st = GetNodeCluster(ctrl_src, &src_cluster_idx);
-        if (st.ok()) {
-          if (src_cluster_idx == cluster_idx) {
+    for (auto node : kv.second) {
+      if (!node_needed_map[node->id()]) {
+        OVTF_VLOG(4) << "Leaving " << node->name() << " out of cluster "
+                     << cluster_idx << ", no output depends on it";
+        continue;
+      }
+      // Because the input names may have changed from the original node def,
+      // we will need to borrow some code from Graph::ToGraphDefSubRange in
+      // tensorflow/core/graph/graph.cc that rewrites the node's input list.
+
+      // begin code copied and pasted (and modified) from graph.cc...
+      // Get the inputs for this Node.  We make sure control inputs are
+      // after data inputs, as required by GraphDef.
+      inputs.assign(node->num_inputs(), nullptr);
+      for (const Edge* edge : node->in_edges()) {
+        if (edge->IsControlEdge()) {
+          if (NodeCluster(edge->src()) == cluster_idx &&
+              node_needed_map[edge->src()->id()]) {
             inputs.push_back(edge);
           }
+        } else {
+          CHECK(inputs[edge->dst_input()] == nullptr)
+              << "Edge " << edge->src()->DebugString() << ":"
+              << edge->dst()->DebugString() << " with dst_input "
+              << edge->dst_input() << " and had pre-existing input edge "
+              << inputs[edge->dst_input()]->src()->DebugString() << ":"
+              << inputs[edge->dst_input()]->dst()->DebugString();
+
+          inputs[edge->dst_input()] = edge;
         }
-      } else {
-        CHECK(inputs[edge->dst_input()] == nullptr)
-            << "Edge " << edge->src()->DebugString() << ":"
-            << edge->dst()->DebugString() << " with dst_input "
-            << edge->dst_input() << " and had pre-existing input edge "
-            << inputs[edge->dst_input()]->src()->DebugString() << ":"
-            << inputs[edge->dst_input()]->dst()->DebugString();
-
-        inputs[edge->dst_input()] = edge;
       }
-    }
-    original_def.clear_input();
-    original_def.mutable_input()->Reserve(inputs.size());
-
-    for (size_t i = 0; i < inputs.size(); ++i) {
-      const Edge* edge = inputs[i];
-      if (edge == nullptr) {
-        if (i < node->requested_inputs().size()) {
-          original_def.add_input(node->requested_inputs()[i]);
-        } else {
-          original_def.add_input("");
+
+      auto node_def = gdef->add_node();
+      *node_def = node->def();
+      node_def->clear_input();
+      node_def->mutable_input()->Reserve(inputs.size());
+
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        const Edge* edge = inputs[i];
+        if (edge == nullptr) {
+          if (i < node->requested_inputs().size()) {
+            node_def->add_input(node->requested_inputs()[i]);
+          } else {
+            node_def->add_input("");
+          }
+          continue;
         }
-      } else {
         const Node* src = edge->src();
         if (!src->IsOp()) continue;
-        AddInput(&original_def, src->name(), edge->src_output());
-      }
-    }
-    // ...end code copied and pasted (and modified) from graph.cc
-
-    auto node_def =
-        NGraphClusterManager::GetClusterGraph(cluster_idx)->add_node();
-    *node_def = original_def;
-    for (auto& input : *(node_def->mutable_input())) {
-      TensorId tensor_id = ParseTensorName(input);
-
-      string tensor_name(tensor_id.first);
-      auto it = input_rename_map.find(
-          std::make_tuple(cluster_idx, tensor_name, tensor_id.second));
-
-      if (it != input_rename_map.end()) {
-        input = it->second;
+        // Data inputs coming from outside the cluster read from the _Arg
+        // created for them in Pass 2
+        const RemapEntry* input_entry = nullptr;
+        if (!edge->IsControlEdge() && NodeCluster(src) != cluster_idx) {
+          Node* input_src;
+          int input_src_output;
+          FindInputSource(edge, cluster_idx, &input_src, &input_src_output);
+          input_entry = FindRemapEntry(input_remap_map[input_src->id()],
+                                       input_src_output, cluster_idx);
+        }
+        if (input_entry != nullptr) {
+          node_def->add_input(
+              strings::StrCat("ngraph_input_", input_entry->index));
+        } else {
+          AddInput(node_def, src->name(), edge->src_output());
+        }
       }
+      // ...end code copied and pasted (and modified) from graph.cc
     }
   }
 
@@ -429,14 +563,14 @@ Status Encapsulator::RewritePass(
   // Pass 3: Create encapsulation nodes for all clusters.
   for (auto& kv : device_name_map) {
     int cluster_idx = kv.first;
-    std::stringstream ss;
-    ss << "ovtf_cluster_" << cluster_idx;
-
-    string encap_node_name = ss.str();
+    string encap_node_name = strings::StrCat("ovtf_cluster_", cluster_idx);
+    const auto& cluster_inputs = cluster_input_map[cluster_idx];
     std::vector<DataType> input_types;
     std::vector<NodeBuilder::NodeOut> inputs;
+    input_types.reserve(cluster_inputs.size());
+    inputs.reserve(cluster_inputs.size());
 
-    for (auto& tup : cluster_input_map[cluster_idx]) {
+    for (auto& tup : cluster_inputs) {
       int src_node_id = -1;
       int src_output_idx = -1;
       DataType dt;
@@ -467,23 +601,14 @@ Status Encapsulator::RewritePass(
     }
 
     // Find Static Inputs And Add as an attribute
-    vector<int> static_input_indexes;
-    GraphDef* gdef_for_current_encapsulate;
-    gdef_for_current_encapsulate =
-        NGraphClusterManager::GetClusterGraph(cluster_idx);
-    if (gdef_for_current_encapsulate == nullptr) {
+    if (NGraphClusterManager::GetClusterGraph(cluster_idx) == nullptr) {
       return errors::Internal(
           "Did not find encapsulated graph in cluster manager for node ",
           encap_node_name);
     }
-    GraphConstructorOptions opts;
-    opts.allow_internal_ops = true;
-    Graph graph_for_current_encapsulate(OpRegistry::Global());
-    TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
-        opts, *gdef_for_current_encapsulate, &graph_for_current_encapsulate));
-
-    TF_RETURN_IF_ERROR(
-        GetStaticInputs(&graph_for_current_encapsulate, &static_input_indexes));
+    const auto& static_inputs = cluster_static_inputs_map[cluster_idx];
+    vector<int> static_input_indexes(static_inputs.begin(),
+                                     static_inputs.end());
 #ifdef _WIN32
     if (!static_input_indexes.empty()) {
       nb.Attr("_ovtf_static_inputs", static_input_indexes);
@@ -505,17 +630,16 @@ Status Encapsulator::RewritePass(
 
   // Copy the edge pointers, so as not to invalidate the iterator.
   std::vector<Edge*> edges;
+  edges.reserve(graph->num_edges());
   for (auto edge : graph->edges()) {
     edges.push_back(edge);
   }
 
   for (auto edge : edges) {
-    int src_cluster_idx;
-    bool src_clustered =
-        (GetNodeCluster(edge->src(), &src_cluster_idx) == Status::OK());
-    int dst_cluster_idx;
-    bool dst_clustered =
-        (GetNodeCluster(edge->dst(), &dst_cluster_idx) == Status::OK());
+    int src_cluster_idx = NodeCluster(edge->src());
+    bool src_clustered = (src_cluster_idx != -1);
+    int dst_cluster_idx = NodeCluster(edge->dst());
+    bool dst_clustered = (dst_cluster_idx != -1);
 
     if (src_cluster_idx == dst_cluster_idx) {
       continue;
@@ -541,16 +665,17 @@ Status Encapsulator::RewritePass(
         continue;
       }
 
-      auto it = output_remap_map.find(
-          std::make_tuple(edge->src()->id(), edge->src_output()));
+      const RemapEntry* output_entry =
+          src_clustered ? FindRemapEntry(output_remap_map[edge->src()->id()],
+                                         edge->src_output(), src_cluster_idx)
+                        : nullptr;
 
-      if (it == output_remap_map.end()) {
+      if (output_entry == nullptr) {
         continue;
       }
 
-      int cluster_idx = -1;
-      int cluster_output = -1;
-      std::tie(cluster_idx, cluster_output) = it->second;
+      int cluster_idx = output_entry->cluster_idx;
+      int cluster_output = output_entry->index;
 
       Status status =
           graph->UpdateEdge(cluster_node_map[cluster_idx], cluster_output,
@@ -560,20 +685,11 @@ Status Encapsulator::RewritePass(
   }
 
   // Pass 6: Remove clustered nodes from the graph.
-  std::vector<Node*> nodes_to_remove;
-  for (auto node : graph->op_nodes()) {
-    int cluster_idx;
-
-    if (GetNodeAttr(node->attrs(), "_ovtf_cluster", &cluster_idx) !=
-        Status::OK()) {
-      continue;
+  for (auto& kv : cluster_nodes_map) {
+    for (auto node : kv.second) {
+      OVTF_VLOG(4) << "Removing: " << node->name();
+      graph->RemoveNode(node);
     }
-    nodes_to_remove.push_back(node);
-  }
-
-  for (auto node : nodes_to_remove) {
-    OVTF_VLOG(4) << "Removing: " << node->name();
-    graph->RemoveNode(node);
   }
 
   rewrite_done = true;
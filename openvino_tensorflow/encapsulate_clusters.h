@@ -74,22 +74,52 @@ class Encapsulator {
   // in that cluster.
   std::map<int, std::string> device_name_map;
 
-  // As we build the graph we will be tracking the.. TODO(amprocte): finish
-  // this comment.
-  std::map<std::tuple<int, int>, std::tuple<int, int>> output_remap_map;
-  std::map<std::tuple<int, int, int>, int> input_remap_map;
-  std::map<std::tuple<int, std::string, int>, string> input_rename_map;
+  // Cluster index of every node, indexed by node id. -1 for the nodes that
+  // are not clustered, including the nodes added after AnalysisPass.
+  std::vector<int> node_cluster_map;
+  // The clustered nodes of each cluster, in graph order.
+  std::map<int, std::vector<Node*>> cluster_nodes_map;
+
+  // An output (src_output) of a node that crosses a cluster boundary, and the
+  // index of the corresponding _Retval (or _Arg) in cluster cluster_idx.
+  struct RemapEntry {
+    int src_output;
+    int cluster_idx;
+    int index;
+  };
+  // Outputs of clustered nodes that are read outside their cluster, indexed
+  // by node id.
+  std::vector<std::vector<RemapEntry>> output_remap_map;
+  // Outputs that are read by a cluster other than the one of the node,
+  // indexed by node id.
+  std::vector<std::vector<RemapEntry>> input_remap_map;
+
+  // Whether each clustered node, indexed by node id, has a data path to an
+  // output of its cluster. The other nodes can't change any result, so they
+  // are left out of the cluster graph, and so are the inputs only they read.
+  std::vector<bool> node_needed_map;
 
   // A map from cluster indices to a vector of input data types.
   std::map<int, std::vector<std::tuple<int, int, DataType>>> cluster_input_map;
   // A map from cluster indices to a vector of output data types.
   std::map<int, std::vector<DataType>> cluster_output_dt_map;
+  // A map from cluster indices to the indices of the inputs that must be
+  // static, i.e. known when the cluster is translated.
+  std::map<int, std::set<int32>> cluster_static_inputs_map;
 
   // A map from cluster indices to corresponding NGraphEncapsulate nodes.
   std::map<int, Node*> cluster_node_map;
 
   std::set<int> cluster_indices_for_this_graph;
 
+  int NodeCluster(const Node* node) const;
+  static const RemapEntry* FindRemapEntry(
+      const std::vector<RemapEntry>& entries, int src_output, int cluster_idx);
+  // The source of the value that edge brings into cluster cluster_idx,
+  // looking through the unclustered identities so that the same tensor read
+  // through different identities becomes a single input
+  void FindInputSource(const Edge* edge, int cluster_idx, Node** src,
+                       int* src_output) const;
   static void AddInput(NodeDef* dst, StringPiece src_name, int src_slot);
 };
 
@@ -7,16 +7,26 @@
 #include "ngraph/ngraph.hpp"
 #include "ngraph/opsets/opset.hpp"
 #include "ngraph/pass/convert_fp32_to_fp16.hpp"
+#include "ngraph/runtime/host_tensor.hpp"
+
+#include <climits>
+#include <fstream>
+#include <unordered_set>
 
 #include <ie_plugin_config.hpp>
 
 #include "logging/ovtf_log.h"
 #include "openvino_tensorflow/default_opset.h"
 #include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/ie_adaptive_engine.h"
+#include "openvino_tensorflow/ie_autotuner.h"
 #include "openvino_tensorflow/ie_basic_engine.h"
+#include "openvino_tensorflow/ie_pipeline_engine.h"
 #include "openvino_tensorflow/ie_tensor.h"
 #include "openvino_tensorflow/ie_utils.h"
 #include "openvino_tensorflow/ie_vadm_engine.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_timer.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 
 using namespace std;
@@ -25,12 +35,42 @@ using namespace ngraph;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// Returns true if only the shape of the parameter is used, whatever its type
+// and size
+static bool IsShapeOnlyParameter(const shared_ptr<Node>& node) {
+  if (!op::is_parameter(node)) return false;
+  auto users = node->get_users();
+  return !users.empty() &&
+         all_of(users.begin(), users.end(), [](const shared_ptr<Node>& user) {
+           return string(user->get_type_info().name) == "ShapeOf";
+         });
+}
+
+static string GetOutputName(shared_ptr<ngraph::Node> node) {
+  // Since IE has no "result" nodes, we set the blob corresponding to the
+  // parent of this result node
+  auto parent = node->input_value(0).get_node_shared_ptr();
+  auto name = parent->get_friendly_name();
+  // if parent has multiple outputs, correctly identify the output feeding
+  // into this result
+  if (parent->outputs().size() > 1) {
+    name += "." + to_string(node->input_value(0).get_index());
+  }
+  return name;
+}
+
 Executable::Executable(shared_ptr<Function> func, string device,
-                       string device_type)
+                       string device_type,
+                       const map<string, string>& plugin_config)
     : m_device{device},
       m_device_type(device_type),
+      m_plugin_config(plugin_config),
       m_trivial_fn{nullptr},
-      m_function(func) {
+      m_host_fn{nullptr},
+      m_function(func),
+      m_tuned(false),
+      m_num_calls(0),
+      m_reentrant(false) {
   OVTF_VLOG(2) << "Checking for unsupported ops";
   const auto& opset = ngraph::get_opset7();
   for (const auto& node : func->get_ops()) {
@@ -79,6 +119,22 @@ Executable::Executable(shared_ptr<Function> func, string device,
     return;
   }
 
+  // Shape and index computations are a handful of scalar ops, which cost
+  // less to evaluate in place than to bind to an infer request. This also
+  // covers the functions with only i64 constants, that can't be hoisted to
+  // parameters below. The functions with ops nGraph doesn't evaluate for
+  // their element types are compiled to an IE network instead.
+  if (IsHostEvaluable(func) && TrialEvaluate(func)) {
+    OVTF_VLOG(1) << "Evaluating " << func->get_friendly_name()
+                 << " on the host";
+    Metrics::Increment("host_evaluated_executables");
+    m_host_fn = func;
+    m_function = func;
+    m_tuned = true;
+    m_reentrant = true;
+    return;
+  }
+
   OVTF_VLOG(2) << "Checking for function parameters";
   if (func->get_parameters().size() == 0) {
     OVTF_VLOG(1) << "No parameters found in nGraph function!";
@@ -139,24 +195,11 @@ Executable::Executable(shared_ptr<Function> func, string device,
         name + "_IE_" + m_device;
   }
 
-  auto get_output_name = [](std::shared_ptr<ngraph::Node> node) {
-    // Since IE has no "result" nodes, we set the blob corresponding to the
-    // parent of this result node
-    auto parent = node->input_value(0).get_node_shared_ptr();
-    auto name = parent->get_friendly_name();
-    // if parent has multiple outputs, correctly identify the output feeding
-    // into this result
-    if (parent->outputs().size() > 1) {
-      name += "." + to_string(node->input_value(0).get_index());
-    }
-    return name;
-  };
-
   std::unordered_map<std::string, element::Type> output_dt_map;
 
   auto results = func->get_results();
   for (int i = 0; i < results.size(); i++) {
-    auto output_name = get_output_name(results[i]);
+    auto output_name = GetOutputName(results[i]);
     auto dtype = results[i]->get_element_type();
     output_dt_map[output_name] = dtype;
   }
@@ -181,18 +224,155 @@ Executable::Executable(shared_ptr<Function> func, string device,
   if (m_device == "HDDL") {
     m_ie_engine = make_shared<IE_VADM_Engine>(m_network);
   } else {
-    m_ie_engine = make_shared<IE_Basic_Engine>(m_network, m_device);
+    // The stages of a pipeline have their own configuration and are not
+    // auto-tuned
+    m_ie_engine =
+        IE_Pipeline_Engine::Create(m_network, m_device, m_plugin_config);
+    if (m_ie_engine != nullptr) {
+      m_tuned = true;
+      return;
+    }
+    // The adaptive engine picks its configuration from the load instead of
+    // being auto-tuned
+    m_ie_engine =
+        IE_Adaptive_Engine::Create(m_network, m_device, m_plugin_config);
+    if (m_ie_engine != nullptr) {
+      m_tuned = true;
+      m_reentrant = true;
+      return;
+    }
+
+    IE_AutoTuner::Config tuned_config;
+    if (IE_AutoTuner::IsEnabled()) {
+      stringstream key_ss;
+      key_ss << m_device_type << ":" << m_function->get_friendly_name() << ":"
+             << IE_AutoTuner::GetFunctionHash(m_function);
+      for (const auto& param : m_function->get_parameters()) {
+        key_ss << ":" << param->get_element_type()
+               << param->get_partial_shape();
+      }
+      m_tuning_key = key_ss.str();
+      if (IE_AutoTuner::LookupConfig(m_tuning_key, tuned_config)) {
+        OVTF_VLOG(1) << "Reusing tuned configuration {"
+                     << IE_AutoTuner::SerializeConfig(tuned_config)
+                     << "} for " << m_tuning_key;
+        m_tuned = true;
+      }
+    }
+    m_ie_engine = make_shared<IE_Basic_Engine>(
+        m_network, m_device, WithPluginConfig(tuned_config));
+  }
+}
+
+bool Executable::IsHostEvaluable(const shared_ptr<Function>& func,
+                                 int max_nodes) {
+  if (max_nodes < 0) {
+    string env_value = util::GetEnv("OPENVINO_TF_HOST_EVAL_MAX_NODES");
+    max_nodes =
+        env_value.empty() ? 16 : (int)strtol(env_value.c_str(), NULL, 10);
+  }
+  if (max_nodes <= 0) return false;
+
+  // Ops whose evaluate() is implemented by nGraph for integer types
+  static const unordered_set<string> host_ops{
+      "Add", "Broadcast", "Concat", "Convert", "Divide", "Equal", "FloorMod",
+      "Gather", "Greater", "GreaterEqual", "Less", "LessEqual", "LogicalAnd",
+      "LogicalNot", "LogicalOr", "Maximum", "Minimum", "Multiply", "NotEqual",
+      "Range", "ReduceMax", "ReduceMin", "ReduceProd", "ReduceSum", "Reshape",
+      "Select", "ShapeOf", "Squeeze", "StridedSlice", "Subtract", "Tile",
+      "Transpose", "Unsqueeze"};
+  // Larger tensors are better vectorized by the plugin
+  const size_t max_elements = 1024;
+
+  int num_nodes = 0;
+  for (const auto& node : func->get_ops()) {
+    if (IsShapeOnlyParameter(node)) continue;
+    for (const auto& output : node->outputs()) {
+      auto type = output.get_element_type();
+      if (type.is_dynamic() || type.is_real()) return false;
+      auto& pshape = output.get_partial_shape();
+      if (pshape.is_static() && shape_size(pshape.to_shape()) > max_elements) {
+        return false;
+      }
+    }
+    if (op::is_parameter(node) || op::is_constant(node) ||
+        op::is_output(node)) {
+      continue;
+    }
+    if (!host_ops.count(node->get_type_info().name) ||
+        ++num_nodes > max_nodes) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Executable::TrialEvaluate(const shared_ptr<Function>& func) {
+  // The trial only finds whether nGraph implements the ops of func for their
+  // element types. Its values may be invalid for some functions, e.g. a
+  // division by x - x, which are then conservatively compiled to an IE
+  // network; an evaluation failing later on the real inputs is reported by
+  // Call(). ShapeOf doesn't read the data of its input, so the parameters it
+  // alone reads get no buffer of their full size.
+  static int64_t unread_data = 0;
+  HostTensorVector inputs;
+  for (const auto& param : func->get_parameters()) {
+    const auto& pshape = param->get_partial_shape();
+    Shape shape;
+    if (pshape.rank().is_static()) {
+      for (const auto& dim : pshape) {
+        shape.push_back(dim.is_static() ? dim.get_length() : 1);
+      }
+    }
+    auto type = param->get_element_type();
+    if (IsShapeOnlyParameter(param)) {
+      inputs.push_back(make_shared<HostTensor>(type, shape, &unread_data));
+      continue;
+    }
+    auto ones = opset::Constant::create(type, shape, {1});
+    auto input = make_shared<HostTensor>(type, shape);
+    input->write(ones->get_data_ptr(), input->get_size_in_bytes());
+    inputs.push_back(input);
+  }
+  HostTensorVector outputs;
+  for (size_t i = 0; i < func->get_results().size(); i++) {
+    outputs.push_back(make_shared<HostTensor>());
+  }
+  try {
+    if (func->evaluate(outputs, inputs)) return true;
+    OVTF_VLOG(1) << "Unable to evaluate " << func->get_friendly_name()
+                 << " on the host";
+  } catch (const std::exception& exp) {
+    OVTF_VLOG(1) << "Unable to evaluate " << func->get_friendly_name()
+                 << " on the host: " << exp.what();
+  }
+  Metrics::Increment("host_evaluation_failures");
+  return false;
+}
+
+map<string, string> Executable::WithPluginConfig(
+    const map<string, string>& config) const {
+  auto merged = config;
+  for (const auto& it : m_plugin_config) {
+    merged[it.first] = it.second;
   }
+  return merged;
 }
 
 bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
                       vector<shared_ptr<runtime::Tensor>>& outputs,
-                      bool multi_req_execution) {
+                      bool multi_req_execution,
+                      IE_InferCancellation* cancellation) {
   if (m_trivial_fn) {
     OVTF_VLOG(2) << "Calling trivial IE function with inputs=" << inputs.size()
                  << " outputs=" << outputs.size();
     return CallTrivial(inputs, outputs);
   }
+  if (m_host_fn) {
+    OVTF_VLOG(2) << "Evaluating function on the host with inputs="
+                 << inputs.size() << " outputs=" << outputs.size();
+    return CallOnHost(inputs, outputs);
+  }
 
   // Check if the number of inputs that the CNN network expects is equal to the
   // sum of the
@@ -245,19 +425,6 @@ bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
     outputs.resize(output_info.size(), nullptr);
   }
 
-  auto get_output_name = [](std::shared_ptr<ngraph::Node> node) {
-    // Since IE has no "result" nodes, we set the blob corresponding to the
-    // parent of this result node
-    auto parent = node->input_value(0).get_node_shared_ptr();
-    auto name = parent->get_friendly_name();
-    // if parent has multiple outputs, correctly identify the output feeding
-    // into this result
-    if (parent->outputs().size() > 1) {
-      name += "." + to_string(node->input_value(0).get_index());
-    }
-    return name;
-  };
-
   //  Prepare output blobs
   auto results = func->get_results();
   std::vector<std::shared_ptr<IETensor>> ie_outputs(outputs.size());
@@ -266,7 +433,7 @@ bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
     if (outputs[i] != nullptr) {
       ie_outputs[i] = static_pointer_cast<IETensor>(outputs[i]);
     }
-    output_names[i] = get_output_name(results[i]);
+    output_names[i] = GetOutputName(results[i]);
   }
 
   if (multi_req_execution) {
@@ -274,7 +441,7 @@ bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
   }
 
   m_ie_engine->infer(ie_inputs, input_names, ie_outputs, output_names,
-                     ie_hoisted_params, param_names);
+                     ie_hoisted_params, param_names, cancellation);
 
   // Set dynamic output blobs
   for (int i = 0; i < results.size(); i++) {
@@ -286,6 +453,74 @@ bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
   return true;
 }
 
+bool Executable::ShouldAutoTune() {
+  if (m_tuned || m_trivial_fn || m_device == "HDDL" ||
+      !IE_AutoTuner::IsEnabled()) {
+    return false;
+  }
+  return ++m_num_calls >= IE_AutoTuner::GetWarmupCalls();
+}
+
+void Executable::AutoTune(const vector<shared_ptr<runtime::Tensor>>& inputs,
+                          const vector<shared_ptr<runtime::Tensor>>& outputs,
+                          IE_InferCancellation* cancellation) {
+  m_tuned = true;
+  auto candidates = IE_AutoTuner::GetCandidateConfigs(m_device);
+  if (candidates.size() < 2) return;
+
+  auto default_engine = m_ie_engine;
+  auto best_engine = m_ie_engine;
+  IE_AutoTuner::Config best_config;
+  int best_time = INT_MAX;
+  int num_iterations = IE_AutoTuner::GetNumIterations();
+  for (const auto& config : candidates) {
+    // The default configuration is already loaded by the warm-up calls
+    auto engine = config.empty() ? default_engine
+                                 : make_shared<IE_Basic_Engine>(
+                                       m_network, m_device,
+                                       WithPluginConfig(config));
+    m_ie_engine = engine;
+    try {
+      // The first call loads the network and is not part of the measurement.
+      // Dynamic outputs (nullptr) are allocated by each call, so the outputs
+      // are copied every time.
+      auto tuning_outputs = outputs;
+      Call(inputs, tuning_outputs, false, cancellation);
+      Timer tuning_time;
+      for (int i = 0; i < num_iterations; i++) {
+        tuning_outputs = outputs;
+        Call(inputs, tuning_outputs, false, cancellation);
+      }
+      int time_per_call = tuning_time.ElapsedInMicroSec() / num_iterations;
+      OVTF_VLOG(1) << "OPENVINO_TF_AUTOTUNE: " << m_tuning_key << " Config: {"
+                   << IE_AutoTuner::SerializeConfig(config)
+                   << "} Time: " << time_per_call << " us";
+      if (time_per_call < best_time) {
+        best_time = time_per_call;
+        best_config = config;
+        best_engine = m_ie_engine;
+      }
+    } catch (const std::exception& exp) {
+      if (cancellation != nullptr && cancellation->IsCancelled()) {
+        // Tuned again by a later call
+        m_ie_engine = default_engine;
+        m_tuned = false;
+        m_num_calls = 0;
+        throw;
+      }
+      OVTF_VLOG(1) << "OPENVINO_TF_AUTOTUNE: Skipping config {"
+                   << IE_AutoTuner::SerializeConfig(config)
+                   << "}: " << exp.what();
+    }
+  }
+
+  m_ie_engine = best_engine;
+  OVTF_VLOG(1) << "OPENVINO_TF_AUTOTUNE: Selected config {"
+               << IE_AutoTuner::SerializeConfig(best_config) << "} for "
+               << m_tuning_key;
+  IE_AutoTuner::StoreConfig(m_tuning_key, best_config);
+}
+
 bool Executable::CallTrivial(const vector<shared_ptr<runtime::Tensor>>& inputs,
                              vector<shared_ptr<runtime::Tensor>>& outputs) {
   // outputs are in the same order as results
@@ -343,11 +578,137 @@ bool Executable::CallTrivial(const vector<shared_ptr<runtime::Tensor>>& inputs,
   return true;
 }
 
+bool Executable::CallOnHost(const vector<shared_ptr<runtime::Tensor>>& inputs,
+                            vector<shared_ptr<runtime::Tensor>>& outputs) {
+  // The inputs are evaluated in place, and the outputs are allocated by the
+  // evaluation since their shapes may depend on the input values
+  auto parameters = m_host_fn->get_parameters();
+  HostTensorVector host_inputs;
+  for (int i = 0; i < inputs.size(); i++) {
+    if (find(m_skipped_inputs.begin(), m_skipped_inputs.end(), i) !=
+        m_skipped_inputs.end()) {
+      continue;
+    }
+    auto ie_input = static_pointer_cast<IETensor>(inputs[i]);
+    host_inputs.push_back(make_shared<HostTensor>(
+        ie_input->get_element_type(), ie_input->get_shape(),
+        const_cast<void*>(ie_input->get_data_ptr())));
+  }
+  if (host_inputs.size() != parameters.size()) {
+    throw runtime_error("Function inputs (" + to_string(parameters.size()) +
+                        ") number different from number of given inputs (" +
+                        to_string(host_inputs.size()) + ")");
+  }
+
+  auto results = m_host_fn->get_results();
+  HostTensorVector host_outputs;
+  for (int i = 0; i < results.size(); i++) {
+    host_outputs.push_back(make_shared<HostTensor>());
+  }
+  if (!m_host_fn->evaluate(host_outputs, host_inputs)) {
+    throw runtime_error("Unable to evaluate " +
+                        m_host_fn->get_friendly_name() + " on the host");
+  }
+
+  if (outputs.size() == 0 && results.size() > 0) {
+    outputs.resize(results.size(), nullptr);
+  }
+  for (int i = 0; i < results.size(); i++) {
+    const auto& host_output = host_outputs[i];
+    if (outputs[i] == nullptr) {
+      outputs[i] = make_shared<IETensor>(host_output->get_element_type(),
+                                         host_output->get_shape());
+    }
+    outputs[i]->write(host_output->get_data_ptr(),
+                      host_output->get_size_in_bytes());
+  }
+  return true;
+}
+
 void Executable::ExportIR(const string& output_dir) {
   if (!m_function || !m_ie_engine) return;
   auto& name = m_function->get_friendly_name();
   m_network.serialize(output_dir + "/" + name + ".xml",
                       output_dir + "/" + name + ".bin");
+  ExportSignature(output_dir);
+}
+
+// Writes the input/output signature of the exported IR to <name>.sig, so
+// that the IR can be run without TensorFlow by the openvino_tensorflow
+// runtime library. Each line describes one tensor:
+//   input <position> <name> <element type> <shape>
+//   skipped_input <position>
+//   hoisted <name> <element type> <shape> <data file>
+//   output <position> <name> <element type> <shape>
+// Positions are the ones of the inputs and outputs of the encapsulate op.
+// Element types are the ones seen by TensorFlow.
+void Executable::ExportSignature(const string& output_dir) {
+  auto& name = m_function->get_friendly_name();
+  ofstream sig_file(output_dir + "/" + name + ".sig");
+  if (!sig_file.is_open()) {
+    OVTF_VLOG(0) << "Unable to write the signature of " << name;
+    return;
+  }
+
+  auto tf_type_name = [this](const element::Type& type) {
+    if (m_device_type == "GPU_FP16" && type == element::f16) {
+      return element::Type(element::f32).get_type_name();
+    }
+    return type.get_type_name();
+  };
+  auto shape_string = [](const Shape& shape) {
+    stringstream ss;
+    ss << "[";
+    for (size_t i = 0; i < shape.size(); i++) {
+      ss << (i > 0 ? "," : "") << shape[i];
+    }
+    ss << "]";
+    return ss.str();
+  };
+
+  sig_file << "ovtf_bundle 1" << endl;
+  sig_file << "device " << m_device << endl;
+
+  auto parameters = m_function->get_parameters();
+  size_t num_inputs = m_skipped_inputs.size() +
+                      (m_hoisted_params.empty() ? parameters.size() : 0);
+  int j = 0;
+  for (size_t i = 0; i < num_inputs; i++) {
+    if (find(m_skipped_inputs.begin(), m_skipped_inputs.end(), i) !=
+        m_skipped_inputs.end()) {
+      sig_file << "skipped_input " << i << endl;
+      continue;
+    }
+    auto param = parameters[j++];
+    sig_file << "input " << i << " " << param->get_friendly_name() << " "
+             << tf_type_name(param->get_element_type()) << " "
+             << shape_string(param->get_shape()) << endl;
+  }
+
+  for (int k = 0; k < m_hoisted_params.size(); k++) {
+    auto& tensor = m_hoisted_params[k].second;
+    string data_file = name + ".hoisted" + to_string(k) + ".bin";
+    vector<char> data(tensor->get_size_in_bytes());
+    tensor->read(data.data(), data.size());
+    ofstream data_stream(output_dir + "/" + data_file, ios::binary);
+    data_stream.write(data.data(), data.size());
+    sig_file << "hoisted " << m_hoisted_params[k].first << " "
+             << tensor->get_element_type().get_type_name() << " "
+             << shape_string(tensor->get_shape()) << " " << data_file << endl;
+  }
+
+  auto results = m_function->get_results();
+  for (int i = 0; i < results.size(); i++) {
+    auto pshape = results[i]->get_output_partial_shape(0);
+    if (pshape.is_dynamic()) {
+      OVTF_VLOG(1) << "Output " << i << " of " << name
+                   << " has a dynamic shape, signature is incomplete";
+      continue;
+    }
+    sig_file << "output " << i << " " << GetOutputName(results[i]) << " "
+             << tf_type_name(results[i]->get_element_type()) << " "
+             << shape_string(pshape.to_shape()) << endl;
+  }
 }
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -24,19 +26,26 @@ namespace openvino_tensorflow {
 // function.
 class Executable {
  public:
+  // plugin_config is applied on top of the configuration of every network
+  // loaded for func, except by the HDDL engine
   Executable(shared_ptr<ngraph::Function> func, string device,
-             string device_type);
+             string device_type,
+             const map<string, string>& plugin_config = {});
   ~Executable() {}
+  // cancellation, if not nullptr, cancels the inference of this call only.
+  // It may be cancelled from another thread, e.g. by the cancellation
+  // callback of the step.
   bool Call(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
             vector<shared_ptr<ngraph::runtime::Tensor>>& outputs,
-            bool multi_req_execution = false);
+            bool multi_req_execution = false,
+            IE_InferCancellation* cancellation = nullptr);
 
   const ngraph::ResultVector& GetResults() {
     return m_function->get_results();
   };
 
   const vector<size_t> GetOutputShape(const int i) {
-    if (m_trivial_fn) {
+    if (m_trivial_fn || m_host_fn) {
       return GetResults()[i]->get_shape();
     } else {
       return m_ie_engine->get_output_shape(i);
@@ -51,14 +60,48 @@ class Executable {
 
   void ExportIR(const string& output_dir);
 
+  // Counts the calls made during warm-up and returns true once this
+  // executable is hot enough to be auto-tuned
+  bool ShouldAutoTune();
+  // Times the candidate plugin configurations on the given inputs and keeps
+  // the fastest one for the subsequent calls. A cancelled tuning restores
+  // the default configuration and throws, and is retried after the warm-up.
+  void AutoTune(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
+                const vector<shared_ptr<ngraph::runtime::Tensor>>& outputs,
+                IE_InferCancellation* cancellation = nullptr);
+
+  // Whether Call() can run on several threads at once
+  bool IsReentrant() const { return m_reentrant; }
+  // Whether Call() evaluates the function on the calling thread instead of
+  // running an IE network
+  bool IsHostEvaluated() const { return m_host_fn != nullptr; }
+
+  // Returns true if func only computes on integers (such as shapes and
+  // indices) with at most max_nodes small ops that nGraph can evaluate
+  // directly. The limit is OPENVINO_TF_HOST_EVAL_MAX_NODES if max_nodes is
+  // negative.
+  static bool IsHostEvaluable(const shared_ptr<ngraph::Function>& func,
+                              int max_nodes = -1);
+  // Evaluates func once with nGraph on inputs filled with ones, and returns
+  // false if it fails, mostly because nGraph doesn't implement one of its ops
+  // for its element types. The ones may also make a valid function fail, e.g.
+  // with a division by x - x, which only costs running it with IE.
+  static bool TrialEvaluate(const shared_ptr<ngraph::Function>& func);
+
  private:
   bool CallTrivial(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
                    vector<shared_ptr<ngraph::runtime::Tensor>>& outputs);
+  bool CallOnHost(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
+                  vector<shared_ptr<ngraph::runtime::Tensor>>& outputs);
+  void ExportSignature(const string& output_dir);
+  // Returns config overridden by m_plugin_config
+  map<string, string> WithPluginConfig(const map<string, string>& config) const;
 
   InferenceEngine::CNNNetwork m_network;
   InferenceEngine::InferRequest m_infer_req;
   string m_device;
   string m_device_type;
+  map<string, string> m_plugin_config;
   // This holds the parameters we insert for functions with no input parameters
   vector<pair<string, shared_ptr<ngraph::runtime::Tensor>>> m_hoisted_params;
   vector<int> m_skipped_inputs;
@@ -66,9 +109,17 @@ class Executable {
   // This keeps track of whether the original function was trivial: either a
   // constant function, an identity function or a zero function
   shared_ptr<ngraph::Function> m_trivial_fn;
+  // Set if the function is small and integer-only, and evaluated by nGraph
+  // on the calling thread without any IE network
+  shared_ptr<ngraph::Function> m_host_fn;
   // This is the original nGraph function corresponding to this executable
   shared_ptr<ngraph::Function> m_function;
   shared_ptr<IE_Backend_Engine> m_ie_engine;
+  // Key identifying this executable in the auto-tuning cache
+  string m_tuning_key;
+  bool m_tuned;
+  int m_num_calls;
+  bool m_reentrant;
 };
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
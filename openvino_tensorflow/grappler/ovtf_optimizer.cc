@@ -20,6 +20,8 @@
 #include "openvino_tensorflow/backend_manager.h"
 #include "openvino_tensorflow/cluster_manager.h"
 #include "openvino_tensorflow/grappler/ovtf_optimizer.h"
+#include "openvino_tensorflow/partition_clusters.h"
+#include "openvino_tensorflow/placement_profile.h"
 
 #include "ocm/include/ocm_nodes_checker.h"
 
@@ -93,7 +95,9 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
   // Init Ops
   nodes_to_preserve.insert(item.init_ops.begin(), item.init_ops.end());
 
-  // Find a list of nodes that are of the types that are disabled
+  // Find a list of nodes that are of the types that are disabled. The set is
+  // read once, so that marking below sees the same ops even if the
+  // application updates them concurrently.
   std::set<string> disabled_nodes;
   std::set<string> disabled_ops_set = api::GetDisabledOps();
   for (auto itr : graph.nodes()) {
@@ -132,6 +136,7 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
   //
   // The part has several phases, each executed in sequence:
   //
+  //   0. Debug Op Stripping, if enabled [strip_debug_ops.cc]
   //   1. Marking [mark_for_clustering.cc]
   //   2. Cluster Assignment [assign_clusters.cc]
   //   3. Cluster Deassignment [deassign_clusters.cc]
@@ -142,6 +147,14 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
   // If requested, dump unmarked graphs.
   util::DumpTFGraph(&graph, idx, "unmarked");
 
+  // 0. Strip the debug ops if requested, then dump the graphs.
+  StrippedNodeBoundaries stripped_boundaries;
+  if (IsDebugOpStrippingEnabled()) {
+    TF_RETURN_IF_ERROR(
+        StripDebugOps(&graph, skip_these_nodes, &stripped_boundaries));
+    util::DumpTFGraph(&graph, idx, "stripped");
+  }
+
   // 1. Mark for clustering then, if requested, dump the graphs.
   // OCM call for marking supported nodes
   std::string device;
@@ -163,7 +176,7 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 #endif
   ocm::Framework_Names fName = ocm::Framework_Names::TF;
   ocm::FrameworkNodesChecker FC(fName, device_id, ov_version, &graph);
-  FC.SetDisabledOps(api::GetDisabledOps());
+  FC.SetDisabledOps(disabled_ops_set);
   std::vector<void*> nodes_list = FC.MarkSupportedNodes();
 
   // cast back the nodes in the TF format and mark the nodes for clustering
@@ -183,18 +196,33 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 
   // 2. Assign clusters then, if requested, dump the graphs.
   TF_RETURN_IF_ERROR(AssignClusters(&graph));
+  TF_RETURN_IF_ERROR(PartitionClusters(&graph));
   util::DumpTFGraph(&graph, idx, "clustered");
 
   // 3. Deassign trivial clusters then, if requested, dump the graphs.
   TF_RETURN_IF_ERROR(DeassignClusters(&graph));
   util::DumpTFGraph(&graph, idx, "declustered");
 
+  if (IsDebugOpStrippingEnabled()) {
+    int avoided_splits = CountAvoidedClusterSplits(&graph, stripped_boundaries);
+    OVTF_VLOG(1) << "Cluster splits avoided by stripping debug ops: "
+                 << avoided_splits;
+    if (api::IsLoggingPlacement()) {
+      std::cout << "OVTF_SUMMARY: Number of cluster splits avoided by "
+                   "stripping debug ops: "
+                << avoided_splits << std::endl;
+    }
+  }
+
   // 4. Encapsulate clusters then, if requested, dump the graphs.
   auto status = EncapsulateClusters(&graph, idx, m_config_map);
   if (status != Status::OK()) {
     return status;
   }
   util::DumpTFGraph(&graph, idx, "encapsulated");
+  if (PlacementProfile::IsEnabled()) {
+    PlacementProfile::RegisterGraph(idx, &graph);
+  }
 
   // Convert the graph back to Graphdef
   graph.ToGraphDef(output);
@@ -28,6 +28,7 @@
 #include "openvino_tensorflow/grappler/add_identityn.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/strip_debug_ops.h"
 
 #include <iomanip>
 
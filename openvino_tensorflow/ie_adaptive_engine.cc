@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ie_adaptive_engine.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+AdaptiveModeSelector::AdaptiveModeSelector(double high_load, double low_load,
+                                           double smoothing)
+    : m_high_load(high_load),
+      m_low_load(low_load),
+      m_smoothing(smoothing),
+      m_load(1.0),
+      m_throughput_mode(false) {}
+
+bool AdaptiveModeSelector::Update(int num_running) {
+  m_load += m_smoothing * (num_running - m_load);
+  // The gap between the two thresholds keeps a load hovering around one of
+  // them from switching the mode back and forth
+  if (m_throughput_mode) {
+    if (m_load <= m_low_load) m_throughput_mode = false;
+  } else if (m_load >= m_high_load) {
+    m_throughput_mode = true;
+  }
+  return m_throughput_mode;
+}
+
+IE_Adaptive_Engine::Policy IE_Adaptive_Engine::GetPolicy() {
+  string policy = util::GetEnv("OPENVINO_TF_ADAPTIVE_STREAMS");
+  if (policy == "1") return Policy::ADAPTIVE;
+  if (policy == "latency") return Policy::LATENCY;
+  if (policy == "throughput") return Policy::THROUGHPUT;
+  return Policy::DISABLED;
+}
+
+shared_ptr<IE_Adaptive_Engine> IE_Adaptive_Engine::Create(
+    InferenceEngine::CNNNetwork ie_network, string device,
+    map<string, string> config) {
+  auto policy = GetPolicy();
+  if (policy == Policy::DISABLED || (device != "CPU" && device != "GPU")) {
+    return nullptr;
+  }
+  Metrics::Increment("adaptive_executables");
+  return shared_ptr<IE_Adaptive_Engine>(
+      new IE_Adaptive_Engine(ie_network, device, config, policy));
+}
+
+IE_Adaptive_Engine::IE_Adaptive_Engine(InferenceEngine::CNNNetwork ie_network,
+                                       string device,
+                                       map<string, string> config,
+                                       Policy policy)
+    : IE_Backend_Engine(ie_network, device, config),
+      m_policy(policy),
+      m_throughput_active(false),
+      m_throughput_loading(false),
+      m_throughput_failed(false),
+      m_num_running(0) {
+  string key = device + "_THROUGHPUT_STREAMS";
+  m_latency.config = m_config;
+  m_throughput.config = m_config;
+  m_latency.config[key] = "1";
+  m_throughput.config[key] = device + "_THROUGHPUT_AUTO";
+}
+
+IE_Adaptive_Engine::~IE_Adaptive_Engine() {
+  if (m_loader.joinable()) m_loader.join();
+}
+
+void IE_Adaptive_Engine::load_network() {
+  lock_guard<mutex> load_lock(m_load_mutex);
+  if (m_network_ready) return;
+  bool throughput = m_policy == Policy::THROUGHPUT;
+  Mode& mode = throughput ? m_throughput : m_latency;
+  auto exe_network = load_exe_network(mode.config);
+  {
+    lock_guard<mutex> lock(m_mode_mutex);
+    mode.exe_network = exe_network;
+    mode.ready = true;
+    m_throughput_active = throughput;
+  }
+  m_exe_network = exe_network;
+  m_network_ready = true;
+}
+
+void IE_Adaptive_Engine::LoadThroughputNetwork() {
+  OVTF_VLOG(1) << "Loading the throughput network of "
+               << m_func->get_friendly_name();
+  try {
+    auto exe_network = load_exe_network(m_throughput.config);
+    lock_guard<mutex> lock(m_mode_mutex);
+    m_throughput.exe_network = exe_network;
+    m_throughput.ready = true;
+    m_throughput_loading = false;
+  } catch (const std::exception& exp) {
+    OVTF_VLOG(0) << "Unable to load the throughput network of "
+                 << m_func->get_friendly_name() << ": " << exp.what();
+    lock_guard<mutex> lock(m_mode_mutex);
+    m_throughput_failed = true;
+    m_throughput_loading = false;
+  }
+}
+
+IE_Adaptive_Engine::Mode& IE_Adaptive_Engine::SelectMode(int num_running) {
+  if (m_policy != Policy::ADAPTIVE) {
+    return m_throughput_active ? m_throughput : m_latency;
+  }
+  bool throughput = m_selector.Update(num_running);
+  if (throughput && !m_throughput.ready && !m_throughput_loading &&
+      !m_throughput_failed) {
+    // The calls keep running in latency mode during the load
+    m_throughput_loading = true;
+    m_loader = thread(&IE_Adaptive_Engine::LoadThroughputNetwork, this);
+  }
+  bool use_throughput = throughput && m_throughput.ready;
+  if (use_throughput != m_throughput_active) {
+    m_throughput_active = use_throughput;
+    Metrics::Increment("adaptive_mode_switches");
+    OVTF_VLOG(1) << "Switching " << m_func->get_friendly_name() << " to the "
+                 << (use_throughput ? "throughput" : "latency")
+                 << " mode, average load " << m_selector.GetLoad();
+  }
+  return m_throughput_active ? m_throughput : m_latency;
+}
+
+InferenceEngine::InferRequest IE_Adaptive_Engine::AcquireRequest(Mode& mode) {
+  if (!mode.idle_reqs.empty()) {
+    auto req = mode.idle_reqs.back();
+    mode.idle_reqs.pop_back();
+    return req;
+  }
+  return mode.exe_network.CreateInferRequest();
+}
+
+void IE_Adaptive_Engine::infer(
+    vector<shared_ptr<IETensor>>& inputs, vector<string>& input_names,
+    vector<shared_ptr<IETensor>>& outputs, vector<string>& output_names,
+    vector<shared_ptr<IETensor>>& hoisted_params, vector<string>& param_names,
+    IE_InferCancellation* cancellation) {
+  load_network();
+
+  int num_running = ++m_num_running;
+  Mode* mode;
+  InferenceEngine::InferRequest req;
+  {
+    lock_guard<mutex> lock(m_mode_mutex);
+    mode = &SelectMode(num_running);
+    req = AcquireRequest(*mode);
+  }
+  auto release = [&]() {
+    {
+      lock_guard<mutex> lock(m_mode_mutex);
+      mode->idle_reqs.push_back(req);
+    }
+    m_num_running--;
+  };
+
+  try {
+    // Unbound before the request goes back to the pool
+    IE_CancellationScope cancellation_scope(cancellation);
+    cancellation_scope.Bind(req);
+    for (size_t i = 0; i < inputs.size(); i++) {
+      if (inputs[i] != nullptr) {
+        req.SetBlob(input_names[i], inputs[i]->get_blob());
+      }
+    }
+    for (size_t i = 0; i < hoisted_params.size(); i++) {
+      if (hoisted_params[i] != nullptr) {
+        req.SetBlob(param_names[i], hoisted_params[i]->get_blob());
+      }
+    }
+    auto results = m_func->get_results();
+    for (size_t i = 0; i < results.size(); i++) {
+      if (outputs[i] != nullptr) {
+        req.SetBlob(output_names[i], outputs[i]->get_blob());
+      }
+    }
+
+    req.Infer();
+
+    // The blobs of the request are reused by the next call that takes it,
+    // so the dynamic outputs are copied out
+    for (size_t i = 0; i < results.size(); i++) {
+      if (outputs[i] == nullptr) {
+        auto blob_tensor =
+            make_shared<IETensor>(req.GetBlob(output_names[i]));
+        outputs[i] = make_shared<IETensor>(blob_tensor->get_element_type(),
+                                           blob_tensor->get_shape());
+        outputs[i]->write(blob_tensor->get_data_ptr(),
+                          blob_tensor->get_size_in_bytes());
+      }
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+  release();
+  OVTF_VLOG(4) << "Inference Successful";
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef IE_ADAPTIVE_ENGINE_H_
+#define IE_ADAPTIVE_ENGINE_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ie_core.hpp>
+
+#include "openvino_tensorflow/ie_backend_engine.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Keeps an exponential moving average of the number of calls running at the
+// same time and selects the throughput mode once it reaches high_load, then
+// the latency mode again once it falls to low_load.
+class AdaptiveModeSelector {
+ public:
+  AdaptiveModeSelector(double high_load = 1.5, double low_load = 1.1,
+                       double smoothing = 0.1);
+
+  // Records a call that started while num_running calls, itself included,
+  // were running. Returns true if the throughput mode is selected.
+  bool Update(int num_running);
+
+  double GetLoad() const { return m_load; }
+  bool IsThroughputMode() const { return m_throughput_mode; }
+
+ private:
+  double m_high_load;
+  double m_low_load;
+  double m_smoothing;
+  double m_load;
+  bool m_throughput_mode;
+};
+
+// Executes a network with two plugin configurations: a latency one (a single
+// stream using all the threads) and a throughput one (as many streams as the
+// plugin finds optimal). The latency network is loaded by the first call, the
+// throughput one in the background the first time the load calls for it.
+// Concurrent calls each get an inference request of the selected network
+// from its pool, so infer() can be called from several threads at once, and
+// each call can be cancelled without affecting the others.
+// Enabled on CPU and GPU with OPENVINO_TF_ADAPTIVE_STREAMS.
+class IE_Adaptive_Engine : public IE_Backend_Engine {
+ public:
+  enum class Policy { DISABLED, ADAPTIVE, LATENCY, THROUGHPUT };
+
+  // Returns nullptr if the adaptive streams are disabled or not supported by
+  // the device. config is applied to both networks.
+  static std::shared_ptr<IE_Adaptive_Engine> Create(
+      InferenceEngine::CNNNetwork ie_network, std::string device,
+      std::map<std::string, std::string> config = {});
+  ~IE_Adaptive_Engine();
+
+  // Policy requested with OPENVINO_TF_ADAPTIVE_STREAMS: 1 adapts to the load,
+  // "latency" and "throughput" pin one of the modes
+  static Policy GetPolicy();
+
+  // Executes the inference
+  virtual void infer(std::vector<std::shared_ptr<IETensor>>& inputs,
+                     std::vector<std::string>& input_names,
+                     std::vector<std::shared_ptr<IETensor>>& outputs,
+                     std::vector<std::string>& output_names,
+                     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+                     std::vector<std::string>& param_names,
+                     IE_InferCancellation* cancellation);
+
+  virtual const std::vector<size_t> get_output_shape(const int i) {
+    return m_func->get_results()[i]->get_shape();
+  };
+
+ protected:
+  // Loads the network of the initial mode
+  virtual void load_network();
+
+ private:
+  IE_Adaptive_Engine(InferenceEngine::CNNNetwork ie_network,
+                     std::string device,
+                     std::map<std::string, std::string> config, Policy policy);
+
+  struct Mode {
+    std::map<std::string, std::string> config;
+    InferenceEngine::ExecutableNetwork exe_network;
+    bool ready = false;
+    // Requests of exe_network not used by a running call
+    std::vector<InferenceEngine::InferRequest> idle_reqs;
+  };
+
+  // Picks the mode of a call, and takes an idle request of the mode or
+  // creates one. Called with m_mode_mutex held.
+  Mode& SelectMode(int num_running);
+  InferenceEngine::InferRequest AcquireRequest(Mode& mode);
+  void LoadThroughputNetwork();
+
+  Policy m_policy;
+  Mode m_latency;
+  Mode m_throughput;
+  // Guards the selector, the modes and m_throughput_active
+  std::mutex m_mode_mutex;
+  // Serializes the load of the initial network by concurrent first calls
+  std::mutex m_load_mutex;
+  AdaptiveModeSelector m_selector;
+  bool m_throughput_active;
+  bool m_throughput_loading;
+  bool m_throughput_failed;
+  std::thread m_loader;
+  std::atomic<int> m_num_running;
+};
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // IE_ADAPTIVE_ENGINE_H_
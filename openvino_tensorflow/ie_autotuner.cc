@@ -0,0 +1,192 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/ie_autotuner.h"
+#include "openvino_tensorflow/pass/attribute_serializer.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex IE_AutoTuner::s_tuned_configs_mutex;
+bool IE_AutoTuner::s_cache_file_loaded = false;
+std::unordered_map<std::string, IE_AutoTuner::Config>
+    IE_AutoTuner::s_tuned_configs;
+
+bool IE_AutoTuner::IsEnabled() {
+  return util::GetEnv("OPENVINO_TF_ENABLE_AUTOTUNING") == "1";
+}
+
+int IE_AutoTuner::GetWarmupCalls() {
+  int warmup_calls = 2;
+  string env_value = util::GetEnv("OPENVINO_TF_AUTOTUNE_WARMUP_CALLS");
+  if (!env_value.empty()) {
+    warmup_calls = (int)strtol(env_value.c_str(), NULL, 10);
+  }
+  return warmup_calls < 1 ? 1 : warmup_calls;
+}
+
+string IE_AutoTuner::GetCacheDir() {
+  return util::GetEnv("OPENVINO_TF_CACHE_DIR");
+}
+
+vector<IE_AutoTuner::Config> IE_AutoTuner::GetCandidateConfigs(
+    const string& device) {
+  vector<Config> candidates;
+  candidates.push_back({});
+  if (device == "CPU") {
+    int num_cores = (int)std::thread::hardware_concurrency();
+    // Small networks may not scale to all the cores, or suffer from the
+    // threads being pinned next to other work
+    candidates.push_back({{"CPU_BIND_THREAD", "NO"}});
+    if (num_cores >= 4) {
+      candidates.push_back({{"CPU_THREADS_NUM", to_string(num_cores / 2)}});
+    }
+  }
+  return candidates;
+}
+
+string IE_AutoTuner::GetFunctionHash(
+    const shared_ptr<ngraph::Function>& func) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  auto update = [&hash](const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+  };
+
+  unordered_map<const ngraph::Node*, size_t> ids;
+  for (const auto& node : func->get_ordered_ops()) {
+    size_t id = ids.size();
+    ids[node.get()] = id;
+    stringstream ss;
+    ss << node->get_type_info().name << "." << node->get_type_info().version
+       << "(";
+    for (const auto& input : node->inputs()) {
+      auto source = input.get_source_output();
+      ss << ids[source.get_node()] << "." << source.get_index() << ",";
+    }
+    ss << ")";
+    for (const auto& output : node->outputs()) {
+      ss << output.get_element_type() << output.get_partial_shape();
+    }
+    auto constant = ngraph::as_type_ptr<opset::Constant>(node);
+    if (constant == nullptr && !ngraph::op::is_parameter(node)) {
+      pass::AttributeSerializer attributes;
+      node->visit_attributes(attributes);
+      ss << attributes.str();
+    }
+    auto str = ss.str();
+    update(str.data(), str.size());
+    if (constant != nullptr) {
+      const auto& type = constant->get_element_type();
+      size_t num_bits = ngraph::shape_size(constant->get_shape()) *
+                        type.bitwidth();
+      update(constant->get_data_ptr(), (num_bits + 7) / 8);
+    }
+  }
+
+  stringstream hex;
+  hex << std::hex << setw(16) << setfill('0') << hash;
+  return hex.str();
+}
+
+string IE_AutoTuner::SerializeConfig(const Config& config) {
+  stringstream ss;
+  bool first = true;
+  for (const auto& it : config) {
+    if (!first) ss << ";";
+    ss << it.first << "=" << it.second;
+    first = false;
+  }
+  return ss.str();
+}
+
+bool IE_AutoTuner::DeserializeConfig(const string& str, Config& config) {
+  config.clear();
+  stringstream ss(str);
+  string entry;
+  while (getline(ss, entry, ';')) {
+    if (entry.empty()) continue;
+    auto pos = entry.find('=');
+    if (pos == string::npos || pos == 0) {
+      config.clear();
+      return false;
+    }
+    config[entry.substr(0, pos)] = entry.substr(pos + 1);
+  }
+  return true;
+}
+
+string IE_AutoTuner::GetCacheFile() {
+  string cache_dir = GetCacheDir();
+  if (cache_dir.empty()) return cache_dir;
+  return cache_dir + "/ovtf_tuned_configs.txt";
+}
+
+// Each line of the cache file is "<key>\t<serialized config>". Later lines
+// override earlier ones for the same key.
+void IE_AutoTuner::LoadCacheFile() {
+  if (s_cache_file_loaded) return;
+  s_cache_file_loaded = true;
+  string cache_file = GetCacheFile();
+  if (cache_file.empty()) return;
+
+  ifstream ifs(cache_file);
+  if (!ifs.is_open()) return;
+  string line;
+  while (getline(ifs, line)) {
+    auto pos = line.rfind('\t');
+    if (pos == string::npos) continue;
+    Config config;
+    if (!DeserializeConfig(line.substr(pos + 1), config)) {
+      OVTF_VLOG(1) << "Ignoring malformed tuning entry: " << line;
+      continue;
+    }
+    s_tuned_configs[line.substr(0, pos)] = config;
+  }
+  OVTF_VLOG(1) << "Loaded " << s_tuned_configs.size()
+               << " tuned configurations from " << cache_file;
+}
+
+bool IE_AutoTuner::LookupConfig(const string& key, Config& config) {
+  std::lock_guard<std::mutex> lock(s_tuned_configs_mutex);
+  LoadCacheFile();
+  auto it = s_tuned_configs.find(key);
+  if (it == s_tuned_configs.end()) return false;
+  config = it->second;
+  return true;
+}
+
+void IE_AutoTuner::StoreConfig(const string& key, const Config& config) {
+  std::lock_guard<std::mutex> lock(s_tuned_configs_mutex);
+  LoadCacheFile();
+  s_tuned_configs[key] = config;
+
+  string cache_file = GetCacheFile();
+  if (cache_file.empty()) return;
+  ofstream ofs(cache_file, ios::app);
+  if (!ofs.is_open()) {
+    OVTF_VLOG(0) << "Unable to open " << cache_file
+                 << " to store the tuned configuration";
+    return;
+  }
+  ofs << key << "\t" << SerializeConfig(config) << endl;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
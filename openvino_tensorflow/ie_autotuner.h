@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+// IE_AutoTuner keeps track of the plugin configurations (streams, threads)
+// selected for each executable during warm-up. The selected configurations
+// are persisted to a file inside OPENVINO_TF_CACHE_DIR, next to the compiled
+// network cache of the Inference Engine, so that later runs can reuse them
+// without tuning again.
+
+#ifndef IE_AUTOTUNER_H_
+#define IE_AUTOTUNER_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+class IE_AutoTuner {
+ public:
+  using Config = std::map<std::string, std::string>;
+
+  // Returns true if OPENVINO_TF_ENABLE_AUTOTUNING is set to 1
+  static bool IsEnabled();
+  // Number of calls an executable must receive before it is tuned
+  // (OPENVINO_TF_AUTOTUNE_WARMUP_CALLS, 2 by default)
+  static int GetWarmupCalls();
+  // Number of timed inferences for each candidate configuration
+  static int GetNumIterations() { return 5; }
+  // Returns the value of OPENVINO_TF_CACHE_DIR, or an empty string
+  static std::string GetCacheDir();
+
+  // Returns the candidate plugin configurations to try on the given device.
+  // The first candidate is always the default (empty) configuration. The
+  // executables are tuned with a single synchronous request, so stream
+  // counts are not candidates: extra streams would stay idle.
+  static std::vector<Config> GetCandidateConfigs(const std::string& device);
+
+  // Fingerprint of the ops, attributes, shapes and constants of func. Part
+  // of the tuning keys, so that the clusters of different graphs with the
+  // same name and inputs don't share their configurations.
+  static std::string GetFunctionHash(
+      const std::shared_ptr<ngraph::Function>& func);
+
+  // Looks up a previously tuned configuration for the given key
+  static bool LookupConfig(const std::string& key, Config& config);
+  // Records the tuned configuration for the given key and persists it if
+  // OPENVINO_TF_CACHE_DIR is set
+  static void StoreConfig(const std::string& key, const Config& config);
+
+  // Config <-> "KEY1=VALUE1;KEY2=VALUE2"
+  static std::string SerializeConfig(const Config& config);
+  static bool DeserializeConfig(const std::string& str, Config& config);
+
+ private:
+  static std::string GetCacheFile();
+  static void LoadCacheFile();
+
+  static std::mutex s_tuned_configs_mutex;
+  static bool s_cache_file_loaded;
+  static std::unordered_map<std::string, Config> s_tuned_configs;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // IE_AUTOTUNER_H_
@@ -7,7 +7,9 @@
 #ifndef IE_BACKEND_ENGINE_H_
 #define IE_BACKEND_ENGINE_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -18,18 +20,56 @@
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// Cancels the inference requests of a single infer() call. The caller of
+// infer() owns it and may call Cancel() from any thread; the engine binds
+// the requests it runs for the call and unbinds them before they can be
+// reused by another call, so that only this call is cancelled.
+class IE_InferCancellation {
+ public:
+  void Cancel();
+  bool IsCancelled();
+  // Binds req to the call. Throws if the call has already been cancelled.
+  void Bind(InferenceEngine::InferRequest req);
+  void Unbind();
+
+ private:
+  std::mutex m_mutex;
+  bool m_cancelled = false;
+  std::vector<InferenceEngine::InferRequest> m_reqs;
+};
+
+// Binds the requests of an infer() call to its cancellation, if any, until
+// the end of the scope
+class IE_CancellationScope {
+ public:
+  explicit IE_CancellationScope(IE_InferCancellation* cancellation)
+      : m_cancellation(cancellation) {}
+  ~IE_CancellationScope() {
+    if (m_cancellation != nullptr) m_cancellation->Unbind();
+  }
+  void Bind(InferenceEngine::InferRequest req) {
+    if (m_cancellation != nullptr) m_cancellation->Bind(req);
+  }
+
+ private:
+  IE_InferCancellation* m_cancellation;
+};
+
 class IE_Backend_Engine {
  public:
-  IE_Backend_Engine(InferenceEngine::CNNNetwork ie_network, std::string device);
+  IE_Backend_Engine(InferenceEngine::CNNNetwork ie_network, std::string device,
+                    std::map<std::string, std::string> config = {});
   ~IE_Backend_Engine();
 
-  // Executes the inference
+  // Executes the inference. cancellation, if not nullptr, cancels this call
+  // only; a cancelled call throws.
   virtual void infer(std::vector<std::shared_ptr<IETensor>>& inputs,
                      std::vector<std::string>& input_names,
                      std::vector<std::shared_ptr<IETensor>>& outputs,
                      std::vector<std::string>& output_names,
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
-                     std::vector<std::string>& param_names) = 0;
+                     std::vector<std::string>& param_names,
+                     IE_InferCancellation* cancellation) = 0;
 
   // Returns output batch size based on the input batch size and the device
   // FIXME: This may not be needed
@@ -50,6 +90,8 @@ class IE_Backend_Engine {
   std::shared_ptr<ngraph::Function> m_func;
   std::vector<InferenceEngine::InferRequest> m_infer_reqs;
   std::string m_device;
+  // Additional plugin configuration used while loading the network
+  std::map<std::string, std::string> m_config;
   bool m_multi_req_execution;
   InferenceEngine::ExecutableNetwork m_exe_network;
   bool m_network_ready;
@@ -57,6 +99,13 @@ class IE_Backend_Engine {
   virtual void start_async_inference(const int req_id);
   virtual void complete_async_inference(const int req_id);
   virtual void load_network();
+  // Loads m_network with the device specific settings and plugin_config
+  InferenceEngine::ExecutableNetwork load_exe_network(
+      const std::map<std::string, std::string>& plugin_config);
+  // Loads network on device and adds the time taken to the metrics
+  static InferenceEngine::ExecutableNetwork load_timed_network(
+      InferenceEngine::CNNNetwork& network, const std::string& device,
+      const std::map<std::string, std::string>& config);
 };
 }  // namespace openvino_tensorflow
 }  // namesoace tensorflow
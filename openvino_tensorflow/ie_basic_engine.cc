@@ -16,8 +16,9 @@ namespace tensorflow {
 namespace openvino_tensorflow {
 
 IE_Basic_Engine::IE_Basic_Engine(InferenceEngine::CNNNetwork ie_network,
-                                 std::string device)
-    : IE_Backend_Engine(ie_network, device) {}
+                                 std::string device,
+                                 std::map<std::string, std::string> config)
+    : IE_Backend_Engine(ie_network, device, config) {}
 
 IE_Basic_Engine::~IE_Basic_Engine() {}
 
@@ -27,7 +28,8 @@ void IE_Basic_Engine::infer(
     std::vector<std::shared_ptr<IETensor>>& outputs,
     std::vector<std::string>& output_names,
     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
-    std::vector<std::string>& param_names) {
+    std::vector<std::string>& param_names,
+    IE_InferCancellation* cancellation) {
   load_network();
   if (m_infer_reqs.empty()) {
     m_infer_reqs.push_back(m_exe_network.CreateInferRequest());
@@ -70,7 +72,11 @@ void IE_Basic_Engine::infer(
     }
   }
 
-  m_infer_reqs[0].Infer();
+  {
+    IE_CancellationScope cancellation_scope(cancellation);
+    cancellation_scope.Bind(m_infer_reqs[0]);
+    m_infer_reqs[0].Infer();
+  }
 
   // Set dynamic output blobs
   for (int i = 0; i < results.size(); i++) {
@@ -20,7 +20,8 @@ namespace openvino_tensorflow {
 
 class IE_Basic_Engine : public IE_Backend_Engine {
  public:
-  IE_Basic_Engine(InferenceEngine::CNNNetwork ie_network, std::string device);
+  IE_Basic_Engine(InferenceEngine::CNNNetwork ie_network, std::string device,
+                  std::map<std::string, std::string> config = {});
   ~IE_Basic_Engine();
 
   // Executes the inference
@@ -29,7 +30,8 @@ class IE_Basic_Engine : public IE_Backend_Engine {
                      std::vector<std::shared_ptr<IETensor>>& outputs,
                      std::vector<std::string>& output_names,
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
-                     std::vector<std::string>& param_names);
+                     std::vector<std::string>& param_names,
+                     IE_InferCancellation* cancellation);
 
   virtual const std::vector<size_t> get_output_shape(const int i) {
     return m_func->get_results()[i]->get_shape();
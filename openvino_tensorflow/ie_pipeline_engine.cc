@@ -0,0 +1,669 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "ngraph/ngraph.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/ie_pipeline_engine.h"
+#include "openvino_tensorflow/ie_utils.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+static bool IsComputeOp(const ngraph::Node* node) {
+  return !ngraph::op::is_parameter(node) && !ngraph::op::is_constant(node) &&
+         !ngraph::op::is_output(node);
+}
+
+// Name of the IE output blob holding the given result
+static string GetResultName(const shared_ptr<ngraph::Node>& result) {
+  auto parent = result->input_value(0).get_node_shared_ptr();
+  auto name = parent->get_friendly_name();
+  if (parent->outputs().size() > 1) {
+    name += "." + to_string(result->input_value(0).get_index());
+  }
+  return name;
+}
+
+static int GetIntEnv(const string& name, int default_value) {
+  string env_value = util::GetEnv(name);
+  if (env_value.empty()) return default_value;
+  return (int)strtol(env_value.c_str(), NULL, 10);
+}
+
+PipelinePartition PartitionFunction(const shared_ptr<ngraph::Function>& func,
+                                    int num_stages) {
+  if (num_stages < 2 || func->is_dynamic()) return PipelinePartition();
+  auto ops = func->get_ordered_ops();
+
+  // Assign each op to a stage by its position in the topological order,
+  // weighted by its cost, so that all the edges go forward
+  map<const ngraph::Node*, int64_t> op_costs;
+  int64_t total_cost = 0;
+  for (const auto& op : ops) {
+    if (!IsComputeOp(op.get())) continue;
+    int64_t cost = 1;
+    for (const auto& input : op->inputs()) {
+      cost += ngraph::shape_size(input.get_shape());
+    }
+    for (const auto& output : op->outputs()) {
+      cost += ngraph::shape_size(output.get_shape());
+    }
+    op_costs[op.get()] = cost;
+    total_cost += cost;
+  }
+  map<const ngraph::Node*, int> op_stages;
+  int64_t cumulative_cost = 0;
+  total_cost = max<int64_t>(1, total_cost);
+  for (const auto& op : ops) {
+    if (!IsComputeOp(op.get())) continue;
+    op_stages[op.get()] = min<int64_t>(
+        num_stages - 1, cumulative_cost * num_stages / total_cost);
+    cumulative_cost += op_costs[op.get()];
+  }
+
+  PipelinePartition partition;
+  map<ngraph::Output<ngraph::Node>, size_t> value_ids;
+  auto get_value_id = [&value_ids](const ngraph::Output<ngraph::Node>& output) {
+    auto it = value_ids.find(output);
+    if (it != value_ids.end()) return it->second;
+    size_t id = value_ids.size();
+    value_ids[output] = id;
+    return id;
+  };
+  for (const auto& param : func->get_parameters()) {
+    partition.parameter_values.push_back(get_value_id(param->output(0)));
+  }
+  for (const auto& result : func->get_results()) {
+    auto source = result->input_value(0);
+    if (!IsComputeOp(source.get_node())) return PipelinePartition();
+    partition.result_values.push_back(get_value_id(source));
+  }
+
+  vector<ngraph::ParameterVector> stage_params(num_stages);
+  vector<ngraph::ResultVector> stage_results(num_stages);
+  vector<PipelineStage> stages(num_stages);
+  // Outputs of the original function mapped to the outputs of each stage
+  vector<map<ngraph::Output<ngraph::Node>, ngraph::Output<ngraph::Node>>>
+      stage_outputs(num_stages);
+  for (const auto& op : ops) {
+    if (!IsComputeOp(op.get())) continue;
+    int stage = op_stages[op.get()];
+    auto& local_outputs = stage_outputs[stage];
+
+    ngraph::OutputVector new_inputs;
+    for (const auto& input : op->inputs()) {
+      auto source = input.get_source_output();
+      auto it = local_outputs.find(source);
+      if (it == local_outputs.end()) {
+        if (ngraph::op::is_constant(source.get_node())) {
+          // Constants are duplicated instead of crossing the stages
+          auto constant =
+              source.get_node()->clone_with_new_inputs(ngraph::OutputVector{});
+          local_outputs[source] = constant->output(0);
+        } else {
+          // Produced by a previous stage or fed to the function
+          size_t id = get_value_id(source);
+          auto param = make_shared<opset::Parameter>(
+              source.get_element_type(), source.get_partial_shape());
+          param->set_friendly_name("ovtf_pipeline_value_" + to_string(id));
+          stage_params[stage].push_back(param);
+          stages[stage].input_values.push_back(id);
+          local_outputs[source] = param->output(0);
+        }
+        it = local_outputs.find(source);
+      }
+      new_inputs.push_back(it->second);
+    }
+
+    auto clone = op->clone_with_new_inputs(new_inputs);
+    clone->set_friendly_name(op->get_friendly_name());
+    for (size_t i = 0; i < op->get_output_size(); i++) {
+      auto output = op->output(i);
+      local_outputs[output] = clone->output(i);
+      bool exported = value_ids.count(output) > 0;
+      for (const auto& target : output.get_target_inputs()) {
+        auto consumer = target.get_node();
+        exported |= IsComputeOp(consumer) && op_stages[consumer] > stage;
+      }
+      if (exported) {
+        stage_results[stage].push_back(
+            make_shared<opset::Result>(clone->output(i)));
+        stages[stage].output_values.push_back(get_value_id(output));
+      }
+    }
+  }
+
+  for (int i = 0; i < num_stages; i++) {
+    if (stage_results[i].empty()) continue;
+    stages[i].function = make_shared<ngraph::Function>(
+        stage_results[i], stage_params[i],
+        func->get_friendly_name() + "_stage_" +
+            to_string(partition.stages.size()));
+    partition.stages.push_back(stages[i]);
+  }
+  if (partition.stages.size() < 2) return PipelinePartition();
+  partition.num_values = value_ids.size();
+  return partition;
+}
+
+// Reads the constant input of node holding axes, made positive for rank
+static bool GetConstantAxes(const shared_ptr<ngraph::Node>& node,
+                            size_t input, int64_t rank,
+                            vector<int64_t>& axes) {
+  auto constant = dynamic_pointer_cast<opset::Constant>(
+      node->get_input_node_shared_ptr(input));
+  if (constant == nullptr) return false;
+  axes = constant->cast_vector<int64_t>();
+  for (auto& axis : axes) {
+    if (axis < 0) axis += rank;
+  }
+  return true;
+}
+
+// Returns true if each row of the outputs of node only depends on the same
+// row of its batched inputs, batched[i] telling if input i carries the batch
+// on its first axis. Unknown ops are assumed to mix the rows.
+static bool IsRowWise(const shared_ptr<ngraph::Node>& node,
+                      const vector<bool>& batched) {
+  static const unordered_set<string> elementwise_ops{
+      "Abs", "Add", "Ceiling", "Clamp", "Convert", "Cos", "Divide", "Elu",
+      "Equal", "Erf", "Exp", "Floor", "FloorMod", "Gelu", "Greater",
+      "GreaterEqual", "HSigmoid", "HSwish", "Less", "LessEqual", "Log",
+      "LogicalAnd", "LogicalNot", "LogicalOr", "Maximum", "Minimum", "Mish",
+      "Mod", "Multiply", "Negative", "NotEqual", "Power", "PRelu", "Relu",
+      "Select", "Sigmoid", "Sign", "Sin", "SoftPlus", "Sqrt",
+      "SquaredDifference", "Subtract", "Swish", "Tanh"};
+  // The weights and the moving statistics are the same for every row
+  static const unordered_set<string> per_sample_ops{
+      "AvgPool", "BatchNormInference", "Convolution", "GroupConvolution",
+      "MaxPool"};
+  string type = node->get_type_info().name;
+  int64_t rank = node->get_input_partial_shape(0).rank().get_length();
+  auto batched_from = [&batched](size_t first) {
+    return any_of(batched.begin() + first, batched.end(),
+                  [](bool b) { return b; });
+  };
+  auto keeps_first_axis = [&node, rank](size_t input) {
+    vector<int64_t> axes;
+    return GetConstantAxes(node, input, rank, axes) &&
+           find(axes.begin(), axes.end(), 0) == axes.end();
+  };
+
+  if (elementwise_ops.count(type)) {
+    // A constant with rows of its own would be broadcast whole to each
+    // micro-batch
+    size_t output_rank = node->get_output_shape(0).size();
+    for (size_t i = 0; i < batched.size(); i++) {
+      auto shape = node->get_input_shape(i);
+      if (!batched[i] && shape.size() == output_rank && shape[0] != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (per_sample_ops.count(type)) return batched[0] && !batched_from(1);
+  if (type == "MatMul") {
+    auto matmul = dynamic_pointer_cast<opset::MatMul>(node);
+    return batched[0] && !batched_from(1) && !matmul->get_transpose_a() &&
+           node->get_input_shape(1).size() <= 2;
+  }
+  if (type == "Softmax") {
+    return dynamic_pointer_cast<opset::Softmax>(node)->get_axis() != 0;
+  }
+  if (type == "Concat") {
+    return dynamic_pointer_cast<opset::Concat>(node)
+               ->get_concatenation_axis() != 0;
+  }
+  if (type.compare(0, 6, "Reduce") == 0 || type == "Split" ||
+      type == "VariadicSplit") {
+    return batched[0] && !batched_from(1) && keeps_first_axis(1);
+  }
+  if (type == "Transpose") {
+    vector<int64_t> order;
+    return batched[0] && !batched_from(1) &&
+           GetConstantAxes(node, 1, rank, order) && !order.empty() &&
+           order[0] == 0;
+  }
+  // The caller checks that the batch stays on the first axis, so the
+  // row-major layout keeps the rows whole
+  if (type == "Reshape" || type == "Squeeze" || type == "Unsqueeze") {
+    return batched[0] && !batched_from(1);
+  }
+  return false;
+}
+
+shared_ptr<ngraph::Function> MakeMicroBatchFunction(
+    const shared_ptr<ngraph::Function>& func, int num_micro_batches) {
+  if (func->is_dynamic()) return nullptr;
+  size_t batch_size = 0;
+  for (const auto& param : func->get_parameters()) {
+    auto shape = param->get_shape();
+    if (shape.empty()) return nullptr;
+    if (batch_size == 0) batch_size = shape[0];
+    if (shape[0] != batch_size) return nullptr;
+  }
+  if (batch_size == 0 || batch_size % num_micro_batches != 0) return nullptr;
+  for (const auto& result : func->get_results()) {
+    auto shape = result->get_shape();
+    if (shape.empty() || shape[0] != batch_size) return nullptr;
+  }
+  // The batch must flow through ops working on each row on its own, from the
+  // parameters to the results
+  unordered_set<const ngraph::Node*> batched_nodes;
+  for (const auto& node : func->get_ordered_ops()) {
+    if (ngraph::op::is_parameter(node)) {
+      batched_nodes.insert(node.get());
+      continue;
+    }
+    vector<bool> batched;
+    for (const auto& input : node->inputs()) {
+      batched.push_back(
+          batched_nodes.count(input.get_source_output().get_node()) > 0);
+    }
+    if (ngraph::op::is_output(node) ||
+        none_of(batched.begin(), batched.end(), [](bool b) { return b; })) {
+      continue;
+    }
+    if (!IsRowWise(node, batched)) {
+      OVTF_VLOG(1) << "Can't split " << func->get_friendly_name()
+                   << " in micro-batches: " << node->get_friendly_name()
+                   << " mixes the rows of the batch";
+      return nullptr;
+    }
+    for (const auto& output : node->outputs()) {
+      auto shape = output.get_shape();
+      if (shape.empty() || shape[0] != batch_size) return nullptr;
+    }
+    batched_nodes.insert(node.get());
+  }
+
+  size_t micro_batch_size = batch_size / num_micro_batches;
+  auto micro_func = ngraph::clone_function(*func);
+  for (const auto& param : micro_func->get_parameters()) {
+    auto shape = param->get_shape();
+    shape[0] = micro_batch_size;
+    param->set_partial_shape(shape);
+  }
+  try {
+    micro_func->validate_nodes_and_infer_types();
+  } catch (const std::exception& exp) {
+    OVTF_VLOG(1) << "Can't split " << func->get_friendly_name()
+                 << " in micro-batches: " << exp.what();
+    return nullptr;
+  }
+  // Shapes that are constants of the graph, e.g. the target of a Reshape,
+  // don't follow the batch size
+  for (size_t i = 0; i < func->get_results().size(); i++) {
+    auto shape = func->get_results()[i]->get_shape();
+    shape[0] = micro_batch_size;
+    if (micro_func->get_results()[i]->get_output_partial_shape(0) !=
+        ngraph::PartialShape(shape)) {
+      return nullptr;
+    }
+  }
+  return micro_func;
+}
+
+int IE_Pipeline_Engine::GetNumStages() {
+  int num_stages = GetIntEnv("OPENVINO_TF_PIPELINE_STAGES", 0);
+  return num_stages < 2 ? 0 : num_stages;
+}
+
+// Returns the cores this process may run on, in increasing order
+static vector<int> GetAllowedCores() {
+  vector<int> cores;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    for (int i = 0; i < CPU_SETSIZE; i++) {
+      if (CPU_ISSET(i, &allowed)) cores.push_back(i);
+    }
+  } else {
+    OVTF_VLOG(1) << "Unable to read the CPU affinity of the process: "
+                 << strerror(errno);
+  }
+#endif
+  if (cores.empty()) {
+    int num_cores = max(1, (int)std::thread::hardware_concurrency());
+    for (int i = 0; i < num_cores; i++) cores.push_back(i);
+  }
+  return cores;
+}
+
+shared_ptr<IE_Pipeline_Engine> IE_Pipeline_Engine::Create(
+    InferenceEngine::CNNNetwork ie_network, string device,
+    map<string, string> config) {
+  int num_stages = GetNumStages();
+  if (num_stages == 0 || device != "CPU") return nullptr;
+
+  auto func = ie_network.getFunction();
+  int num_micro_batches =
+      GetIntEnv("OPENVINO_TF_PIPELINE_MICRO_BATCHES", num_stages);
+  auto staged_func = func;
+  if (num_micro_batches > 1) {
+    staged_func = MakeMicroBatchFunction(func, num_micro_batches);
+    if (staged_func == nullptr) {
+      OVTF_VLOG(1) << "Pipelining " << func->get_friendly_name()
+                   << " without micro-batches";
+      num_micro_batches = 1;
+      staged_func = func;
+    }
+  } else {
+    num_micro_batches = 1;
+  }
+
+  auto partition = PartitionFunction(staged_func, num_stages);
+  if (partition.stages.empty()) {
+    OVTF_VLOG(1) << "Can't pipeline " << func->get_friendly_name();
+    return nullptr;
+  }
+  Metrics::Increment("pipelined_executables");
+  return shared_ptr<IE_Pipeline_Engine>(new IE_Pipeline_Engine(
+      ie_network, device, config, move(partition), num_micro_batches));
+}
+
+IE_Pipeline_Engine::IE_Pipeline_Engine(InferenceEngine::CNNNetwork ie_network,
+                                       string device,
+                                       map<string, string> config,
+                                       PipelinePartition partition,
+                                       int num_micro_batches)
+    : IE_Backend_Engine(ie_network, device, config),
+      m_partition(move(partition)),
+      m_num_micro_batches(num_micro_batches) {
+  size_t num_stages = m_partition.stages.size();
+  vector<int> cores = GetAllowedCores();
+  // A thread quota of the configuration is shared by the stages
+  auto threads = m_config.find("CPU_THREADS_NUM");
+  if (threads != m_config.end()) {
+    int max_threads = atoi(threads->second.c_str());
+    if (max_threads > 0 && max_threads < (int)cores.size()) {
+      cores.resize(max_threads);
+    }
+    m_config.erase(threads);
+  }
+  m_cores_per_stage = max(1, (int)cores.size() / (int)num_stages);
+  // The groups of each pipelined executable start one group further, so
+  // that the first stages of the executables don't all share the same cores
+  static atomic<int> s_num_pipelines(0);
+  int first_group = s_num_pipelines++;
+  for (size_t i = 0; i < num_stages; i++) {
+    vector<int> group;
+    int first_core = (int)((first_group + i) % num_stages) * m_cores_per_stage;
+    for (int j = first_core;
+         j < min((int)cores.size(), first_core + m_cores_per_stage); j++) {
+      group.push_back(cores[j]);
+    }
+    m_stage_cores.push_back(group);
+  }
+  OVTF_VLOG(1) << "Pipelining " << m_func->get_friendly_name() << " in "
+               << num_stages << " stages of " << m_cores_per_stage
+               << " cores with " << m_num_micro_batches << " micro-batches";
+
+  const auto& params = m_func->get_parameters();
+  for (size_t i = 0; i < params.size(); i++) {
+    m_parameter_indices[params[i]->get_friendly_name()] = i;
+  }
+
+  int queue_depth = max(1, GetIntEnv("OPENVINO_TF_PIPELINE_QUEUE_DEPTH", 2));
+  for (size_t i = 0; i < num_stages; i++) {
+    m_queues.emplace_back(new BoundedQueue(queue_depth));
+  }
+  // All the micro-batches of a call fit in the last queue, so that the
+  // stages never wait for infer() to collect them
+  m_queues.emplace_back(new BoundedQueue(m_num_micro_batches));
+  for (size_t i = 0; i < num_stages; i++) {
+    m_stage_threads.emplace_back(&IE_Pipeline_Engine::RunStage, this, i);
+  }
+}
+
+IE_Pipeline_Engine::~IE_Pipeline_Engine() {
+  for (auto& queue : m_queues) {
+    queue->Close();
+  }
+  for (auto& thread : m_stage_threads) {
+    thread.join();
+  }
+}
+
+void IE_Pipeline_Engine::BoundedQueue::Push(int item) {
+  unique_lock<mutex> lock(m_mutex);
+  m_not_full.wait(lock,
+                  [this]() { return m_closed || m_items.size() < m_capacity; });
+  if (m_closed) return;
+  m_items.push_back(item);
+  m_not_empty.notify_one();
+}
+
+int IE_Pipeline_Engine::BoundedQueue::Pop() {
+  unique_lock<mutex> lock(m_mutex);
+  m_not_empty.wait(lock, [this]() { return m_closed || !m_items.empty(); });
+  if (m_items.empty()) return -1;
+  int item = m_items.front();
+  m_items.pop_front();
+  m_not_full.notify_one();
+  return item;
+}
+
+void IE_Pipeline_Engine::BoundedQueue::Close() {
+  lock_guard<mutex> lock(m_mutex);
+  m_closed = true;
+  m_not_empty.notify_all();
+  m_not_full.notify_all();
+}
+
+void IE_Pipeline_Engine::LoadStages() {
+  if (m_network_ready) return;
+  for (size_t i = 0; i < m_partition.stages.size(); i++) {
+    const auto& stage_func = m_partition.stages[i].function;
+    InferenceEngine::CNNNetwork network(stage_func);
+    vector<string> input_names, output_names;
+    auto inputs_info = network.getInputsInfo();
+    for (const auto& param : stage_func->get_parameters()) {
+      input_names.push_back(param->get_friendly_name());
+      inputs_info[input_names.back()]->setPrecision(
+          IE_Utils::toPrecision(param->get_element_type()));
+    }
+    auto outputs_info = network.getOutputsInfo();
+    for (const auto& result : stage_func->get_results()) {
+      output_names.push_back(GetResultName(result));
+      outputs_info[output_names.back()]->setPrecision(
+          IE_Utils::toPrecision(result->get_element_type()));
+    }
+
+    // The Inference Engine has no core mask per network, so each stage is
+    // limited to the size of its group and the thread driving it is pinned
+    // to it
+    map<string, string> config = {
+        {"CPU_THREADS_NUM", to_string(m_cores_per_stage)},
+        {"CPU_THROUGHPUT_STREAMS", "1"},
+        {"CPU_BIND_THREAD", "NO"}};
+    for (const auto& it : m_config) {
+      config[it.first] = it.second;
+    }
+    auto exe_network = load_timed_network(network, m_device, config);
+    m_stage_networks.push_back(exe_network);
+    m_stage_input_names.push_back(input_names);
+    m_stage_output_names.push_back(output_names);
+    m_infer_reqs.push_back(exe_network.CreateInferRequest());
+  }
+  m_network_ready = true;
+}
+
+void IE_Pipeline_Engine::RunStage(size_t stage_idx) {
+#ifdef __linux__
+  // Only this thread, which drives the stage, is pinned. The compute threads
+  // of the stage network are created by the plugin and are not pinned
+  // (CPU_BIND_THREAD is NO); CPU_THREADS_NUM only limits their number.
+  cpu_set_t cores;
+  CPU_ZERO(&cores);
+  for (int core : m_stage_cores[stage_idx]) {
+    CPU_SET(core, &cores);
+  }
+  if (CPU_COUNT(&cores) > 0) {
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+    if (error != 0) {
+      Metrics::Increment("pipeline_affinity_failures");
+      OVTF_VLOG(1) << "Unable to pin stage " << stage_idx << " of "
+                   << m_func->get_friendly_name() << ": " << strerror(error);
+    }
+  }
+#endif
+
+  const auto& stage = m_partition.stages[stage_idx];
+  int micro_batch;
+  while ((micro_batch = m_queues[stage_idx]->Pop()) >= 0) {
+    // A micro-batch that failed in a previous stage is passed along so that
+    // infer() can collect it
+    if (m_errors[micro_batch] == nullptr) {
+      try {
+        auto& req = m_infer_reqs[stage_idx];
+        auto& values = m_values[micro_batch];
+        for (size_t i = 0; i < stage.input_values.size(); i++) {
+          req.SetBlob(m_stage_input_names[stage_idx][i],
+                      values[stage.input_values[i]]);
+        }
+        const auto& results = stage.function->get_results();
+        for (size_t i = 0; i < stage.output_values.size(); i++) {
+          auto& blob = values[stage.output_values[i]];
+          if (blob == nullptr) {
+            auto shape = results[i]->get_shape();
+            auto precision =
+                IE_Utils::toPrecision(results[i]->get_element_type());
+            InferenceEngine::TensorDesc desc(
+                precision, shape,
+                InferenceEngine::TensorDesc::getLayoutByDims(shape));
+            InferenceEngine::MemoryBlob::Ptr memory_blob;
+            IE_Utils::CreateBlob(desc, precision, nullptr, 0, memory_blob);
+            blob = memory_blob;
+          }
+          req.SetBlob(m_stage_output_names[stage_idx][i], blob);
+        }
+        req.Infer();
+      } catch (...) {
+        m_errors[micro_batch] = current_exception();
+      }
+    }
+    m_queues[stage_idx + 1]->Push(micro_batch);
+  }
+}
+
+// Returns a blob viewing the given micro-batch of tensor
+static InferenceEngine::Blob::Ptr GetMicroBatch(
+    const shared_ptr<IETensor>& tensor, int micro_batch,
+    int num_micro_batches) {
+  if (num_micro_batches == 1) return tensor->get_blob();
+  auto desc = tensor->get_blob()->getTensorDesc();
+  auto dims = desc.getDims();
+  dims[0] /= num_micro_batches;
+  InferenceEngine::TensorDesc micro_desc(desc.getPrecision(), dims,
+                                         desc.getLayout());
+  auto precision = desc.getPrecision();
+  size_t size = tensor->get_blob()->byteSize() / num_micro_batches;
+  InferenceEngine::MemoryBlob::Ptr blob;
+  IE_Utils::CreateBlob(
+      micro_desc, precision,
+      (const uint8_t*)tensor->get_data_ptr() + size * micro_batch, size, blob);
+  return blob;
+}
+
+void IE_Pipeline_Engine::infer(
+    vector<shared_ptr<IETensor>>& inputs, vector<string>& input_names,
+    vector<shared_ptr<IETensor>>& outputs, vector<string>& output_names,
+    vector<shared_ptr<IETensor>>& hoisted_params, vector<string>& param_names,
+    IE_InferCancellation* cancellation) {
+  lock_guard<mutex> lock(m_infer_mutex);
+  LoadStages();
+
+  m_values.assign(m_num_micro_batches, vector<InferenceEngine::Blob::Ptr>(
+                                           m_partition.num_values));
+  m_errors.assign(m_num_micro_batches, nullptr);
+
+  auto set_parameter = [this](const shared_ptr<IETensor>& tensor,
+                              const string& name) {
+    auto it = m_parameter_indices.find(name);
+    if (it == m_parameter_indices.end()) {
+      throw runtime_error("Input " + name + " not found in the pipeline");
+    }
+    size_t id = m_partition.parameter_values[it->second];
+    for (int i = 0; i < m_num_micro_batches; i++) {
+      m_values[i][id] = GetMicroBatch(tensor, i, m_num_micro_batches);
+    }
+  };
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i] != nullptr) set_parameter(inputs[i], input_names[i]);
+  }
+  for (size_t i = 0; i < hoisted_params.size(); i++) {
+    if (hoisted_params[i] != nullptr) {
+      set_parameter(hoisted_params[i], param_names[i]);
+    }
+  }
+
+  // The stages write straight into the outputs. An output repeating an
+  // earlier one is copied at the end.
+  const auto& results = m_func->get_results();
+  map<size_t, size_t> first_output_of_value;
+  for (size_t i = 0; i < results.size(); i++) {
+    if (outputs[i] == nullptr) {
+      outputs[i] = make_shared<IETensor>(results[i]->get_element_type(),
+                                         results[i]->get_shape());
+    }
+    size_t id = m_partition.result_values[i];
+    if (first_output_of_value.count(id)) continue;
+    first_output_of_value[id] = i;
+    for (int j = 0; j < m_num_micro_batches; j++) {
+      m_values[j][id] = GetMicroBatch(outputs[i], j, m_num_micro_batches);
+    }
+  }
+
+  {
+    // The stage requests only run micro-batches of this call until it
+    // returns, since the calls are serialized
+    IE_CancellationScope cancellation_scope(cancellation);
+    for (auto& req : m_infer_reqs) {
+      cancellation_scope.Bind(req);
+    }
+    for (int i = 0; i < m_num_micro_batches; i++) {
+      m_queues[0]->Push(i);
+    }
+    for (int i = 0; i < m_num_micro_batches; i++) {
+      m_queues.back()->Pop();
+    }
+  }
+  m_values.clear();
+
+  for (const auto& error : m_errors) {
+    if (error != nullptr) rethrow_exception(error);
+  }
+  for (size_t i = 0; i < results.size(); i++) {
+    size_t first = first_output_of_value[m_partition.result_values[i]];
+    if (first != i) {
+      outputs[i]->write(outputs[first]->get_data_ptr(),
+                        outputs[first]->get_size_in_bytes());
+    }
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
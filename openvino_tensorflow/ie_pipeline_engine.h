@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef IE_PIPELINE_ENGINE_H_
+#define IE_PIPELINE_ENGINE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ie_core.hpp>
+
+#include "openvino_tensorflow/ie_backend_engine.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// A stage of a pipelined function. The tensors flowing between the stages
+// are numbered, and each stage reads and writes some of them.
+struct PipelineStage {
+  std::shared_ptr<ngraph::Function> function;
+  // Tensor read by each parameter of the function
+  std::vector<size_t> input_values;
+  // Tensor written by each result of the function
+  std::vector<size_t> output_values;
+};
+
+struct PipelinePartition {
+  std::vector<PipelineStage> stages;
+  size_t num_values = 0;
+  // Tensors holding the parameters and the results of the original function
+  std::vector<size_t> parameter_values;
+  std::vector<size_t> result_values;
+};
+
+// Splits func into at most num_stages sequential stages of similar cost, the
+// cost of an op being the number of elements it reads and writes. Constants
+// are duplicated into the stages that use them. Returns an empty partition if
+// func has dynamic shapes, has results fed by constants or yields less than
+// two non-empty stages.
+PipelinePartition PartitionFunction(
+    const std::shared_ptr<ngraph::Function>& func, int num_stages);
+
+// Returns a copy of func working on a batch num_micro_batches times smaller,
+// or nullptr if the first dimension of the parameters and results isn't a
+// common batch dimension, or if an op of func mixes the rows of the batch
+// (e.g. a reduction, a gather or a reverse along the first axis).
+std::shared_ptr<ngraph::Function> MakeMicroBatchFunction(
+    const std::shared_ptr<ngraph::Function>& func, int num_micro_batches);
+
+// Executes a network as a pipeline of stages, each compiled as its own
+// executable network limited to the size of a disjoint group of the cores
+// allowed for the process, with the thread driving it pinned to the group
+// on Linux. The batch is split in micro-batches that stream through the
+// stages, with bounded queues between them, so that the stages work on
+// different micro-batches at the same time. Enabled on CPU with
+// OPENVINO_TF_PIPELINE_STAGES.
+class IE_Pipeline_Engine : public IE_Backend_Engine {
+ public:
+  // Returns nullptr if pipelining is disabled or the network can't be split.
+  // config is applied to the network of each stage, except for
+  // CPU_THREADS_NUM, which limits the cores shared by the stages.
+  static std::shared_ptr<IE_Pipeline_Engine> Create(
+      InferenceEngine::CNNNetwork ie_network, std::string device,
+      std::map<std::string, std::string> config = {});
+  ~IE_Pipeline_Engine();
+
+  // Number of stages requested with OPENVINO_TF_PIPELINE_STAGES, 0 if
+  // pipelining is disabled
+  static int GetNumStages();
+
+  // Executes the inference
+  virtual void infer(std::vector<std::shared_ptr<IETensor>>& inputs,
+                     std::vector<std::string>& input_names,
+                     std::vector<std::shared_ptr<IETensor>>& outputs,
+                     std::vector<std::string>& output_names,
+                     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+                     std::vector<std::string>& param_names,
+                     IE_InferCancellation* cancellation);
+
+  virtual const std::vector<size_t> get_output_shape(const int i) {
+    return m_func->get_results()[i]->get_shape();
+  };
+
+ private:
+  IE_Pipeline_Engine(InferenceEngine::CNNNetwork ie_network,
+                     std::string device,
+                     std::map<std::string, std::string> config,
+                     PipelinePartition partition, int num_micro_batches);
+
+  // Blocking queue of micro-batch indices with a bounded capacity. Pop()
+  // returns -1 once the queue is closed.
+  class BoundedQueue {
+   public:
+    explicit BoundedQueue(size_t capacity) : m_capacity(capacity) {}
+    void Push(int item);
+    int Pop();
+    void Close();
+
+   private:
+    size_t m_capacity;
+    bool m_closed = false;
+    std::deque<int> m_items;
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+  };
+
+  void LoadStages();
+  void RunStage(size_t stage_idx);
+
+  PipelinePartition m_partition;
+  int m_num_micro_batches;
+  int m_cores_per_stage;
+  // Cores of each stage, taken from the CPU affinity of the process
+  std::vector<std::vector<int>> m_stage_cores;
+  // Index of each parameter of m_func by name
+  std::map<std::string, size_t> m_parameter_indices;
+  std::vector<InferenceEngine::ExecutableNetwork> m_stage_networks;
+  std::vector<std::vector<std::string>> m_stage_input_names;
+  std::vector<std::vector<std::string>> m_stage_output_names;
+  // m_queues[i] feeds stage i, the last one collects the finished
+  // micro-batches
+  std::vector<std::unique_ptr<BoundedQueue>> m_queues;
+  std::vector<std::thread> m_stage_threads;
+  // Tensors of each micro-batch of the running infer() call, and the error
+  // raised by the stages for it. A micro-batch is only touched by the stage
+  // that popped it, the queues order the accesses.
+  std::vector<std::vector<InferenceEngine::Blob::Ptr>> m_values;
+  std::vector<std::exception_ptr> m_errors;
+  // Serializes the infer() calls
+  std::mutex m_infer_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // IE_PIPELINE_ENGINE_H_
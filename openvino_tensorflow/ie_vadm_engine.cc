@@ -25,7 +25,8 @@ void IE_VADM_Engine::infer(
     std::vector<std::shared_ptr<IETensor>>& outputs,
     std::vector<std::string>& output_names,
     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
-    std::vector<std::string>& param_names) {
+    std::vector<std::string>& param_names,
+    IE_InferCancellation* cancellation) {
   // Batch size is 0 and the number of requests is 1 when
   // multi request execution is disabled.
   int num_req = 1;
@@ -115,12 +116,18 @@ void IE_VADM_Engine::infer(
   }
 
   // Start Inference Requests
-  for (int i = 0; i < num_req; i++) {
-    start_async_inference(i);
-  }
-  // Complete Inference Requests
-  for (int i = 0; i < num_req; i++) {
-    complete_async_inference(i);
+  {
+    IE_CancellationScope cancellation_scope(cancellation);
+    for (int i = 0; i < num_req; i++) {
+      cancellation_scope.Bind(m_infer_reqs[i]);
+    }
+    for (int i = 0; i < num_req; i++) {
+      start_async_inference(i);
+    }
+    // Complete Inference Requests
+    for (int i = 0; i < num_req; i++) {
+      complete_async_inference(i);
+    }
   }
 
   // Set dynamic output blobs
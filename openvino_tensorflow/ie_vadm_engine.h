@@ -29,7 +29,8 @@ class IE_VADM_Engine : public IE_Backend_Engine {
                      std::vector<std::shared_ptr<IETensor>>& outputs,
                      std::vector<std::string>& output_names,
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
-                     std::vector<std::string>& param_names);
+                     std::vector<std::string>& param_names,
+                     IE_InferCancellation* cancellation);
 
   virtual const std::vector<size_t> get_output_shape(const int i) {
     std::vector<size_t> shape = m_func->get_results()[i]->get_shape();
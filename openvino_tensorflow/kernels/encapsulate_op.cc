@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
+#include <atomic>
 #include <cstdlib>
 #include <mutex>
 #include <utility>
@@ -11,6 +12,7 @@
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/op.h"
@@ -29,9 +31,14 @@
 #include "logging/ovtf_log.h"
 #include "openvino_tensorflow/backend_manager.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/compile_scheduler.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/model_resources.h"
 #include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
 #include "openvino_tensorflow/ovtf_timer.h"
+#include "openvino_tensorflow/placement_profile.h"
+#include "openvino_tensorflow/signature_router.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 
 #ifdef _WIN32
@@ -47,6 +54,50 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// Registers a callback with the cancellation manager of the step for the
+// duration of a Compute call. TF cancels the step when it is aborted or when
+// the RunOptions deadline expires; the callback then cancels the inference
+// requests of this call only, and the pending translation or compilation is
+// abandoned at the next check.
+class ComputeCancellation {
+ public:
+  explicit ComputeCancellation(OpKernelContext* ctx)
+      : m_manager(ctx->cancellation_manager()),
+        m_token(CancellationManager::kInvalidToken),
+        m_cancelled(false) {
+    if (m_manager == nullptr) return;
+    m_token = m_manager->get_cancellation_token();
+    if (!m_manager->RegisterCallback(m_token, [this]() { Cancel(); })) {
+      // The step has already been cancelled
+      m_token = CancellationManager::kInvalidToken;
+      m_cancelled = true;
+    }
+  }
+
+  ~ComputeCancellation() {
+    if (m_token != CancellationManager::kInvalidToken) {
+      // Blocks until a running callback has returned
+      m_manager->DeregisterCallback(m_token);
+    }
+  }
+
+  bool IsCancelled() const { return m_cancelled; }
+
+  // Passed to Executable::Call() to cancel the inference of this call
+  IE_InferCancellation* GetInferCancellation() { return &m_infer; }
+
+ private:
+  void Cancel() {
+    m_cancelled = true;
+    m_infer.Cancel();
+  }
+
+  CancellationManager* m_manager;
+  CancellationToken m_token;
+  std::atomic<bool> m_cancelled;
+  IE_InferCancellation m_infer;
+};
+
 class NGraphEncapsulateOp : public OpKernel {
  public:
   explicit NGraphEncapsulateOp(OpKernelConstruction* ctx);
@@ -54,18 +105,40 @@ class NGraphEncapsulateOp : public OpKernel {
   void Compute(OpKernelContext* ctx) override;
 
  private:
-  Status GetExecutable(const std::vector<Tensor>& tf_input_tensors,
-                       std::shared_ptr<Executable>& ng_exec);
-  Status Fallback(OpKernelContext* ctx);
+  Status GetExecutable(
+      const std::vector<Tensor>& tf_input_tensors,
+      const ComputeCancellation& cancellation, std::string& signature,
+      std::shared_ptr<Executable>& ng_exec,
+      std::unique_ptr<CompileScheduler::Ticket>& compile_ticket,
+      std::unique_ptr<ModelResources::CompileSlot>& compile_slot,
+      std::unique_lock<std::mutex>& lock);
+  // Runs the cluster with TF. If permanent is true, all the following calls
+  // run with TF as well.
+  Status Fallback(OpKernelContext* ctx, bool permanent = true);
+  // Records a call of the cluster with PlacementProfile, whichever of
+  // OpenVINO and TF ran it
+  void RecordPlacementCall(OpKernelContext* ctx, int64 time_us);
+  int64 EstimateCompileMemory(const std::vector<Tensor>& tf_input_tensors);
 
   std::mutex m_compute_lock_;
   Graph m_graph;
+  // Created on the first translation of m_graph and reused afterwards
+  std::unique_ptr<Builder::TranslationPlan> m_translation_plan;
   int m_cluster_id;
+  // Model whose resources this op accounts to, see ModelResources
+  std::string m_model;
   int m_function_cache_depth_in_items = 16;
   string m_name;
   std::vector<bool> m_input_is_static;
+  // Size of the constants of m_graph, each of them is held by the nGraph
+  // function, the CNNNetwork and the loaded network while compiling
+  int64 m_constant_bytes = 0;
+  // Largest memory growth observed while compiling this cluster
+  int64 m_observed_compile_bytes = 0;
   std::list<std::string> m_lru;
   std::unordered_map<std::string, std::shared_ptr<Executable>> m_ng_exec_map;
+  // Set if OPENVINO_TF_RUNTIME_ROUTING is enabled
+  std::unique_ptr<SignatureRouter> m_router;
   ngraph::ResultVector ng_result_list;
   std::shared_ptr<tensorflow::Session> m_session;
   std::vector<std::string> m_session_input_names;
@@ -149,6 +222,12 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
   std::vector<const Node*> arg_nodes;
 
   for (auto node : m_graph.nodes()) {
+    if (node->type_string() == "Const") {
+      Tensor value;
+      if (GetNodeAttr(node->attrs(), "value", &value) == Status::OK()) {
+        m_constant_bytes += value.TotalBytes();
+      }
+    }
     if (node->type_string() == "_Arg") {
       arg_nodes.push_back(node);
 
@@ -188,11 +267,22 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
     m_input_is_static[index] = is_static;
   }
 
+  if (SignatureRouter::IsEnabled()) {
+    m_router.reset(new SignatureRouter(m_cluster_id));
+  }
+
   // Get the optional attributes
   std::unordered_map<std::string, std::string> additional_attribute_map;
   auto node_def = ctx->def();
   OP_REQUIRES_OK(
       ctx, ParseNodeAttributes(node_def.attr(), &additional_attribute_map));
+
+  int graph_id;
+  OP_REQUIRES_OK(ctx, ctx->GetAttr<int>("ngraph_graph_id", &graph_id));
+  m_model = ModelResources::GetModelName(additional_attribute_map, graph_id);
+  ModelResources::SetQuotas(
+      m_model, ModelResources::ParseQuotas(additional_attribute_map,
+                                           ModelResources::GetDefaultQuotas()));
 }
 
 NGraphEncapsulateOp::~NGraphEncapsulateOp() {
@@ -201,6 +291,7 @@ NGraphEncapsulateOp::~NGraphEncapsulateOp() {
   OVTF_VLOG(2) << "~NGraphEncapsulateOp::" << name();
   NGraphClusterManager::SetMRUExecutable(m_cluster_id, nullptr);
   m_ng_exec_map.clear();
+  ModelResources::RemoveOwner(m_model, this);
 }
 
 void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
@@ -215,8 +306,21 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
     return;
   }
 
+  // Declared before the cancellation so that the callback is deregistered
+  // while the lock is still held, and cannot cancel the next step
+  std::unique_lock<std::mutex> lock(m_compute_lock_, std::defer_lock);
+  // Registered before waiting for the lock so that a step cancelled while
+  // queued behind another one does not run at all
+  ComputeCancellation cancellation(ctx);
+
   Timer compute_time;
-  std::lock_guard<std::mutex> lock(m_compute_lock_);
+  lock.lock();
+  if (cancellation.IsCancelled()) {
+    Metrics::Increment("cancelled_steps");
+    OP_REQUIRES(ctx, false,
+                errors::Cancelled("Step cancelled before executing cluster ",
+                                  m_cluster_id));
+  }
   int time_func_create_or_lookup;
   Timer function_lookup_or_create;
 
@@ -228,7 +332,12 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
 
   // TF input tensor
   std::vector<Tensor> tf_input_tensors;
+  std::string signature;
   std::shared_ptr<Executable> ng_exec;
+  // Held until the end of the first call of a new executable, which loads
+  // the network
+  std::unique_ptr<CompileScheduler::Ticket> compile_ticket;
+  std::unique_ptr<ModelResources::CompileSlot> compile_slot;
   int step_id;
   {
     for (int i = 0; i < ctx->num_inputs(); i++) {
@@ -238,8 +347,21 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
     step_id = ctx->step_id();
 
     // Get ngraph executable and inputs information
-    Status getex_status = GetExecutable(tf_input_tensors, ng_exec);
+    Status getex_status =
+        GetExecutable(tf_input_tensors, cancellation, signature, ng_exec,
+                      compile_ticket, compile_slot, lock);
+    if (errors::IsUnavailable(getex_status)) {
+      // The compile could not be admitted, this step runs with TF and the
+      // compile is attempted again by the next one
+      OP_REQUIRES_OK(ctx, Fallback(ctx, false));
+      return;
+    }
     NGraphClusterManager::SetMRUExecutable(m_cluster_id, ng_exec);
+    if (errors::IsCancelled(getex_status)) {
+      // No point in falling back to TF for a step nobody waits for
+      Metrics::Increment("cancelled_steps");
+      OP_REQUIRES_OK(ctx, getex_status);
+    }
     if (getex_status != Status::OK()) {
       if (NGraphClusterManager::IsClusterFallbackEnabled()) {
         OP_REQUIRES_OK(ctx, Fallback(ctx));
@@ -257,6 +379,17 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
     time_func_create_or_lookup = function_lookup_or_create.ElapsedInMS();
   }
 
+  if (m_router != nullptr &&
+      m_router->Next(signature) == SignatureRouter::Path::TF) {
+    Timer tf_path;
+    OP_REQUIRES_OK(ctx, Fallback(ctx, false));
+    m_router->Record(signature, SignatureRouter::Path::TF,
+                     tf_path.ElapsedInMicroSec());
+    Metrics::Increment("routing_tf_calls");
+    return;
+  }
+  Timer openvino_path;
+
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got graph for cluster "
                << m_cluster_id;
 
@@ -304,6 +437,9 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
   // Allocate tensors for the output results.
 
   auto results = ng_exec->GetResults();
+  // The member list belongs to the last compiled executable, and the
+  // outputs are read after the lock is released on the reentrant path
+  ngraph::ResultVector result_list = ng_result_list;
   std::string device;
   BackendManager::GetBackendName(device);
   auto backend = BackendManager::GetBackend();
@@ -312,9 +448,9 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
   std::vector<shared_ptr<ngraph::runtime::Tensor>> ng_func_outputs(
       results.size(), nullptr);
   std::vector<shared_ptr<ngraph::runtime::Tensor>> ng_outputs(
-      ng_result_list.size(), nullptr);
+      result_list.size(), nullptr);
   std::vector<int> dyn_shape_tensors;
-  std::vector<int> output_mappings(ng_result_list.size(), -1);
+  std::vector<int> output_mappings(result_list.size(), -1);
   auto ng_output_shapes = ng_exec->GetOutputShapes();
   int j = 0;
 #if defined(OPENVINO_2021_2)
@@ -322,8 +458,8 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
 #else
   if (device != "HDDL") {
 #endif
-    for (auto i = 0; i < ng_result_list.size(); i++) {
-      auto ng_element = ng_result_list[i];
+    for (auto i = 0; i < result_list.size(); i++) {
+      auto ng_element = result_list[i];
       if (ng_element->get_output_partial_shape(0).is_dynamic()) {
         OVTF_VLOG(4)
             << "NGraphEncapsulateOp::Compute skipping output allocation for "
@@ -395,9 +531,44 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
     {
       OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
                    << m_cluster_id;
+      if (cancellation.IsCancelled()) {
+        Metrics::Increment("skipped_inferences");
+        Metrics::Increment("cancelled_steps");
+        OP_REQUIRES(ctx, false, errors::Cancelled("Step cancelled before "
+                                                  "executing cluster ",
+                                                  m_cluster_id));
+      }
       try {
-        ng_exec->Call(ng_inputs, ng_func_outputs, multi_req_execution);
+        if (ng_exec->ShouldAutoTune()) {
+          OVTF_VLOG(1) << "Auto-tuning executable for cluster "
+                       << m_cluster_id;
+          ng_exec->AutoTune(ng_inputs, ng_func_outputs,
+                            cancellation.GetInferCancellation());
+        }
+        if (ng_exec->IsReentrant()) {
+          // The next steps of the cluster can start their inference while
+          // this one runs. The rest of this call only touches its own
+          // tensors, the shared state is locked again before being used.
+          // The network is loaded by now, the compile ticket and slot are
+          // given back first so that a step compiling another signature
+          // under the lock does not wait for this one.
+          compile_ticket.reset();
+          compile_slot.reset();
+          lock.unlock();
+        }
+        ng_exec->Call(ng_inputs, ng_func_outputs, multi_req_execution,
+                      cancellation.GetInferCancellation());
       } catch (const std::exception& exp) {
+        if (!lock.owns_lock()) lock.lock();
+        if (cancellation.IsCancelled()) {
+          // The inference request was cancelled by the callback
+          Metrics::Increment("cancelled_inferences");
+          Metrics::Increment("cancelled_steps");
+          OP_REQUIRES(ctx, false,
+                      errors::Cancelled("Step cancelled while executing "
+                                        "cluster ",
+                                        m_cluster_id));
+        }
         string status_string = "Caught exception while executing cluster " +
                                to_string(m_cluster_id) + ": " +
                                string(exp.what());
@@ -409,6 +580,7 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
           OP_REQUIRES(ctx, false, errors::Internal(status_string));
         }
       } catch (...) {
+        if (!lock.owns_lock()) lock.lock();
         string status_string = "Caught exception while executing cluster " +
                                to_string(m_cluster_id);
         if (NGraphClusterManager::IsClusterFallbackEnabled()) {
@@ -421,6 +593,7 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
       }
     }
     time_execute_function = execute_function.ElapsedInMS();
+    ModelResources::RecordCall(m_model, execute_function.ElapsedInMicroSec());
   }
 
 #if defined(OPENVINO_2021_2)
@@ -457,11 +630,11 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
       return false;
     };
     int j = 0;
-    for (int i = 0; i < ng_result_list.size(); i++) {
+    for (int i = 0; i < result_list.size(); i++) {
       if (out_shape_check(i)) {
         auto ng_shape = ng_output_shapes[i];
         ngraph::element::Type expected_elem_type;
-        auto ng_element = ng_result_list[i];
+        auto ng_element = result_list[i];
         auto ng_element_type = ng_element->get_element_type();
         OP_REQUIRES_OK(ctx,
                        util::TFDataTypeToNGraphElementType(
@@ -481,11 +654,11 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
         auto ng_output = ng_func_outputs[j++];
 
         auto ng_shape = ng_output_shapes[i];
-        if (ng_result_list[i]->is_dynamic()) {
+        if (result_list[i]->is_dynamic()) {
           ng_shape = ng_output->get_shape();
         }
         ngraph::element::Type expected_elem_type;
-        auto ng_element = ng_result_list[i];
+        auto ng_element = result_list[i];
         auto ng_element_type = ng_element->get_element_type();
         OP_REQUIRES_OK(ctx,
                        util::TFDataTypeToNGraphElementType(
@@ -534,12 +707,36 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
                << " Function-Create-or-Lookup: " << time_func_create_or_lookup
                << " Create-and-copy-tensors: " << time_create_or_lookup_tensors
                << " Execute: " << time_execute_function;
+
+  RecordPlacementCall(ctx, compute_time.ElapsedInMicroSec());
+
+  if (m_router != nullptr) {
+    if (!lock.owns_lock()) lock.lock();
+    m_router->Record(signature, SignatureRouter::Path::OPENVINO,
+                     openvino_path.ElapsedInMicroSec());
+    Metrics::Increment("routing_openvino_calls");
+  }
 }  // end compute
 
+int64 NGraphEncapsulateOp::EstimateCompileMemory(
+    const std::vector<Tensor>& tf_input_tensors) {
+  int64 input_bytes = 0;
+  for (const auto& tensor : tf_input_tensors) {
+    input_bytes += tensor.TotalBytes();
+  }
+  // The intermediate tensors are assumed to be about the size of the inputs
+  return std::max(m_observed_compile_bytes,
+                  3 * m_constant_bytes + 2 * input_bytes);
+}
+
 // Computes signature and gets executable
 Status NGraphEncapsulateOp::GetExecutable(
     const std::vector<Tensor>& tf_input_tensors,
-    std::shared_ptr<Executable>& ng_exec) {
+    const ComputeCancellation& cancellation, std::string& signature,
+    std::shared_ptr<Executable>& ng_exec,
+    std::unique_ptr<CompileScheduler::Ticket>& compile_ticket,
+    std::unique_ptr<ModelResources::CompileSlot>& compile_slot,
+    std::unique_lock<std::mutex>& lock) {
   auto backend = BackendManager::GetBackend();
 
   // Compute Signature
@@ -566,12 +763,75 @@ Status NGraphEncapsulateOp::GetExecutable(
     }
   }
 
-  string signature = signature_ss.str();
+  signature = signature_ss.str();
   OVTF_VLOG(5) << "Computed signature: " << signature;
+
+  // Drop the executables evicted to keep the model within its cache quota
+  for (const auto& key : ModelResources::TakeEvicted(m_model, this)) {
+    m_ng_exec_map.erase(key);
+    m_lru.remove(key);
+    if (m_router != nullptr) m_router->Erase(key);
+  }
   auto it = m_ng_exec_map.find(signature);
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got inputs for cluster "
                << m_cluster_id;
 
+  if (it == m_ng_exec_map.end()) {
+    if (cancellation.IsCancelled()) {
+      Metrics::Increment("abandoned_translations");
+      return errors::Cancelled("Step cancelled before translating ", m_name);
+    }
+
+    // The compile quota of the model is checked first, so that a model
+    // waiting for its own compiles doesn't hold a place in the process-wide
+    // queue
+    compile_slot = ModelResources::TryAdmitCompile(m_model);
+    if (compile_slot == nullptr) {
+      if (NGraphClusterManager::IsClusterFallbackEnabled()) {
+        Metrics::Increment("compiles_deferred");
+        return errors::Unavailable("Compile of ", m_name, " is deferred");
+      }
+      // The steps with a cached signature go ahead during the wait
+      lock.unlock();
+      compile_slot = ModelResources::AdmitCompile(
+          m_model, [&cancellation]() { return cancellation.IsCancelled(); });
+      lock.lock();
+      if (compile_slot == nullptr) {
+        Metrics::Increment("abandoned_compiles");
+        return errors::Cancelled("Step cancelled while waiting to compile ",
+                                 m_name);
+      }
+    }
+
+    if (CompileScheduler::IsEnabled()) {
+      int64 estimated_bytes = EstimateCompileMemory(tf_input_tensors);
+      compile_ticket = CompileScheduler::TryAdmit(estimated_bytes);
+      if (compile_ticket == nullptr) {
+        if (NGraphClusterManager::IsClusterFallbackEnabled()) {
+          Metrics::Increment("compiles_deferred");
+          return errors::Unavailable("Compile of ", m_name, " is deferred");
+        }
+        lock.unlock();
+        compile_ticket = CompileScheduler::Admit(
+            estimated_bytes,
+            [&cancellation]() { return cancellation.IsCancelled(); });
+        lock.lock();
+        if (compile_ticket == nullptr) {
+          Metrics::Increment("abandoned_compiles");
+          return errors::Cancelled("Step cancelled while waiting to compile ",
+                                   m_name);
+        }
+      }
+    }
+
+    // Another step may have compiled the signature during the wait
+    it = m_ng_exec_map.find(signature);
+    if (it != m_ng_exec_map.end()) {
+      compile_ticket.reset();
+      compile_slot.reset();
+    }
+  }
+
   // Translate the TensorFlow graph to nGraph.
   std::shared_ptr<ngraph::Function> ng_function;
   if (it == m_ng_exec_map.end()) {
@@ -581,9 +841,17 @@ Status NGraphEncapsulateOp::GetExecutable(
 
     ng_result_list.clear();
     OVTF_VLOG(1) << "Compilation cache miss: " << m_name;
+    Timer translate_time;
+    if (m_translation_plan == nullptr) {
+      std::unique_ptr<Builder::TranslationPlan> plan(
+          new Builder::TranslationPlan());
+      TF_RETURN_IF_ERROR(Builder::CreateTranslationPlan(&m_graph, *plan));
+      m_translation_plan = std::move(plan);
+    }
     TF_RETURN_IF_ERROR(Builder::TranslateGraph(
-        input_shapes, static_input_map, &m_graph, m_name, ng_function,
-        ng_result_list, tf_input_tensors));
+        input_shapes, static_input_map, *m_translation_plan, m_name,
+        ng_function, ng_result_list, tf_input_tensors));
+    Metrics::Increment("translate_us", translate_time.ElapsedInMicroSec());
     util::DumpNGGraph(ng_function, m_name);
 
     std::vector<ngraph::Shape> ng_output_shapes;
@@ -596,6 +864,12 @@ Status NGraphEncapsulateOp::GetExecutable(
       }
     }
 
+    // Nothing has been cached yet, so the translation is simply dropped
+    if (cancellation.IsCancelled()) {
+      Metrics::Increment("abandoned_compiles");
+      return errors::Cancelled("Step cancelled before compiling ", m_name);
+    }
+
     // Evict the cache if the number of elements exceeds the limit
     std::shared_ptr<Executable> evicted_ng_exec;
     const char* cache_depth_specified =
@@ -607,17 +881,24 @@ Status NGraphEncapsulateOp::GetExecutable(
     if (m_ng_exec_map.size() >= m_function_cache_depth_in_items) {
       evicted_ng_exec = m_ng_exec_map[m_lru.back()];
       m_ng_exec_map.erase(m_lru.back());
+      if (m_router != nullptr) m_router->Erase(m_lru.back());
+      ModelResources::RemoveExecutable(m_model, this, m_lru.back());
 
       m_lru.pop_back();
     }  // cache eviction if cache size greater than cache depth
 
+    Timer compile_time;
     try {
-      ng_exec = backend->Compile(ng_function);
+      ng_exec = backend->Compile(
+          ng_function, false,
+          ModelResources::GetPluginConfig(m_model, backend->GetDeviceType()));
     } catch (const std::exception& ex) {
       return errors::Internal("Failed to compile function " + m_name + ": ",
                               ex.what());
     }
 
+    Metrics::Increment("compiled_executables");
+    Metrics::Increment("compile_us", compile_time.ElapsedInMicroSec());
     m_ng_exec_map[signature] = ng_exec;
     ng_exec->SetOutputShapes(ng_output_shapes);
 
@@ -627,6 +908,13 @@ Status NGraphEncapsulateOp::GetExecutable(
     util::MemoryProfile(vm, rss);
     auto delta_vm_mem = vm - vm0;
     auto delta_res_mem = rss - rss0;
+    m_observed_compile_bytes =
+        std::max<int64>(m_observed_compile_bytes, delta_res_mem * 1024);
+    // The function and the loaded network each hold the constants, the
+    // network is only loaded by the first call
+    ModelResources::AddExecutable(
+        m_model, this, signature,
+        std::max<int64>(delta_res_mem * 1024, 2 * m_constant_bytes));
     OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
                  << " Cache length: " << m_ng_exec_map.size()
                  << " Cluster: " << m_name << " Delta VM: " << delta_vm_mem
@@ -641,15 +929,33 @@ Status NGraphEncapsulateOp::GetExecutable(
       m_lru.remove(signature);
       m_lru.push_front(signature);
     }
+    ModelResources::TouchExecutable(m_model, this, signature);
     ng_exec = it->second;
   }
   return Status::OK();
 }
 
-Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
+void NGraphEncapsulateOp::RecordPlacementCall(OpKernelContext* ctx,
+                                              int64 time_us) {
+  if (!PlacementProfile::IsEnabled()) return;
+  std::vector<int64> input_bytes, output_bytes;
+  for (int i = 0; i < ctx->num_inputs(); i++) {
+    input_bytes.push_back(ctx->input(i).TotalBytes());
+  }
+  for (int i = 0; i < ctx->num_outputs(); i++) {
+    output_bytes.push_back(ctx->mutable_output(i)->TotalBytes());
+  }
+  PlacementProfile::RecordClusterCall(m_cluster_id, time_us, input_bytes,
+                                      output_bytes);
+}
+
+Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx, bool permanent) {
+  Timer fallback_time;
   OVTF_VLOG(1) << "Cluster " << name() << " fallback to native TF runtime ";
-  if (!NGraphClusterManager::CheckClusterFallback(m_cluster_id)) {
+  if (permanent) {
     NGraphClusterManager::SetClusterFallback(m_cluster_id, true);
+  }
+  if (m_session == nullptr) {
     GraphDef* graph_def = NGraphClusterManager::GetClusterGraph(m_cluster_id);
     SessionOptions options;
     std::shared_ptr<tensorflow::Session> session(
@@ -743,6 +1049,7 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
 #endif
     }
   }
+  RecordPlacementCall(ctx, fallback_time.ElapsedInMicroSec());
   return Status::OK();
 }
 
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <mutex>
+
 #include "tensorflow/core/graph/graph.h"
 
 #include "api.h"
@@ -67,6 +69,65 @@ static inline void SetStaticInputs(Node* n, std::vector<int32> inputs) {
 #endif
 }
 
+// Returns true if the index-th input of n is a Const integer tensor without -1
+static bool InputIsConstWithoutMinusOne(const Node* n, int index) {
+  const Node* input_node;
+  if (n->input_node(index, &input_node) != Status::OK() ||
+      input_node->type_string() != "Const") {
+    return false;
+  }
+  Tensor value;
+  if (GetNodeAttr(input_node->attrs(), "value", &value) != Status::OK()) {
+    return false;
+  }
+  for (int64 i = 0; i < value.NumElements(); i++) {
+    if ((value.dtype() == DT_INT32 && value.flat<int32>()(i) == -1) ||
+        (value.dtype() == DT_INT64 && value.flat<int64>()(i) == -1)) {
+      return false;
+    }
+  }
+  return value.dtype() == DT_INT32 || value.dtype() == DT_INT64;
+}
+
+// Capability table of the static inputs that the builder can also translate
+// as runtime parameters, so that a new value reuses the executable compiled
+// for the previous one instead of being part of the signature. The Inference
+// Engine only runs networks of static shape, so an input qualifies only when
+// the output shape of the op does not depend on its value; the condition
+// checks this for a given node. The target shape of Reshape, the multiples of
+// Tile and the paddings of Pad always determine the output shape and are
+// therefore not listed.
+using RuntimeInputCondition = std::function<bool(const Node*)>;
+static const std::map<std::string, std::map<int32, RuntimeInputCondition>>&
+GetRuntimeInputCapabilities() {
+  static const std::map<std::string, std::map<int32, RuntimeInputCondition>>
+      capabilities{
+          // The begin of a Slice only moves the window, as long as the size
+          // of the window is known
+          {"Slice",
+           {{1,
+             [](const Node* n) { return InputIsConstWithoutMinusOne(n, 2); }}}},
+      };
+  return capabilities;
+}
+
+static bool InputCanBeRuntimeValued(const Node* n, int32 index) {
+  if (util::GetEnv("OPENVINO_TF_DYNAMIC_STATIC_INPUTS") != "1") {
+    return false;
+  }
+  auto op_it = GetRuntimeInputCapabilities().find(n->type_string());
+  if (op_it == GetRuntimeInputCapabilities().end()) return false;
+  auto input_it = op_it->second.find(index);
+  if (input_it == op_it->second.end()) return false;
+  // Constant values are folded into the function as before
+  const Node* input_node;
+  if (n->input_node(index, &input_node) != Status::OK() ||
+      input_node->type_string() == "Const") {
+    return false;
+  }
+  return input_it->second(n);
+}
+
 // Marks the input indices given in static_input_indices as static, i.e., inputs
 // that must be driven either by an _Arg or by a Const in the encapsulated
 // graph (meaning that its value must be known at translation-to-nGraph time). A
@@ -79,6 +140,17 @@ static SetAttributesFunction SetStaticInputs(
     auto indices = static_input_indices;
     std::transform(indices.begin(), indices.end(), indices.begin(),
                    [n](int x) { return x >= 0 ? x : n->num_inputs() + x; });
+    indices.erase(std::remove_if(indices.begin(), indices.end(),
+                                 [n](int32 x) {
+                                   if (!InputCanBeRuntimeValued(n, x)) {
+                                     return false;
+                                   }
+                                   OVTF_VLOG(3) << "Input " << x << " of "
+                                                << n->name()
+                                                << " is fed at runtime";
+                                   return true;
+                                 }),
+                  indices.end());
     SetStaticInputs(n, indices);
     return Status::OK();
   };
@@ -129,9 +201,11 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
   //
 
   static std::map<std::string, SetAttributesFunction> set_attributes_map;
-  static bool initialized = false;
+  // The rewrite passes of concurrently created sessions may get here first
+  // at the same time
+  static std::once_flag initialized;
 
-  if (!initialized) {
+  std::call_once(initialized, []() {
     // Set Additional Attributes (if any)
     set_attributes_map["Any"] = SetStaticInputs({1});
     set_attributes_map["All"] = SetStaticInputs({1});
@@ -140,7 +214,7 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["BatchToSpaceND"] = SetStaticInputs({1});
     set_attributes_map["ConcatV2"] = SetStaticInputs({-1});
     set_attributes_map["Conv2DBackpropInput"] = SetStaticInputs({0});
-    set_attributes_map["CropAndResize"] = SetStaticInputs({1, 2, 3});
+    set_attributes_map["CropAndResize"] = SetStaticInputs({3});
     set_attributes_map["ExpandDims"] = SetStaticInputs({1});
     set_attributes_map["Fill"] = SetStaticInputs({0});
     set_attributes_map["GatherV2"] = SetStaticInputs({2});
@@ -165,8 +239,7 @@ const std::map<std::string, SetAttributesFunction>& GetAttributeSetters() {
     set_attributes_map["TopKV2"] = SetStaticInputs({1});
     set_attributes_map["Tile"] = SetStaticInputs({1});
     set_attributes_map["Range"] = SetStaticInputs({0, 1, 2});
-    initialized = true;
-  }
+  });
   return set_attributes_map;
 }
 
@@ -323,7 +396,12 @@ GetTFToNgOpMap() {
           {"Sinh", {std::make_shared<opset::Sinh>()}},
           {"Size", {constant}},
           {"Sign", {std::make_shared<opset::Sign>()}},
-          {"Slice", {constant, std::make_shared<opset::StridedSlice>()}},
+          {"Slice",
+           {constant, std::make_shared<opset::StridedSlice>(),
+            std::make_shared<opset::Gather>(), std::make_shared<opset::Add>(),
+            std::make_shared<opset::Convert>(),
+            std::make_shared<opset::Minimum>(),
+            std::make_shared<opset::Maximum>()}},
           {"Snapshot", {}},
           {"Softmax", {std::make_shared<opset::Softmax>()}},
           {"Softplus", {std::make_shared<opset::SoftPlus>()}},
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/model_resources.h"
+#include "openvino_tensorflow/ovtf_timer.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex ModelResources::s_mutex;
+std::condition_variable ModelResources::s_cv;
+std::map<std::string, ModelResources::Model> ModelResources::s_models;
+
+ModelResources::CompileSlot::~CompileSlot() {
+  ModelResources::ReleaseCompile(m_model);
+}
+
+static int64 ParseInt(const string& value) {
+  return value.empty() ? 0 : max<int64>(0, atoll(value.c_str()));
+}
+
+ModelResources::Quotas ModelResources::GetDefaultQuotas() {
+  Quotas quotas;
+  quotas.max_cache_bytes =
+      ParseInt(util::GetEnv("OPENVINO_TF_MODEL_MAX_CACHE_MB")) * 1024 * 1024;
+  quotas.max_concurrent_compiles =
+      ParseInt(util::GetEnv("OPENVINO_TF_MODEL_MAX_CONCURRENT_COMPILES"));
+  quotas.max_threads_per_network =
+      ParseInt(util::GetEnv("OPENVINO_TF_MODEL_MAX_THREADS_PER_NETWORK"));
+  return quotas;
+}
+
+ModelResources::Quotas ModelResources::ParseQuotas(
+    const unordered_map<string, string>& attributes, const Quotas& defaults) {
+  Quotas quotas = defaults;
+  auto it = attributes.find("max_cache_mb");
+  if (it != attributes.end()) {
+    quotas.max_cache_bytes = ParseInt(it->second) * 1024 * 1024;
+  }
+  it = attributes.find("max_concurrent_compiles");
+  if (it != attributes.end()) {
+    quotas.max_concurrent_compiles = ParseInt(it->second);
+  }
+  it = attributes.find("max_threads_per_network");
+  if (it != attributes.end()) {
+    quotas.max_threads_per_network = ParseInt(it->second);
+  }
+  return quotas;
+}
+
+string ModelResources::GetModelName(
+    const unordered_map<string, string>& attributes, int graph_id) {
+  auto it = attributes.find("model_tag");
+  if (it != attributes.end() && !it->second.empty()) return it->second;
+  return "graph_" + to_string(graph_id);
+}
+
+ModelResources::Model& ModelResources::GetModel(const string& model) {
+  auto it = s_models.find(model);
+  if (it == s_models.end()) {
+    it = s_models.emplace(model, Model()).first;
+    it->second.quotas = GetDefaultQuotas();
+  }
+  return it->second;
+}
+
+void ModelResources::SetQuotas(const string& model, const Quotas& quotas) {
+  lock_guard<mutex> lock(s_mutex);
+  GetModel(model).quotas = quotas;
+  // A raised compile quota may admit waiting compiles
+  s_cv.notify_all();
+}
+
+ModelResources::Quotas ModelResources::GetQuotas(const string& model) {
+  lock_guard<mutex> lock(s_mutex);
+  return GetModel(model).quotas;
+}
+
+void ModelResources::StartCompile(Model& model) {
+  model.running_compiles++;
+  model.counters["compiles"]++;
+}
+
+unique_ptr<ModelResources::CompileSlot> ModelResources::TryAdmitCompile(
+    const string& model) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  int max_compiles = m.quotas.max_concurrent_compiles;
+  if (max_compiles > 0 && m.running_compiles >= max_compiles) {
+    return nullptr;
+  }
+  StartCompile(m);
+  return unique_ptr<CompileSlot>(new CompileSlot(model));
+}
+
+unique_ptr<ModelResources::CompileSlot> ModelResources::AdmitCompile(
+    const string& model, const function<bool()>& cancelled) {
+  Timer wait_time;
+  unique_lock<mutex> lock(s_mutex);
+  bool waited = false;
+  while (true) {
+    // Looked up on each iteration, since Reset() may drop the model
+    auto& m = GetModel(model);
+    int max_compiles = m.quotas.max_concurrent_compiles;
+    if (max_compiles == 0 || m.running_compiles < max_compiles) {
+      StartCompile(m);
+      if (waited) {
+        int64 wait_us = wait_time.ElapsedInMicroSec();
+        m.counters["compile_waits"]++;
+        m.counters["compile_wait_us"] += wait_us;
+        OVTF_VLOG(1) << "Compile of model " << model << " admitted after "
+                     << wait_us << " us";
+      }
+      return unique_ptr<CompileSlot>(new CompileSlot(model));
+    }
+    if (cancelled()) {
+      m.counters["compiles_abandoned"]++;
+      return nullptr;
+    }
+    waited = true;
+    // Woken up by a released slot; the timeout polls for cancellation
+    s_cv.wait_for(lock, chrono::milliseconds(10));
+  }
+}
+
+void ModelResources::ReleaseCompile(const string& model) {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    auto& m = GetModel(model);
+    m.running_compiles = max(0, m.running_compiles - 1);
+  }
+  s_cv.notify_all();
+}
+
+list<ModelResources::CacheEntry>::iterator ModelResources::FindEntry(
+    Model& model, const void* owner, const string& key) {
+  auto it = model.cache_index.find({owner, key});
+  return it == model.cache_index.end() ? model.cache.end() : it->second;
+}
+
+void ModelResources::EraseEntry(Model& model,
+                                list<CacheEntry>::iterator entry) {
+  model.counters["cache_bytes"] -= entry->bytes;
+  model.counters["executables"]--;
+  model.cache_index.erase({entry->owner, entry->key});
+  model.cache.erase(entry);
+}
+
+void ModelResources::AddExecutable(const string& model, const void* owner,
+                                   const string& key, int64 bytes) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  auto it = FindEntry(m, owner, key);
+  if (it != m.cache.end()) EraseEntry(m, it);
+  m.cache.push_front({owner, key, bytes});
+  m.cache_index[{owner, key}] = m.cache.begin();
+  m.counters["cache_bytes"] += bytes;
+  m.counters["executables"]++;
+  m.counters["cache_peak_bytes"] =
+      max(m.counters["cache_peak_bytes"], m.counters["cache_bytes"]);
+
+  int64 quota = m.quotas.max_cache_bytes;
+  while (quota > 0 && m.counters["cache_bytes"] > quota &&
+         m.cache.size() > 1) {
+    auto victim = prev(m.cache.end());
+    OVTF_VLOG(1) << "Evicting an executable of model " << model
+                 << " to stay within its cache quota of " << quota
+                 << " bytes";
+    m.evicted[victim->owner].push_back(victim->key);
+    m.counters["quota_evictions"]++;
+    EraseEntry(m, victim);
+  }
+}
+
+void ModelResources::TouchExecutable(const string& model, const void* owner,
+                                     const string& key) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  auto it = FindEntry(m, owner, key);
+  if (it != m.cache.end() && it != m.cache.begin()) {
+    m.cache.splice(m.cache.begin(), m.cache, it);
+  }
+}
+
+void ModelResources::RemoveExecutable(const string& model, const void* owner,
+                                      const string& key) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  auto it = FindEntry(m, owner, key);
+  if (it != m.cache.end()) EraseEntry(m, it);
+}
+
+void ModelResources::RemoveOwner(const string& model, const void* owner) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  for (auto it = m.cache.begin(); it != m.cache.end();) {
+    auto entry = it++;
+    if (entry->owner == owner) EraseEntry(m, entry);
+  }
+  m.evicted.erase(owner);
+}
+
+vector<string> ModelResources::TakeEvicted(const string& model,
+                                           const void* owner) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  auto it = m.evicted.find(owner);
+  if (it == m.evicted.end()) return {};
+  auto keys = move(it->second);
+  m.evicted.erase(it);
+  return keys;
+}
+
+map<string, string> ModelResources::GetPluginConfig(const string& model,
+                                                    const string& device) {
+  map<string, string> config;
+  int max_threads = GetQuotas(model).max_threads_per_network;
+  if (max_threads > 0 && device == "CPU") {
+    config["CPU_THREADS_NUM"] = to_string(max_threads);
+  }
+  return config;
+}
+
+void ModelResources::RecordCall(const string& model, int64 time_us) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& m = GetModel(model);
+  m.counters["calls"]++;
+  m.counters["call_us"] += time_us;
+}
+
+map<string, map<string, int64>> ModelResources::GetUsage() {
+  lock_guard<mutex> lock(s_mutex);
+  map<string, map<string, int64>> usage;
+  for (const auto& it : s_models) {
+    const auto& m = it.second;
+    auto& counters = usage[it.first];
+    counters = m.counters;
+    counters["running_compiles"] = m.running_compiles;
+    counters["quota_cache_bytes"] = m.quotas.max_cache_bytes;
+    counters["quota_concurrent_compiles"] = m.quotas.max_concurrent_compiles;
+    counters["quota_threads_per_network"] = m.quotas.max_threads_per_network;
+  }
+  return usage;
+}
+
+void ModelResources::Dump(string& usage) {
+  stringstream ss;
+  for (const auto& model : GetUsage()) {
+    for (const auto& counter : model.second) {
+      ss << model.first << "\t" << counter.first << " " << counter.second
+         << "\n";
+    }
+  }
+  usage = ss.str();
+}
+
+void ModelResources::Reset() {
+  {
+    lock_guard<mutex> lock(s_mutex);
+    s_models.clear();
+  }
+  s_cv.notify_all();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
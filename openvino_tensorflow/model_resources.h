@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_MODEL_RESOURCES_H_
+#define OPENVINO_TF_MODEL_RESOURCES_H_
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Groups the resources used by the executables of each model, so that the
+// models sharing a process can be isolated from each other. A model is a
+// graph rewritten by openvino_tensorflow, or the graphs sharing the tag given
+// by the "model_tag" parameter of the ovtf-optimizer. Each model can have
+// quotas on the estimated bytes of its cached executables, on its concurrent
+// compiles and on the threads of each of its networks. The usage of each
+// model can be read from Python with openvino_tensorflow.get_model_usage().
+class ModelResources {
+ public:
+  // 0 means unlimited
+  struct Quotas {
+    int64 max_cache_bytes = 0;
+    int max_concurrent_compiles = 0;
+    // Applies to each network of the model on its own, a model running N
+    // networks at once may use N times as many threads
+    int max_threads_per_network = 0;
+  };
+
+  // Holds a compile slot of a model until destroyed
+  class CompileSlot {
+   public:
+    ~CompileSlot();
+
+   private:
+    friend class ModelResources;
+    explicit CompileSlot(const std::string& model) : m_model(model) {}
+    std::string m_model;
+  };
+
+  // Quotas set with OPENVINO_TF_MODEL_MAX_CACHE_MB,
+  // OPENVINO_TF_MODEL_MAX_CONCURRENT_COMPILES and
+  // OPENVINO_TF_MODEL_MAX_THREADS_PER_NETWORK
+  static Quotas GetDefaultQuotas();
+  // Overrides defaults with the "max_cache_mb", "max_concurrent_compiles" and
+  // "max_threads_per_network" entries of the attributes of an encapsulate op
+  static Quotas ParseQuotas(
+      const std::unordered_map<std::string, std::string>& attributes,
+      const Quotas& defaults);
+  // Model of an encapsulate op: its "model_tag" attribute, or its graph
+  static std::string GetModelName(
+      const std::unordered_map<std::string, std::string>& attributes,
+      int graph_id);
+
+  // Registers a model or updates its quotas
+  static void SetQuotas(const std::string& model, const Quotas& quotas);
+  static Quotas GetQuotas(const std::string& model);
+
+  // Returns a slot if the model can start a compile right away, nullptr
+  // otherwise. A model without compile quota always gets one.
+  static std::unique_ptr<CompileSlot> TryAdmitCompile(const std::string& model);
+  // Waits for a compile slot of the model. Returns nullptr if cancelled
+  // returns true while waiting.
+  static std::unique_ptr<CompileSlot> AdmitCompile(
+      const std::string& model, const std::function<bool()>& cancelled);
+
+  // Records an executable cached by owner under key. If the cached
+  // executables of the model exceed its quota, the least recently used ones
+  // other than this one are evicted: they are no longer counted, and their
+  // owners drop them on their next TakeEvicted(), so that their memory is
+  // only released by the next call of each owner.
+  static void AddExecutable(const std::string& model, const void* owner,
+                            const std::string& key, int64 bytes);
+  // Marks an executable as used
+  static void TouchExecutable(const std::string& model, const void* owner,
+                              const std::string& key);
+  // Forgets an executable evicted by its owner
+  static void RemoveExecutable(const std::string& model, const void* owner,
+                               const std::string& key);
+  // Forgets all the executables of owner
+  static void RemoveOwner(const std::string& model, const void* owner);
+  // Returns the keys of the executables of owner evicted for the quota of
+  // the model since the last call
+  static std::vector<std::string> TakeEvicted(const std::string& model,
+                                              const void* owner);
+
+  // Plugin configuration applying the per-network thread quota of the model
+  // on device
+  static std::map<std::string, std::string> GetPluginConfig(
+      const std::string& model, const std::string& device);
+
+  static void RecordCall(const std::string& model, int64 time_us);
+
+  // Counters of each model, e.g. "cache_bytes" or "compile_waits"
+  static std::map<std::string, std::map<std::string, int64>> GetUsage();
+  // Writes one "<model>\t<counter> <value>" line per counter
+  static void Dump(std::string& usage);
+  // Forgets the models and their usage
+  static void Reset();
+
+ private:
+  struct CacheEntry {
+    const void* owner;
+    std::string key;
+    int64 bytes;
+  };
+  struct Model {
+    Quotas quotas;
+    // Most recently used first
+    std::list<CacheEntry> cache;
+    std::map<std::pair<const void*, std::string>,
+             std::list<CacheEntry>::iterator>
+        cache_index;
+    std::map<const void*, std::vector<std::string>> evicted;
+    int running_compiles = 0;
+    std::map<std::string, int64> counters;
+  };
+
+  // Requires s_mutex
+  static Model& GetModel(const std::string& model);
+  static std::list<CacheEntry>::iterator FindEntry(Model& model,
+                                                   const void* owner,
+                                                   const std::string& key);
+  static void EraseEntry(Model& model, std::list<CacheEntry>::iterator entry);
+  static void StartCompile(Model& model);
+  static void ReleaseCompile(const std::string& model);
+
+  static std::mutex s_mutex;
+  static std::condition_variable s_cv;
+  static std::map<std::string, Model> s_models;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_MODEL_RESOURCES_H_
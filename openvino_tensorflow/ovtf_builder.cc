@@ -4,6 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <mutex>
+#include <numeric>
+#include <unordered_set>
+
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
@@ -24,7 +28,10 @@
 #include "openvino_tensorflow/layout_conversions.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_timer.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/pass/simplify.h"
 #include "openvino_tensorflow/pass/transpose_sinking.h"
 
 using tensorflow::int32;
@@ -73,35 +80,52 @@ static Status CheckAxisDimInRange(std::vector<int64> axes, size_t rank) {
 //
 // Helper for storing ops in ng_op_map.
 // For most of the cases, op would have one output so
-// vector ng_op_map[op_name] would contain one element.
+// vector ng_op_map[op->id()] would contain one element.
 //
 // If storing more than one output_nodes, make sure it's in
 // the same order as tensorflow would do that.
 //
 // Parameters:
 //    Builder::OpMap& ng_op_map        - The TF-to-nGraph op map.
-//    std::string op_name              - Name of the op.
+//    const Node* op                   - TF op being translated.
 //
 //    ng::Output<ng::Node> output_node - ng::Node to store
 //
 
-static void SaveNgOp(Builder::OpMap& ng_op_map, const std::string& op_name,
+static void SaveNgOp(Builder::OpMap& ng_op_map, const Node* op,
                      ng::Output<ng::Node> output_node) {
-  // no need to try-catch, map[key] will create vector object
-  // if not exists
-  ng_op_map[op_name].push_back(output_node);
+  ng_op_map[op->id()].push_back(output_node);
 }
 
-void Builder::SetTracingInfo(const std::string& op_name,
-                             const ng::Output<ng::Node> ng_node) {
-  auto node = ng_node.get_node_shared_ptr();
+// Nodes waiting for their tracing info while a graph is being translated.
+// The tracing info is only attached to the nodes which end up in the
+// translated function, since the translation helpers create many nodes that
+// are discarded right away.
+static thread_local std::vector<
+    std::pair<std::shared_ptr<ng::Node>, std::string>>* s_pending_tracing_info =
+    nullptr;
+
+static void AttachTracingInfo(const std::string& op_name,
+                              const std::shared_ptr<ng::Node>& node,
+                              bool log_placement) {
   node->set_friendly_name(op_name + "/" + node->get_name());
   node->add_provenance_tag(op_name);
-  if (api::IsLoggingPlacement()) {
+  if (log_placement) {
     cout << "TF_to_NG: " << op_name << " --> " << node << endl;
   }
 }
 
+void Builder::SetTracingInfo(const std::string& op_name,
+                             const ng::Output<ng::Node> ng_node) {
+  if (s_pending_tracing_info != nullptr) {
+    s_pending_tracing_info->emplace_back(ng_node.get_node_shared_ptr(),
+                                         op_name);
+    return;
+  }
+  AttachTracingInfo(op_name, ng_node.get_node_shared_ptr(),
+                    api::IsLoggingPlacement());
+}
+
 template <class TOpType, class... TArg>
 ng::Output<ng::Node> ConstructNgNode(const std::string& op_name,
                                      TArg&&... Args) {
@@ -148,30 +172,25 @@ static Status GetInputNode(const Builder::OpMap& ng_op_map, const Node* op,
                            size_t input_idx, ng::Output<ng::Node>& result) {
   // input op may have resulted in more than one ng::Node (eg. Split)
   // we need to look at Edge to check index of the input op
-  std::vector<const Edge*> edges;
-  TF_RETURN_IF_ERROR(op->input_edges(&edges));
-  size_t src_output_idx;
-  try {
-    src_output_idx = edges.at(input_idx)->src_output();
-  } catch (const out_of_range&) {
+  const Edge* edge;
+  if (input_idx >= static_cast<size_t>(op->num_inputs()) ||
+      op->input_edge(input_idx, &edge) != Status::OK()) {
     return Status(error::NOT_FOUND, "Edge not found");
   }
+  size_t src_output_idx = edge->src_output();
 
-  Node* tf_input;
-  TF_RETURN_IF_ERROR(op->input_node(input_idx, &tf_input));
-  std::vector<ng::Output<ng::Node>> ng_op;
-  try {
-    ng_op = ng_op_map.at(tf_input->name());
-  } catch (const out_of_range&) {
+  const Node* tf_input = edge->src();
+  if (tf_input->id() >= static_cast<int>(ng_op_map.size()) ||
+      ng_op_map[tf_input->id()].empty()) {
     return Status(error::NOT_FOUND,
                   string("Ngraph op not found for ") + tf_input->name());
   }
-  try {
-    result = ng_op.at(src_output_idx);
-  } catch (const out_of_range&) {
+  const auto& ng_op = ng_op_map[tf_input->id()];
+  if (src_output_idx >= ng_op.size()) {
     return Status(error::NOT_FOUND, string("Input node not found at index ") +
                                         to_string(src_output_idx));
   }
+  result = ng_op[src_output_idx];
   return Status::OK();
 }
 
@@ -551,7 +570,7 @@ static Status TranslateUnaryOp(
   if (ng_node != ng_input) {
     Builder::SetTracingInfo(op->name(), ng_node);
   }
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -612,7 +631,7 @@ static Status TranslateBinaryOp(
   if (ng_node != ng_lhs && ng_node != ng_rhs) {
     Builder::SetTracingInfo(op->name(), ng_node);
   }
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -652,7 +671,7 @@ static Status TranslateAddNOp(const Node* op, const std::vector<const Tensor*>&,
       });  // accumulation: start with
            // first element. default op is
            // addition
-  SaveNgOp(ng_op_map, op->name(), ng_addn);
+  SaveNgOp(ng_op_map, op, ng_addn);
   return Status::OK();
 }
 static Status TranslateArgMinMax(
@@ -699,7 +718,7 @@ static Status TranslateArgMinMax(
   auto reshaped_indices =
       ConstructNgNode<opset::Squeeze>(op->name(), ng_indices, axis_to_remove);
   Builder::SetTracingInfo(op->name(), reshaped_indices);
-  SaveNgOp(ng_op_map, op->name(), reshaped_indices);
+  SaveNgOp(ng_op_map, op, reshaped_indices);
   return Status::OK();
 }
 
@@ -771,7 +790,7 @@ static Status TranslateAvgPoolOp(const Node* op,
   OVTF_VLOG(3) << "avgpool outshape: {" << ng::join(ng_avgpool.get_shape())
                << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_avgpool);
+  SaveNgOp(ng_op_map, op, ng_avgpool);
   return Status::OK();
 }
 
@@ -797,7 +816,7 @@ static Status TranslateBatchNDAndSpaceNDOp(
 
   // return with input if rank < 2 as ngraph's impl doesn't support it
   if (N < 2) {
-    SaveNgOp(ng_op_map, op->name(), ng_input);
+    SaveNgOp(ng_op_map, op, ng_input);
     return Status::OK();
   }
 
@@ -839,11 +858,11 @@ static Status TranslateBatchNDAndSpaceNDOp(
   if (op->type_string() == "BatchToSpaceND") {
     auto ng_batch_to_space_nd = ConstructNgNode<opset::BatchToSpace>(
         op->name(), ng_input, block_shape, crops_begin, crops_end);
-    SaveNgOp(ng_op_map, op->name(), ng_batch_to_space_nd);
+    SaveNgOp(ng_op_map, op, ng_batch_to_space_nd);
   } else if (op->type_string() == "SpaceToBatchND") {
     auto ng_space_to_batch_nd = ConstructNgNode<opset::SpaceToBatch>(
         op->name(), ng_input, block_shape, crops_begin, crops_end);
-    SaveNgOp(ng_op_map, op->name(), ng_space_to_batch_nd);
+    SaveNgOp(ng_op_map, op, ng_space_to_batch_nd);
   } else {
     return errors::Unknown("Unknown Op Name: ", op->name());
   }
@@ -897,7 +916,7 @@ static Status TranslateBiasAddOp(
   ng::Output<ng::Node> ng_add =
       ConstructNgNode<opset::Add>(op->name(), ng_input, ng_bias_reshaped);
 
-  SaveNgOp(ng_op_map, op->name(), ng_add);
+  SaveNgOp(ng_op_map, op, ng_add);
   return Status::OK();
 }
 
@@ -913,7 +932,7 @@ static Status TranslateCastOp(const Node* op, const std::vector<const Tensor*>&,
   TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(dtype, &ng_et));
 
   try {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Convert>(op->name(), ng_input, ng_et));
   } catch (const std::out_of_range&) {
     return errors::Unimplemented("Failed to convert TF data type: ",
@@ -949,7 +968,7 @@ static Status TranslateConcatV2Op(
   }
 
   SaveNgOp(
-      ng_op_map, op->name(),
+      ng_op_map, op,
       ConstructNgNode<opset::Concat>(op->name(), ng_args, size_t(concat_axis)));
   return Status::OK();
 }
@@ -980,7 +999,7 @@ static Status TranslateConstOp(const Node* op,
                                  DataType_Name(dtype));
   }
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -1072,7 +1091,7 @@ static Status TranslateConv2DOp(const Node* op,
       ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_nhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1165,7 +1184,7 @@ static Status TranslateConv2DBackpropInputOp(
       ng_padding_below, ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_nhwc, ng_data);
-  SaveNgOp(ng_op_map, op->name(), ng_data);
+  SaveNgOp(ng_op_map, op, ng_data);
   return Status::OK();
 }
 
@@ -1240,7 +1259,7 @@ static Status TranslateConv3DOp(const Node* op,
       ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_ndhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1336,25 +1355,27 @@ static Status TranslateConv3DBackpropInputV2Op(
       ng_padding_below, ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_ndhwc, ng_data);
-  SaveNgOp(ng_op_map, op->name(), ng_data);
+  SaveNgOp(ng_op_map, op, ng_data);
   return Status::OK();
 }
 
+// Translates CropAndResize as a sampler that reads the boxes and the box
+// indices as runtime values, so that new boxes reuse the executable and the
+// function does not grow with their number. Only the crop size must be
+// static. The rows sampled in box b are
+//   in_y[b, i] = y1[b] * (H - 1) + i * (y2[b] - y1[b]) * (H - 1) / (ch - 1)
+// (the center of the box when ch == 1), and likewise the columns. The image
+// is flattened to [batch * H * W, depth] so that the pixels at a corner of all
+// the sampling points are a single Gather.
 static Status TranslateCropAndResizeOp(
     const Node* op, const std::vector<const Tensor*>& static_input_map,
     Builder::OpMap& ng_op_map) {
   /// ng_input: [batch, image_height, image_width, depth]
   /// ng_boxes: [num_boxes, 4]; each box is a normalized [0.to 1.] co-ordinate
-  /// [y1,
-  /// x1, y2, x2]
+  /// [y1, x1, y2, x2]
   /// ng_box_ind: [num_boxes]; i-th ng_box_ind refers to the image to crop and
   /// ranges from 0 to batch
   /// ng_crop_size: [crop_height, crop_width];
-
-  /// for each box b specified in ng_boxes:
-  ///  1. crop ng_input[ng_box_ind[b]] w/ co-ordinates in ng_boxes
-  ///  2. resize according to method
-
   ng::Output<ng::Node> ng_input, ng_boxes, ng_box_ind, ng_size;
   TF_RETURN_IF_ERROR(
       GetInputNodes(ng_op_map, op, ng_input, ng_boxes, ng_box_ind, ng_size));
@@ -1364,107 +1385,192 @@ static Status TranslateCropAndResizeOp(
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "method", &tf_resize_method));
   TF_RETURN_IF_ERROR(
       GetNodeAttr(op->attrs(), "extrapolation_value", &tf_extrapolation_value));
-
-  auto spatial_shape = ng_input.get_shape();
-  auto image_height = spatial_shape[1];
-  auto image_width = spatial_shape[2];
-  auto image_depth = spatial_shape[3];
-
-  std::vector<float> boxes;
-  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &boxes));
-
-  std::vector<int64> box_ind;
-  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 2, static_input_map, &box_ind));
+  if (tf_resize_method != "bilinear" && tf_resize_method != "nearest") {
+    return errors::Unimplemented("CropAndResize method ", tf_resize_method,
+                                 " is not supported");
+  }
 
   std::vector<int64> crop_size;
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 3, static_input_map, &crop_size));
+  if (crop_size.size() != 2 || crop_size[0] <= 0 || crop_size[1] <= 0) {
+    return errors::InvalidArgument(
+        "CropAndResize crop_size must contain two positive elements");
+  }
+  const size_t crop_height = crop_size[0];
+  const size_t crop_width = crop_size[1];
 
-  ng::OutputVector ng_crop_outputs(box_ind.size());
-  if (box_ind.size() == 0) {
-    SaveNgOp(ng_op_map, op->name(),
+  const auto image_shape = ng_input.get_shape();
+  if (image_shape.size() != 4) {
+    return errors::InvalidArgument("CropAndResize input must be 4-D, got ",
+                                   image_shape.size(), " dimensions");
+  }
+  const size_t batch = image_shape[0];
+  const size_t image_height = image_shape[1];
+  const size_t image_width = image_shape[2];
+  const size_t image_depth = image_shape[3];
+  const size_t num_boxes = ng_boxes.get_shape().at(0);
+
+  if (num_boxes == 0) {
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Constant>(
                  op->name(), ng::element::f32,
-                 ngraph::Shape{0, static_cast<unsigned long>(crop_size.at(0)),
-                               static_cast<unsigned long>(crop_size.at(1)),
-                               image_depth},
+                 ng::Shape{0, crop_height, crop_width, image_depth},
                  std::vector<float>({})));
-  } else {
-    for (int i = 0; i < box_ind.size(); i++) {
-      int y1, x1, y2, x2;
-      y1 = boxes.at(0 + i * 4) * (image_height - 1);
-      x1 = boxes.at(1 + i * 4) * (image_width - 1);
-      y2 = boxes.at(2 + i * 4) * (image_height - 1);
-      x2 = boxes.at(3 + i * 4) * (image_width - 1);
-
-      int crop_height = std::abs(y2 - y1);
-      int crop_width = std::abs(x2 - x1);
-
-      // account for flip crops when y1>y2 or x1>x2 with negative striding
-      int stride_height = 1, stride_width = 1;
-      if (y1 > y2) {
-        y1 = y1 - image_height;
-        y2 = y2 - image_height - 2;
-        stride_height = -1;
-      }
-      if (x1 > x2) {
-        x1 = x1 - image_height;
-        x2 = x2 - image_height - 2;
-        stride_width = -1;
-      }
+    return Status::OK();
+  }
 
-      auto begin = ConstructNgNode<opset::Constant>(
-          op->name(), ng::element::i64, ng::Shape{4},
-          std::vector<int64>({static_cast<int64>(box_ind[i]), y1, x1, 0}));
-      auto end = ConstructNgNode<opset::Constant>(
-          op->name(), ng::element::i64, ng::Shape{4},
-          std::vector<int64>({static_cast<int64>(box_ind[i]) + 1, y2 + 1,
-                              x2 + 1, static_cast<int64>(image_depth + 1)}));
-      auto strides = ConstructNgNode<opset::Constant>(
-          op->name(), ng::element::i64, ng::Shape{4},
-          std::vector<int64>({1, stride_height, stride_width, 1}));
-
-      // crop
-      auto ng_crop = ConstructNgNode<opset::StridedSlice>(
-          op->name(), ng_input, begin, end, strides, std::vector<int64_t>{},
-          std::vector<int64_t>{});
-
-      opset::Interpolate::InterpolateAttrs interpolate_attrs;
-      // always corner aligned
-      interpolate_attrs.coordinate_transformation_mode =
-          opset::Interpolate::CoordinateTransformMode::align_corners;
-
-      // TODO: handle the case when extrapolation value is greatger than 1.0
-      // arguments for resizing
-      auto ng_spatial_shape = ConstructNgNode<opset::Constant>(
-          op->name(), ng::element::i32, ng::Shape{2},
-          std::vector<int32>{crop_height, crop_width});
-      auto ng_input_shape = ConstructNgNode<opset::Convert>(
-          op->name(), ng_spatial_shape, ng::element::f32);
-      auto ng_crop_size = ConstructNgNode<opset::Convert>(op->name(), ng_size,
-                                                          ng::element::f32);
-      auto ng_scales = ConstructNgNode<opset::Divide>(op->name(), ng_crop_size,
-                                                      ng_input_shape);
-      auto ng_axes = ConstructNgNode<opset::Constant>(
-          op->name(), ng::element::i32, ng::Shape{2}, std::vector<int>({2, 3}));
-
-      if (tf_resize_method == "bilinear") {
-        interpolate_attrs.mode = opset::Interpolate::InterpolateMode::linear;
-      } else {  // nearest
-        interpolate_attrs.mode = opset::Interpolate::InterpolateMode::nearest;
-      }
+  if (ng_input.get_element_type() != ng::element::f32) {
+    ng_input =
+        ConstructNgNode<opset::Convert>(op->name(), ng_input, ng::element::f32);
+  }
+  if (ng_boxes.get_element_type() != ng::element::f32) {
+    ng_boxes =
+        ConstructNgNode<opset::Convert>(op->name(), ng_boxes, ng::element::f32);
+  }
+  if (ng_box_ind.get_element_type() != ng::element::i64) {
+    ng_box_ind = ConstructNgNode<opset::Convert>(op->name(), ng_box_ind,
+                                                 ng::element::i64);
+  }
 
-      Transpose<0, 3, 1, 2>(ng_crop);
-      auto ng_output = ConstructNgNode<opset::Interpolate>(
-          op->name(), ng_crop, ng_size, ng_scales, ng_axes, interpolate_attrs);
-      Transpose<0, 2, 3, 1>(ng_output);
-      ng_crop_outputs.at(i) = ng_output;
-    }
+  auto make_shape = [op](const std::vector<int64>& shape) {
+    return ConstructNgNode<opset::Constant>(
+        op->name(), ng::element::i64, ng::Shape{shape.size()}, shape);
+  };
+  auto make_f32 = [op](float value) {
+    return ConstructNgNode<opset::Constant>(
+        op->name(), ng::element::f32, ng::Shape{}, std::vector<float>{value});
+  };
+  auto make_i64 = [op](int64 value) {
+    return ConstructNgNode<opset::Constant>(
+        op->name(), ng::element::i64, ng::Shape{}, std::vector<int64>{value});
+  };
 
-    auto ng_crop_and_resize =
-        ConstructNgNode<opset::Concat>(op->name(), ng_crop_outputs, 0);
+  // [num_boxes, 1] each
+  auto ng_coords =
+      ConstructNgNode<opset::Split>(op->name(), ng_boxes, make_i64(1), 4);
+  auto ng_coord_outputs = ng_coords.get_node()->outputs();
+
+  // The sampling points along one axis, [num_boxes, crop]
+  auto sampling_points = [&](ng::Output<ng::Node> begin,
+                             ng::Output<ng::Node> end, size_t size,
+                             size_t crop) -> ng::Output<ng::Node> {
+    float max_coord = size - 1;
+    if (crop == 1) {
+      auto ng_sum = ConstructNgNode<opset::Add>(op->name(), begin, end);
+      return ConstructNgNode<opset::Multiply>(op->name(), ng_sum,
+                                              make_f32(0.5f * max_coord));
+    }
+    std::vector<float> steps(crop);
+    std::iota(steps.begin(), steps.end(), 0.0f);
+    auto ng_steps = ConstructNgNode<opset::Constant>(
+        op->name(), ng::element::f32, ng::Shape{1, crop}, steps);
+    auto ng_extent = ConstructNgNode<opset::Subtract>(op->name(), end, begin);
+    auto ng_scale = ConstructNgNode<opset::Multiply>(
+        op->name(), ng_extent, make_f32(max_coord / (crop - 1)));
+    auto ng_begin = ConstructNgNode<opset::Multiply>(op->name(), begin,
+                                                     make_f32(max_coord));
+    return ConstructNgNode<opset::Add>(
+        op->name(), ng_begin,
+        ConstructNgNode<opset::Multiply>(op->name(), ng_steps, ng_scale));
+  };
+  auto ng_in_y = sampling_points(ng_coord_outputs[0], ng_coord_outputs[2],
+                                 image_height, crop_height);
+  auto ng_in_x = sampling_points(ng_coord_outputs[1], ng_coord_outputs[3],
+                                 image_width, crop_width);
+
+  // The points outside of the image take the extrapolation value
+  auto in_image = [&](ng::Output<ng::Node> in, size_t size) {
+    return ConstructNgNode<opset::LogicalAnd>(
+        op->name(),
+        ConstructNgNode<opset::GreaterEqual>(op->name(), in, make_f32(0)),
+        ConstructNgNode<opset::LessEqual>(op->name(), in,
+                                          make_f32(size - 1)));
+  };
+  auto ng_valid = ConstructNgNode<opset::LogicalAnd>(
+      op->name(),
+      ConstructNgNode<opset::Reshape>(
+          op->name(), in_image(ng_in_y, image_height),
+          make_shape({(int64)num_boxes, (int64)crop_height, 1, 1}), false),
+      ConstructNgNode<opset::Reshape>(
+          op->name(), in_image(ng_in_x, image_width),
+          make_shape({(int64)num_boxes, 1, (int64)crop_width, 1}), false));
+
+  // Pixel coordinates, clamped to the image so that the points outside of it
+  // still gather a valid pixel before being replaced
+  auto to_index = [&](ng::Output<ng::Node> coord, size_t size) {
+    auto ng_clamped =
+        ConstructNgNode<opset::Clamp>(op->name(), coord, 0.0, size - 1.0);
+    return ConstructNgNode<opset::Convert>(op->name(), ng_clamped,
+                                           ng::element::i64);
+  };
+  auto ng_image = ConstructNgNode<opset::Reshape>(
+      op->name(), ng_input, make_shape({-1, (int64)image_depth}), false);
+  auto ng_box_base = ConstructNgNode<opset::Multiply>(
+      op->name(),
+      ConstructNgNode<opset::Reshape>(
+          op->name(),
+          ConstructNgNode<opset::Clamp>(op->name(), ng_box_ind, 0.0,
+                                        batch - 1.0),
+          make_shape({(int64)num_boxes, 1, 1}), false),
+      make_i64(image_height * image_width));
+  // The pixels at rows y and columns x of every box,
+  // [num_boxes, crop_height, crop_width, depth]
+  auto gather_pixels = [&](ng::Output<ng::Node> y, ng::Output<ng::Node> x) {
+    auto ng_row = ConstructNgNode<opset::Multiply>(
+        op->name(),
+        ConstructNgNode<opset::Reshape>(
+            op->name(), to_index(y, image_height),
+            make_shape({(int64)num_boxes, (int64)crop_height, 1}), false),
+        make_i64(image_width));
+    auto ng_column = ConstructNgNode<opset::Reshape>(
+        op->name(), to_index(x, image_width),
+        make_shape({(int64)num_boxes, 1, (int64)crop_width}), false);
+    auto ng_indices = ConstructNgNode<opset::Add>(
+        op->name(),
+        ConstructNgNode<opset::Add>(op->name(), ng_box_base, ng_row),
+        ng_column);
+    return ConstructNgNode<opset::Gather>(op->name(), ng_image, ng_indices,
+                                          make_i64(0));
+  };
 
-    SaveNgOp(ng_op_map, op->name(), ng_crop_and_resize);
+  ng::Output<ng::Node> ng_crops;
+  if (tf_resize_method == "nearest") {
+    auto round = [&](ng::Output<ng::Node> coord) {
+      return ConstructNgNode<opset::Round>(
+          op->name(), coord, opset::Round::RoundMode::HALF_AWAY_FROM_ZERO);
+    };
+    ng_crops = gather_pixels(round(ng_in_y), round(ng_in_x));
+  } else {
+    auto ng_top = ConstructNgNode<opset::Floor>(op->name(), ng_in_y);
+    auto ng_bottom = ConstructNgNode<opset::Ceiling>(op->name(), ng_in_y);
+    auto ng_left = ConstructNgNode<opset::Floor>(op->name(), ng_in_x);
+    auto ng_right = ConstructNgNode<opset::Ceiling>(op->name(), ng_in_x);
+    auto ng_y_lerp = ConstructNgNode<opset::Reshape>(
+        op->name(),
+        ConstructNgNode<opset::Subtract>(op->name(), ng_in_y, ng_top),
+        make_shape({(int64)num_boxes, (int64)crop_height, 1, 1}), false);
+    auto ng_x_lerp = ConstructNgNode<opset::Reshape>(
+        op->name(),
+        ConstructNgNode<opset::Subtract>(op->name(), ng_in_x, ng_left),
+        make_shape({(int64)num_boxes, 1, (int64)crop_width, 1}), false);
+
+    auto lerp = [&](ng::Output<ng::Node> a, ng::Output<ng::Node> b,
+                    ng::Output<ng::Node> t) {
+      auto ng_delta = ConstructNgNode<opset::Subtract>(op->name(), b, a);
+      return ConstructNgNode<opset::Add>(
+          op->name(), a,
+          ConstructNgNode<opset::Multiply>(op->name(), ng_delta, t));
+    };
+    auto ng_top_row = lerp(gather_pixels(ng_top, ng_left),
+                           gather_pixels(ng_top, ng_right), ng_x_lerp);
+    auto ng_bottom_row = lerp(gather_pixels(ng_bottom, ng_left),
+                              gather_pixels(ng_bottom, ng_right), ng_x_lerp);
+    ng_crops = lerp(ng_top_row, ng_bottom_row, ng_y_lerp);
   }
+
+  SaveNgOp(ng_op_map, op,
+           ConstructNgNode<opset::Select>(op->name(), ng_valid, ng_crops,
+                                          make_f32(tf_extrapolation_value)));
   return Status::OK();
 }
 
@@ -1477,7 +1583,7 @@ static Status TranslateCumsumOp(const Node* op,
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "exclusive", &exclusive));
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "reverse", &reverse));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::CumSum>(op->name(), ng_x, ng_axis, exclusive,
                                           reverse));
   return Status::OK();
@@ -1508,7 +1614,7 @@ static Status TranslateDepthToSpaceOp(const Node* op,
   ng::Output<ng::Node> depth_to_space = ConstructNgNode<opset::DepthToSpace>(
       op->name(), ng_input, ng_mode, block_size);
   NCHWtoNHWC(op->name(), is_nhwc, depth_to_space);
-  SaveNgOp(ng_op_map, op->name(), depth_to_space);
+  SaveNgOp(ng_op_map, op, depth_to_space);
   return Status::OK();
 }
 
@@ -1584,7 +1690,7 @@ static Status TranslateDepthwiseConv2dNativeOp(
       ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_nhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1595,7 +1701,7 @@ static Status TranslateEluOp(const Node* op,
   TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_input));
 
   // No alpha in TF, so default to 1.0
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Elu>(op->name(), ng_input, 1.0));
   return Status::OK();
 }
@@ -1609,7 +1715,7 @@ static Status TranslateExpandDimsOp(
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &dims));
   auto ng_dims = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ngraph::Shape{dims.size()}, dims);
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Unsqueeze>(op->name(), ng_input, ng_dims));
   return Status::OK();
 }
@@ -1686,7 +1792,7 @@ static Status TranslateFakeQuantWithMinMaxVarsOp(
       op->name(), ng_input, min_adj, max_adj, min_adj, max_adj, levels);
   if (ng_input_shape.size() == 4) Transpose<0, 2, 3, 1>(ng_output);
 
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
 
   return Status::OK();
 }
@@ -1698,7 +1804,7 @@ static Status TranslateFillOp(
   // TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_dims, ng_value));
   TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 0, ng_dims));
   TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 1, ng_value));
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Broadcast>(op->name(), ng_value, ng_dims));
   return Status::OK();
 }
@@ -1758,20 +1864,20 @@ static Status TranslateFusedBatchNormOp(
 
     if (activation_mode == "Relu") {
       auto relu_op = ConstructNgNode<opset::Relu>(op->name(), ng_batch_norm);
-      SaveNgOp(ng_op_map, op->name(), relu_op);
+      SaveNgOp(ng_op_map, op, relu_op);
     } else {
       return errors::Unimplemented(
           "Unsupported _FusedBatchNormEx activation mode in " + op->name());
     }
   } else {
-    SaveNgOp(ng_op_map, op->name(), ng_batch_norm);
-    SaveNgOp(ng_op_map, op->name(), ng_mean);
-    SaveNgOp(ng_op_map, op->name(), ng_variance);
-    SaveNgOp(ng_op_map, op->name(), ng_mean);      // reserve_space_1
-    SaveNgOp(ng_op_map, op->name(), ng_variance);  // reserve_space_2
+    SaveNgOp(ng_op_map, op, ng_batch_norm);
+    SaveNgOp(ng_op_map, op, ng_mean);
+    SaveNgOp(ng_op_map, op, ng_variance);
+    SaveNgOp(ng_op_map, op, ng_mean);      // reserve_space_1
+    SaveNgOp(ng_op_map, op, ng_variance);  // reserve_space_2
     if (is_v3) {
       // FusedBatchNormV3 has 6 outputs
-      SaveNgOp(ng_op_map, op->name(), ng_mean);  // reserve_space_3
+      SaveNgOp(ng_op_map, op, ng_mean);  // reserve_space_3
     }
   }
   return Status::OK();
@@ -1808,13 +1914,12 @@ static Status TranslateFusedMatMulOp(const Node* op,
 
   auto ng_add = ConstructNgNode<opset::Add>(op->name(), ng_matmul, ng_bias);
   if (fused_ops.size() == 1) {  // Only fusing BiasAdd
-    SaveNgOp(ng_op_map, op->name(), ng_add);
+    SaveNgOp(ng_op_map, op, ng_add);
   } else if (fused_ops.size() == 2) {  // Also has activation
     if (fused_ops[1] == "Relu") {
-      SaveNgOp(ng_op_map, op->name(),
-               ConstructNgNode<opset::Relu>(op->name(), ng_add));
+      SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Relu>(op->name(), ng_add));
     } else if (fused_ops[1] == "Relu6") {
-      SaveNgOp(ng_op_map, op->name(),
+      SaveNgOp(ng_op_map, op,
                ConstructNgNode<opset::Clamp>(op->name(), ng_add, 0, 6));
     } else {
       return errors::Internal(
@@ -1842,7 +1947,7 @@ static Status TranslateGatherOp(
   auto gather_op = ConstructNgNode<opset::Gather>(op->name(), ng_input,
                                                   ng_input_indices, ng_axis);
 
-  SaveNgOp(ng_op_map, op->name(), gather_op);
+  SaveNgOp(ng_op_map, op, gather_op);
   return Status::OK();
 }
 
@@ -1882,7 +1987,7 @@ static Status TranslateGatherV2Op(
   auto gather_op = ConstructNgNode<opset::Gather>(op->name(), ng_input,
                                                   ng_input_coords, ng_axis);
 
-  SaveNgOp(ng_op_map, op->name(), gather_op);
+  SaveNgOp(ng_op_map, op, gather_op);
   return Status::OK();
 }
 
@@ -1898,7 +2003,7 @@ static Status TranslateGatherNdOp(
   auto gathernd_op = ConstructNgNode<opset::GatherND>(
       op->name(), ng_input, ng_input_indices, batch_dims);
 
-  SaveNgOp(ng_op_map, op->name(), gathernd_op);
+  SaveNgOp(ng_op_map, op, gathernd_op);
   return Status::OK();
 }
 
@@ -2029,12 +2134,12 @@ static Status TranslateFusedConv2DOp(const Node* op,
       auto ng_relu = ConstructNgNode<opset::Relu>(
           op->name() + "_FusedConv2D_Relu", ng_add);
       NCHWtoNHWC(op->name(), is_nhwc, ng_relu);
-      SaveNgOp(ng_op_map, op->name(), ng_relu);
+      SaveNgOp(ng_op_map, op, ng_relu);
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "Relu6"})) {
       auto ng_relu6 = ConstructNgNode<opset::Clamp>(
           op->name() + "_FusedConv2D_Relu6", ng_add, 0, 6);
       NCHWtoNHWC(op->name(), is_nhwc, ng_relu6);
-      SaveNgOp(ng_op_map, op->name(), ng_relu6);
+      SaveNgOp(ng_op_map, op, ng_relu6);
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "LeakyRelu"})) {
       float tf_leakyrelu_alpha;
       TF_RETURN_IF_ERROR(
@@ -2046,7 +2151,7 @@ static Status TranslateFusedConv2DOp(const Node* op,
       auto ng_lrelu = ConstructNgNode<opset::Maximum>(
           op->name() + "_FusedConv2D_LeakyRelu", ng_alphax, ng_add);
       NCHWtoNHWC(op->name(), is_nhwc, ng_lrelu);
-      SaveNgOp(ng_op_map, op->name(), ng_lrelu);
+      SaveNgOp(ng_op_map, op, ng_lrelu);
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "Elu"})) {
       float tf_elu_alpha = 1.0;
       TF_RETURN_IF_ERROR(
@@ -2054,7 +2159,7 @@ static Status TranslateFusedConv2DOp(const Node* op,
       auto ng_elu = ConstructNgNode<opset::Elu>(op->name() + "_FusedConv2D_Elu",
                                                 ng_add, tf_elu_alpha);
       NCHWtoNHWC(op->name(), is_nhwc, ng_elu);
-      SaveNgOp(ng_op_map, op->name(), ng_elu);
+      SaveNgOp(ng_op_map, op, ng_elu);
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "Add", "Relu"})) {
       NHWCtoNCHW(op->name(), is_nhwc, ng_input2);
       auto ng_add2 = ConstructNgNode<opset::Add>(
@@ -2062,14 +2167,14 @@ static Status TranslateFusedConv2DOp(const Node* op,
       auto ng_relu = ConstructNgNode<opset::Relu>(
           op->name() + "_FusedConv2D_Relu", ng_add2);
       NCHWtoNHWC(op->name(), is_nhwc, ng_relu);
-      SaveNgOp(ng_op_map, op->name(), ng_relu);
+      SaveNgOp(ng_op_map, op, ng_relu);
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "Add"})) {
       ng::Output<ng::Node> ng_add_inp;
       // TF_RETURN_IF_ERROR(GetInputNode(ng_op_map, op, 3, ng_add_inp));
       NCHWtoNHWC(op->name(), is_nhwc, ng_add);
       auto ng_out = ConstructNgNode<opset::Add>(
           op->name() + "_FusedConv2D_BiasAdd_Add", ng_add, ng_input2);
-      SaveNgOp(ng_op_map, op->name(), ng_out);
+      SaveNgOp(ng_op_map, op, ng_out);
     } else if (VecStrCmp(fused_ops, {"BiasAdd", "Add", "LeakyRelu"})) {
       NHWCtoNCHW(op->name(), is_nhwc, ng_input2);
       auto ng_add2 = ConstructNgNode<opset::Add>(
@@ -2084,10 +2189,10 @@ static Status TranslateFusedConv2DOp(const Node* op,
       auto ng_alrelu = ConstructNgNode<opset::Maximum>(
           op->name() + "_FusedConv2D_Add_LeakyRelu", ng_alphax, ng_add2);
       NCHWtoNHWC(op->name(), is_nhwc, ng_alrelu);
-      SaveNgOp(ng_op_map, op->name(), ng_alrelu);
+      SaveNgOp(ng_op_map, op, ng_alrelu);
     } else {
       NCHWtoNHWC(op->name(), is_nhwc, ng_add);
-      SaveNgOp(ng_op_map, op->name(), ng_add);
+      SaveNgOp(ng_op_map, op, ng_add);
     }
   } else if (VecStrCmp(fused_ops, {"FusedBatchNorm"}) ||
              VecStrCmp(fused_ops, {"FusedBatchNorm", "Relu"}) ||
@@ -2116,12 +2221,12 @@ static Status TranslateFusedConv2DOp(const Node* op,
       auto ng_relu = ConstructNgNode<opset::Relu>(
           op->name() + "_FusedConv2D_BatchNormRelu", ng_batch_norm);
       NCHWtoNHWC(op->name(), is_nhwc, ng_relu);
-      SaveNgOp(ng_op_map, op->name(), ng_relu);
+      SaveNgOp(ng_op_map, op, ng_relu);
     } else if (VecStrCmp(fused_ops, {"FusedBatchNorm", "Relu6"})) {
       auto ng_relu6 = ConstructNgNode<opset::Clamp>(
           op->name() + "_FusedConv2D_BatchNormRelu", ng_batch_norm, 0, 6);
       NCHWtoNHWC(op->name(), is_nhwc, ng_relu6);
-      SaveNgOp(ng_op_map, op->name(), ng_relu6);
+      SaveNgOp(ng_op_map, op, ng_relu6);
     } else if (VecStrCmp(fused_ops, {"FusedBatchNorm", "LeakyRelu"})) {
       float tf_leakyrelu_alpha;
       TF_RETURN_IF_ERROR(
@@ -2134,10 +2239,10 @@ static Status TranslateFusedConv2DOp(const Node* op,
           op->name() + "_FusedConv2D_BatchNormLeakyRelu", ng_alphax,
           ng_batch_norm);
       NCHWtoNHWC(op->name(), is_nhwc, ng_lrelu);
-      SaveNgOp(ng_op_map, op->name(), ng_lrelu);
+      SaveNgOp(ng_op_map, op, ng_lrelu);
     } else {
       NCHWtoNHWC(op->name(), is_nhwc, ng_batch_norm);
-      SaveNgOp(ng_op_map, op->name(), ng_batch_norm);
+      SaveNgOp(ng_op_map, op, ng_batch_norm);
     }
   } else {
     return errors::Unimplemented("Unsupported _FusedConv2D " +
@@ -2268,10 +2373,10 @@ static Status TranslateFusedDepthwiseConv2dNativeOp(
       auto ng_relu6 = ConstructNgNode<opset::Clamp>(
           op->name() + "_FusedDepthwiseConv2dNative_Relu6", ng_add, 0, 6);
       NCHWtoNHWC(op->name(), is_nhwc, ng_relu6);
-      SaveNgOp(ng_op_map, op->name(), ng_relu6);
+      SaveNgOp(ng_op_map, op, ng_relu6);
     } else {
       NCHWtoNHWC(op->name(), is_nhwc, ng_add);
-      SaveNgOp(ng_op_map, op->name(), ng_add);
+      SaveNgOp(ng_op_map, op, ng_add);
     }
   } else {
     return errors::Unimplemented("Unsupported _FusedDepthwiseConv2dNative " +
@@ -2285,7 +2390,7 @@ static Status TranslateIdentityOp(const Node* op,
                                   Builder::OpMap& ng_op_map) {
   ng::Output<ng::Node> ng_arg;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_arg));
-  SaveNgOp(ng_op_map, op->name(), ng_arg);
+  SaveNgOp(ng_op_map, op, ng_arg);
   return Status::OK();
 }
 
@@ -2317,7 +2422,7 @@ static Status TranslateIsFiniteOp(
   auto is_finite = ConstructNgNode<opset::LogicalAnd>(
       op->name(), neq_inf_and_neq_neg_inf, eq_nan);
 
-  SaveNgOp(ng_op_map, op->name(), is_finite);
+  SaveNgOp(ng_op_map, op, is_finite);
   return Status::OK();
 }
 
@@ -2346,7 +2451,7 @@ static Status TranslateL2LossOp(const Node* op,
   auto ng_sum =
       ConstructNgNode<opset::ReduceSum>(op->name(), ng_pow, ng_reduction_axes);
   auto ng_l2loss = ConstructNgNode<opset::Divide>(op->name(), ng_sum, const_2);
-  SaveNgOp(ng_op_map, op->name(), ng_l2loss);
+  SaveNgOp(ng_op_map, op, ng_l2loss);
   return Status::OK();
 }
 
@@ -2392,7 +2497,7 @@ static Status TranslateLRNOp(const Node* op,
   auto ng_output = ConstructNgNode<opset::LRN>(op->name(), ng_inp, alpha, beta,
                                                bias, (size_t)size);
   NCHWtoNHWC(op->name(), true, ng_output);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2406,7 +2511,7 @@ static Status TranslateLogSoftmaxOp(const Node* op,
   int64 axes = rank - 1;
 
   auto ng_output = ConstructNgNode<opset::LogSoftmax>(op->name(), ng_inp, axes);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2422,7 +2527,7 @@ static Status TranslateLeakyReluOp(const Node* op,
                                                    ng::Shape{1}, alpha);
 
   auto ng_output = ConstructNgNode<opset::PRelu>(op->name(), ng_inp, ng_alpha);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2439,7 +2544,7 @@ static Status TranslateMatMulOp(const Node* op,
   bool transpose_b = false;
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "transpose_b", &transpose_b));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::MatMul>(op->name(), ng_lhs, ng_rhs,
                                           transpose_a, transpose_b));
   return Status::OK();
@@ -2500,7 +2605,7 @@ static Status TranslateMaxPoolOp(const Node* op,
   OVTF_VLOG(3) << "maxpool outshape: {" << ng::join(ng_maxpool.get_shape())
                << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_maxpool);
+  SaveNgOp(ng_op_map, op, ng_maxpool);
   return Status::OK();
 }
 
@@ -2555,7 +2660,7 @@ static Status TranslateNonMaxSuppressionV2Op(
       std::vector<int64_t>{0, 1});
 
   Builder::SetTracingInfo(op->name(), ng_nmsv_slice);
-  SaveNgOp(ng_op_map, op->name(), ng_nmsv_slice);
+  SaveNgOp(ng_op_map, op, ng_nmsv_slice);
   return Status::OK();
 }
 
@@ -2612,7 +2717,7 @@ static Status TranslateNonMaxSuppressionV3Op(
       std::vector<int64_t>{0, 1});
 
   Builder::SetTracingInfo(op->name(), ng_nmsv_slice);
-  SaveNgOp(ng_op_map, op->name(), ng_nmsv_slice);
+  SaveNgOp(ng_op_map, op, ng_nmsv_slice);
   return Status::OK();
 }
 
@@ -2647,7 +2752,7 @@ static Status TranslateReduceOp(
   ng::Output<ng::Node> ng_node =
       create_ng_node(ng_input, ng_reduction_axes, tf_keep_dims);
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -2696,7 +2801,7 @@ static Status TranslateOneHotOp(
 
   auto ng_onehot = ConstructNgNode<opset::OneHot>(
       op->name(), ng_features, const_depth, ng_on, ng_off, one_hot_axis);
-  SaveNgOp(ng_op_map, op->name(), ng_onehot);
+  SaveNgOp(ng_op_map, op, ng_onehot);
   return Status::OK();
 }
 
@@ -2721,8 +2826,8 @@ static Status TranslatePackOp(const Node* op, const std::vector<const Tensor*>&,
 
   // if inputs shape is (2, 3, 4), and axis is 1, then we want
   // to create output_shape (2, num_inputs, 3, 4)
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Concat>(
-                                      op->name(), ng_concat_inputs, tf_axis));
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Concat>(
+                              op->name(), ng_concat_inputs, tf_axis));
   return Status::OK();
 }
 
@@ -2789,7 +2894,7 @@ static Status TranslatePadOp(const Node* op,
       ConstructNgNode<opset::Pad>(op->name(), ng_input, pads_begin_node,
                                   pads_end_node, pad_val_op, pad_mode);
 
-  SaveNgOp(ng_op_map, op->name(), result_pad_op);
+  SaveNgOp(ng_op_map, op, result_pad_op);
   return Status::OK();
 }
 
@@ -2815,7 +2920,7 @@ static Status TranslateRangeOp(
   auto ng_range = ConstructNgNode<opset::Range>(op->name(), start_node,
                                                 stop_node, step_node, out_type);
 
-  SaveNgOp(ng_op_map, op->name(), ng_range);
+  SaveNgOp(ng_op_map, op, ng_range);
   return Status::OK();
 }
 
@@ -2831,7 +2936,7 @@ static Status TranslateRankOp(const Node* op, const std::vector<const Tensor*>&,
       op->name(), ng::element::i32, ng::Shape(),
       std::vector<int>({input_rank}));
 
-  SaveNgOp(ng_op_map, op->name(), ng_rank);
+  SaveNgOp(ng_op_map, op, ng_rank);
   return Status::OK();
 }
 
@@ -2869,7 +2974,7 @@ static Status TranslateRelu6Op(const Node* op,
   if (device == "CPU") {
     if (ng_input_shape.size() == 4) Transpose<0, 2, 3, 1>(ng_output);
   }
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
 
   return Status::OK();
 }
@@ -2889,8 +2994,8 @@ static Status TranslateReshapeOp(
 
   auto ng_shape = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ng::Shape{shape.size()}, shape);
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Reshape>(
-                                      op->name(), ng_input, ng_shape, false));
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Reshape>(
+                              op->name(), ng_input, ng_shape, false));
   return Status::OK();
 }
 
@@ -2903,7 +3008,7 @@ static Status TranslateRoundOp(
   // using default round mode "half_to_even" in openvino,
   // as TF has only that mode
   opset::Round::RoundMode round_mode = opset::Round::RoundMode::HALF_TO_EVEN;
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Round>(op->name(), ng_input, round_mode));
   return Status::OK();
 }
@@ -2943,7 +3048,7 @@ static Status TranslateResizeBilinearOp(
   auto ng_output = ConstructNgNode<opset::Interpolate>(
       op->name(), ng_inp, ng_inp_sizes, ng_scales, ng_axes, interpolate_attrs);
   Transpose<0, 2, 3, 1>(ng_output);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2983,7 +3088,7 @@ static Status TranslateResizeNearestNeighborOp(
   auto ng_output = ConstructNgNode<opset::Interpolate>(
       op->name(), ng_inp, ng_inp_sizes, ng_scales, ng_axes, interpolate_attrs);
   Transpose<0, 2, 3, 1>(ng_output);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -2993,7 +3098,7 @@ static Status TranslateReverseOp(
   ng::Output<ng::Node> ng_input, ng_reversed_axis;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_reversed_axis));
   ngraph::op::v1::Reverse::Mode mode = ngraph::op::v1::Reverse::Mode::INDEX;
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<ngraph::op::v1::Reverse>(op->name(), ng_input,
                                                     ng_reversed_axis, mode));
   return Status::OK();
@@ -3033,7 +3138,7 @@ static Status TranslateScatterNdOp(
   auto scatternd_op = ConstructNgNode<opset::ScatterNDUpdate>(
       op->name(), ng_input, ng_input_indices, ng_updates);
 
-  SaveNgOp(ng_op_map, op->name(), scatternd_op);
+  SaveNgOp(ng_op_map, op, scatternd_op);
   return Status::OK();
 }
 
@@ -3050,7 +3155,7 @@ static Status TranslateShapeOp(const Node* op,
   TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(dtype, &type));
 
   // default output_type = element::i64
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::ShapeOf>(op->name(), ng_input, type));
   return Status::OK();
 }
@@ -3077,7 +3182,71 @@ static Status TranslateSizeOp(const Node* op, const std::vector<const Tensor*>&,
   auto ng_result = ConstructNgNode<opset::Constant>(
       op->name(), type, ng::Shape(0), std::vector<int64>({result}));
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
+  return Status::OK();
+}
+
+// Translates a Slice whose begin is a runtime parameter (see
+// GetRuntimeInputCapabilities in mark_for_clustering.cc). The window of each
+// sliced axis is gathered at begin[axis] + [0, size[axis]), which keeps the
+// output shape static for any value of begin. The network can't raise an
+// error, so unlike TF, an out of range begin[axis] is clamped to
+// [0, dim[axis] - size[axis]] instead of failing, and the window always lies
+// within the input.
+static Status TranslateSliceWithRuntimeBegin(
+    const Node* op, const std::vector<const Tensor*>& static_input_map,
+    ng::Output<ng::Node> ng_input, ng::Output<ng::Node> ng_begin,
+    Builder::OpMap& ng_op_map) {
+  std::vector<int64> size_vec;
+  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 2, static_input_map, &size_vec));
+  const auto ng_input_shape = ng_input.get_shape();
+  if (size_vec.size() != ng_input_shape.size()) {
+    return errors::InvalidArgument(
+        "Cannot translate slice op: size of size_vec = ", size_vec.size(),
+        ", rank of the input = ", ng_input_shape.size(),
+        ". Expected them to match.");
+  }
+
+  if (ng_begin.get_element_type() != ng::element::i64) {
+    ng_begin = ConstructNgNode<opset::Convert>(op->name(), ng_begin,
+                                               ng::element::i64);
+  }
+  auto ng_zero = ConstructNgNode<opset::Constant>(
+      op->name(), ng::element::i64, ng::Shape{}, std::vector<int64>{0});
+
+  ng::Output<ng::Node> ng_result = ng_input;
+  for (int64 i = 0; i < (int64)size_vec.size(); i++) {
+    if (size_vec[i] < 0 || size_vec[i] > (int64)ng_input_shape[i]) {
+      return errors::InvalidArgument("Cannot translate slice op: size ",
+                                     size_vec[i], " at position ", i,
+                                     " is out of range for dimension ",
+                                     ng_input_shape[i]);
+    }
+    // TF requires begin to be 0 when the window covers the whole axis
+    if (size_vec[i] == (int64)ng_input_shape[i]) continue;
+
+    std::vector<int64> window(size_vec[i]);
+    std::iota(window.begin(), window.end(), 0);
+    auto ng_window = ConstructNgNode<opset::Constant>(
+        op->name(), ng::element::i64, ng::Shape{window.size()}, window);
+    auto ng_axis =
+        ConstructNgNode<opset::Constant>(op->name(), ng::element::i64,
+                                         ng::Shape{}, std::vector<int64>{i});
+    auto ng_axis_begin = ConstructNgNode<opset::Gather>(op->name(), ng_begin,
+                                                        ng_axis, ng_zero);
+    auto ng_max_begin = ConstructNgNode<opset::Constant>(
+        op->name(), ng::element::i64, ng::Shape{},
+        std::vector<int64>{(int64)ng_input_shape[i] - size_vec[i]});
+    ng_axis_begin = ConstructNgNode<opset::Minimum>(
+        op->name(), ConstructNgNode<opset::Maximum>(op->name(), ng_axis_begin,
+                                                     ng_zero),
+        ng_max_begin);
+    auto ng_indices =
+        ConstructNgNode<opset::Add>(op->name(), ng_window, ng_axis_begin);
+    ng_result = ConstructNgNode<opset::Gather>(op->name(), ng_result,
+                                               ng_indices, ng_axis);
+  }
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -3087,6 +3256,11 @@ static Status TranslateSliceOp(
   ng::Output<ng::Node> ng_input, ng_begin, ng_size;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_begin, ng_size));
 
+  if (!InputIsStatic(op, 1)) {
+    return TranslateSliceWithRuntimeBegin(op, static_input_map, ng_input,
+                                          ng_begin, ng_op_map);
+  }
+
   std::vector<int64> begin_vec;
   std::vector<int64> size_vec;
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &begin_vec));
@@ -3135,7 +3309,7 @@ static Status TranslateSliceOp(
   auto end = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ng::Shape{end_vec.size()}, end_vec);
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::StridedSlice>(op->name(), ng_input, begin,
                                                 end, std::vector<int64_t>{},
                                                 std::vector<int64_t>{}));
@@ -3153,7 +3327,7 @@ static Status TranslateSoftmaxOp(const Node* op,
     return errors::InvalidArgument("TF Softmax logits must be >=1 dimension");
   }
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Softmax>(op->name(), ng_input, rank - 1));
   return Status::OK();
 }
@@ -3172,7 +3346,7 @@ static Status TranslateSoftPlusOp(const Node* op,
   auto add = ConstructNgNode<opset::Add>(op->name(), exp, add_const);
   auto ng_output = ConstructNgNode<opset::Log>(op->name(), add);
 
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -3201,7 +3375,7 @@ static Status TranslateSpaceToDepthOp(const Node* op,
   auto space_to_depth = ConstructNgNode<opset::SpaceToDepth>(
       op->name(), ng_input, ng_mode, block_size);
   NCHWtoNHWC(op->name(), is_nhwc, space_to_depth);
-  SaveNgOp(ng_op_map, op->name(), space_to_depth);
+  SaveNgOp(ng_op_map, op, space_to_depth);
   return Status::OK();
 }
 
@@ -3228,7 +3402,7 @@ static Status TranslateSplitOp(
   for (int i = 0; i < num_split; ++i) {
     auto out = ng_split->output(i);
     Builder::SetTracingInfo(op->name(), out);
-    SaveNgOp(ng_op_map, op->name(), out);
+    SaveNgOp(ng_op_map, op, out);
   }
   return Status::OK();
 }
@@ -3303,10 +3477,10 @@ static Status TranslateSplitVOp(
     for (size_t i = 0; i < split_lengths_vec.size(); ++i) {
       auto out = ng_split->output(i);
       Builder::SetTracingInfo(op->name(), out);
-      SaveNgOp(ng_op_map, op->name(), out);
+      SaveNgOp(ng_op_map, op, out);
     }
   } else {
-    SaveNgOp(ng_op_map, op->name(), ng_input);
+    SaveNgOp(ng_op_map, op, ng_input);
   }
 
   return Status::OK();
@@ -3337,7 +3511,7 @@ static Status TranslateSqueezeOp(const Node* op,
   }
 
   if (input_dims > 0 && ng_input.get_shape()[0] == 0) {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Constant>(
                  op->name(), ng_input.get_element_type(), ngraph::Shape{0},
                  std::vector<int>({0})));
@@ -3345,7 +3519,7 @@ static Status TranslateSqueezeOp(const Node* op,
     auto ng_const = ConstructNgNode<opset::Constant>(
         op->name(), ng::element::i32, ng::Shape{tf_axis.size()}, tf_axis);
 
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Squeeze>(op->name(), ng_input, ng_const));
   }
   return Status::OK();
@@ -3401,7 +3575,7 @@ static Status TranslateStridedSliceOp(
   };
 
   SaveNgOp(
-      ng_op_map, op->name(),
+      ng_op_map, op,
       ConstructNgNode<opset::StridedSlice>(
           op->name(), ng_input, begin, end, strides, mask_to_vec(begin_mask),
           mask_to_vec(end_mask), mask_to_vec(new_axis_mask),
@@ -3420,7 +3594,7 @@ static Status TranslateTileOp(
 
   auto ng_repeats = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ng::Shape{multiples.size()}, multiples);
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Tile>(op->name(), ng_input, ng_repeats));
   return Status::OK();
 }
@@ -3454,12 +3628,12 @@ static Status TranslateTopKV2Op(
   }
 
   if (ng_k_vec[0] == 0 || ng_input.get_shape()[0] == 0) {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Constant>(
                  op->name(), ng_input.get_element_type(), ngraph::Shape{0},
                  std::vector<int>({0})));
 
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Constant>(op->name(), ng::element::i32,
                                               ngraph::Shape{0},
                                               std::vector<int>({0})));
@@ -3472,8 +3646,8 @@ static Status TranslateTopKV2Op(
     ng::Output<ng::Node> ng_indices = ng_result->output(1);
     Builder::SetTracingInfo(op->name(), ng_indices);
 
-    SaveNgOp(ng_op_map, op->name(), ng_values);
-    SaveNgOp(ng_op_map, op->name(), ng_indices);
+    SaveNgOp(ng_op_map, op, ng_values);
+    SaveNgOp(ng_op_map, op, ng_indices);
   }
 
   return Status::OK();
@@ -3484,8 +3658,8 @@ static Status TranslateTransposeOp(
     Builder::OpMap& ng_op_map) {
   ng::Output<ng::Node> ng_input, ng_permutation;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_permutation));
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Transpose>(
-                                      op->name(), ng_input, ng_permutation));
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Transpose>(
+                              op->name(), ng_input, ng_permutation));
   return Status::OK();
 }
 
@@ -3528,7 +3702,7 @@ static Status TranslateUnpackOp(const Node* op,
         op->name(), ng::element::i32, ng::Shape{}, tf_axis);
     auto squeeze =
         ConstructNgNode<opset::Squeeze>(op->name(), slice, squeeze_axis);
-    SaveNgOp(ng_op_map, op->name(), squeeze);
+    SaveNgOp(ng_op_map, op, squeeze);
   }
   return Status::OK();
 }
@@ -3543,8 +3717,8 @@ static Status TranslateXdivyOp(
                                        ngraph::Shape{}, std::vector<int>({0}));
   auto x_is_zero = ConstructNgNode<opset::Equal>(op->name(), ng_x, zero);
   auto ng_xdivy = ConstructNgNode<opset::Divide>(op->name(), ng_x, ng_y);
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Select>(
-                                      op->name(), x_is_zero, ng_x, ng_xdivy));
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Select>(
+                              op->name(), x_is_zero, ng_x, ng_xdivy));
   return Status::OK();
 }
 
@@ -3556,7 +3730,7 @@ static Status TranslateSelectOp(const Node* op,
       GetInputNodes(ng_op_map, op, ng_input1, ng_input2, ng_input3));
   auto ng_select = ConstructNgNode<opset::Select>(op->name(), ng_input1,
                                                   ng_input2, ng_input3);
-  SaveNgOp(ng_op_map, op->name(), ng_select);
+  SaveNgOp(ng_op_map, op, ng_select);
   return Status::OK();
 }
 
@@ -3569,8 +3743,8 @@ static Status TranslateWhereOp(
   auto transpose_order = ConstructNgNode<opset::Constant>(
       op->name(), ngraph::element::i64, ngraph::Shape{2},
       std::vector<int64_t>({1, 0}));
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Transpose>(
-                                      op->name(), non_zero, transpose_order));
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Transpose>(
+                              op->name(), non_zero, transpose_order));
   return Status::OK();
 }
 
@@ -3584,14 +3758,11 @@ static Status TranslateZerosLikeOp(const Node* op,
   std::vector<std::string> const_values(ng::shape_size(input_shape), "0");
   auto ng_result = ConstructNgNode<opset::Constant>(
       op->name(), ng_input.get_element_type(), input_shape, const_values);
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
-const static std::map<
-    const string,
-    const function<Status(const Node*, const std::vector<const Tensor*>&,
-                          Builder::OpMap&)>>
+const static std::map<const string, const Builder::TranslateOpFunction>
     TRANSLATE_OP_MAP{
         {"Abs", TranslateUnaryOp<opset::Abs>},
         {"Acos", TranslateUnaryOp<opset::Acos>},
@@ -3745,12 +3916,134 @@ Status Builder::TranslateGraph(
   return Status::OK();
 }
 
-Status Builder::TranslateGraph(
-    const std::vector<TensorShape>& inputs,
-    const std::vector<const Tensor*>& static_input_map,
-    const Graph* input_graph, const string name,
-    shared_ptr<ng::Function>& ng_function, ng::ResultVector& ng_result_list,
-    const std::vector<Tensor>& tf_input_tensors) {
+// Runs one simplification pass if it is selected, logging the number of nodes
+// of the function before and after it
+template <class TPass>
+static void RunSimplificationPass(
+    const std::shared_ptr<ng::Function>& ng_function, const string& name,
+    const std::set<string>& selected) {
+  if (!selected.empty() && selected.count(name) == 0) return;
+  size_t num_nodes = ng_function->get_ops().size();
+  ngraph::pass::Manager passes;
+  passes.register_pass<TPass>();
+  passes.run_passes(ng_function);
+  size_t num_simplified_nodes = ng_function->get_ops().size();
+  OVTF_VLOG(1) << "Simplification pass " << name << " on "
+               << ng_function->get_friendly_name() << ": " << num_nodes
+               << " -> " << num_simplified_nodes << " nodes";
+  if (num_simplified_nodes < num_nodes) {
+    Metrics::Increment("simplified_nodes", num_nodes - num_simplified_nodes);
+  }
+}
+
+// Runs the simplification passes listed in OPENVINO_TF_SIMPLIFY_PASSES, all
+// of them by default. The constants are deduplicated first so that the ops
+// reading identical constants are found identical by the CSE. An unknown
+// pass name is an error, rather than a pass silently left out.
+static Status SimplifyFunction(
+    const std::shared_ptr<ng::Function>& ng_function) {
+  string passes = util::GetEnv("OPENVINO_TF_SIMPLIFY_PASSES");
+  if (passes == "0") return Status::OK();
+  static const std::set<string> known_passes{"constants", "redundant_ops",
+                                             "cse"};
+  std::set<string> selected;
+  std::stringstream ss(passes);
+  string name;
+  while (std::getline(ss, name, ',')) {
+    if (name.empty()) continue;
+    if (known_passes.count(name) == 0) {
+      return errors::InvalidArgument(
+          "Unknown simplification pass \"", name,
+          "\" in OPENVINO_TF_SIMPLIFY_PASSES, expected a comma separated "
+          "list of constants, redundant_ops and cse, or 0");
+    }
+    selected.insert(name);
+  }
+  RunSimplificationPass<pass::ConstantDeduplication>(ng_function, "constants",
+                                                     selected);
+  RunSimplificationPass<pass::RedundantOpElimination>(
+      ng_function, "redundant_ops", selected);
+  RunSimplificationPass<pass::CommonSubexpressionElimination>(
+      ng_function, "cse", selected);
+  return Status::OK();
+}
+
+static std::mutex s_translation_profile_mutex;
+static std::map<std::string, Builder::TranslationProfile> s_translation_profile;
+
+std::map<std::string, Builder::TranslationProfile>
+Builder::GetTranslationProfile() {
+  std::lock_guard<std::mutex> lock(s_translation_profile_mutex);
+  return s_translation_profile;
+}
+
+void Builder::ResetTranslationProfile() {
+  std::lock_guard<std::mutex> lock(s_translation_profile_mutex);
+  s_translation_profile.clear();
+}
+
+// Adds the times of one translation to the profile, to the
+// translation_profile/<op type>/{calls,total_us,max_us} counters and to the
+// log, where the op types of this translation are listed slowest first.
+static void UpdateTranslationProfile(
+    const string& name,
+    const std::vector<std::pair<const std::string*, int64>>& op_times) {
+  std::map<std::string, Builder::TranslationProfile> deltas;
+  for (const auto& op_time : op_times) {
+    auto& delta = deltas[*op_time.first];
+    int64 us = op_time.second;
+    delta.count++;
+    delta.total_us += us;
+    delta.max_us = std::max(delta.max_us, us);
+    int bucket = 0;
+    for (int64 limit = 10; bucket < 4 && us >= limit; limit *= 10) {
+      bucket++;
+    }
+    delta.histogram[bucket]++;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(s_translation_profile_mutex);
+    for (const auto& kv : deltas) {
+      auto& profile = s_translation_profile[kv.first];
+      profile.count += kv.second.count;
+      profile.total_us += kv.second.total_us;
+      profile.max_us = std::max(profile.max_us, kv.second.max_us);
+      for (size_t i = 0; i < profile.histogram.size(); i++) {
+        profile.histogram[i] += kv.second.histogram[i];
+      }
+    }
+  }
+
+  for (const auto& kv : deltas) {
+    string prefix = "translation_profile/" + kv.first;
+    Metrics::Increment(prefix + "/calls", kv.second.count);
+    Metrics::Increment(prefix + "/total_us", kv.second.total_us);
+    Metrics::UpdateMax(prefix + "/max_us", kv.second.max_us);
+  }
+
+  if (!OVTF_VLOG_IS_ON(1)) return;
+  std::vector<std::pair<std::string, Builder::TranslationProfile>> sorted(
+      deltas.begin(), deltas.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::pair<std::string, Builder::TranslationProfile>& a,
+               const std::pair<std::string, Builder::TranslationProfile>& b) {
+              return a.second.total_us > b.second.total_us;
+            });
+  for (const auto& kv : sorted) {
+    const auto& h = kv.second.histogram;
+    OVTF_VLOG(1) << "Translation profile of " << name << ": " << kv.first
+                 << " calls: " << kv.second.count
+                 << " total: " << kv.second.total_us << " us"
+                 << " max: " << kv.second.max_us << " us"
+                 << " histogram: <10us: " << h[0] << ", <100us: " << h[1]
+                 << ", <1ms: " << h[2] << ", <10ms: " << h[3]
+                 << ", >=10ms: " << h[4];
+  }
+}
+
+Status Builder::CreateTranslationPlan(const Graph* input_graph,
+                                      TranslationPlan& plan) {
   //
   // We will visit ops in topological order.
   //
@@ -3762,9 +4055,9 @@ Status Builder::TranslateGraph(
   //
   // Split ops into params, retvals, and all others.
   //
-  vector<const Node*> tf_params;
-  vector<const Node*> tf_ret_vals;
-  vector<const Node*> tf_ops;
+  plan = TranslationPlan();
+  plan.num_node_ids = input_graph->num_node_ids();
+  plan.ops.reserve(ordered.size());
 
   for (const auto n : ordered) {
     if (n->IsSink() || n->IsSource()) {
@@ -3778,19 +4071,63 @@ Status Builder::TranslateGraph(
     }
 
     if (n->IsArg()) {
-      tf_params.push_back(n);
+      plan.params.push_back(n);
     } else if (n->IsRetval()) {
-      tf_ret_vals.push_back(n);
+      plan.ret_vals.push_back(n);
     } else {
-      tf_ops.push_back(n);
+      auto it = TRANSLATE_OP_MAP.find(n->type_string());
+      if (it == TRANSLATE_OP_MAP.end()) {
+        // -----------------------------
+        // Catch-all for unsupported ops
+        // -----------------------------
+        OVTF_VLOG(3) << "No translation handler registered for op: "
+                     << n->name() << " (" << n->type_string() << ")";
+        OVTF_VLOG(3) << n->def().DebugString();
+        return errors::InvalidArgument(
+            "No translation handler registered for op: ", n->name(), " (",
+            n->type_string(), ")\n", n->def().DebugString());
+      }
+      plan.ops.emplace_back(n, &it->second);
     }
   }
+  return Status::OK();
+}
+
+Status Builder::TranslateGraph(
+    const std::vector<TensorShape>& inputs,
+    const std::vector<const Tensor*>& static_input_map,
+    const Graph* input_graph, const string name,
+    shared_ptr<ng::Function>& ng_function, ng::ResultVector& ng_result_list,
+    const std::vector<Tensor>& tf_input_tensors) {
+  TranslationPlan plan;
+  TF_RETURN_IF_ERROR(CreateTranslationPlan(input_graph, plan));
+  return TranslateGraph(inputs, static_input_map, plan, name, ng_function,
+                        ng_result_list, tf_input_tensors);
+}
+
+Status Builder::TranslateGraph(
+    const std::vector<TensorShape>& inputs,
+    const std::vector<const Tensor*>& static_input_map,
+    const TranslationPlan& plan, const string name,
+    shared_ptr<ng::Function>& ng_function, ng::ResultVector& ng_result_list,
+    const std::vector<Tensor>& tf_input_tensors) {
+  const auto& tf_params = plan.params;
+  const auto& tf_ret_vals = plan.ret_vals;
+
+  // Collect the tracing info of the created nodes, it is attached once the
+  // function is created. Reset on exit, including on errors.
+  std::vector<std::pair<std::shared_ptr<ng::Node>, std::string>>
+      pending_tracing_info;
+  s_pending_tracing_info = &pending_tracing_info;
+  struct TracingInfoReset {
+    ~TracingInfoReset() { s_pending_tracing_info = nullptr; }
+  } tracing_info_reset;
 
   //
-  // The op map holds a mapping from TensorFlow op names (strings) to
+  // The op map holds a mapping from TensorFlow node ids to
   // vector of generated nGraph Output<Node>.
   //
-  Builder::OpMap ng_op_map;
+  Builder::OpMap ng_op_map(plan.num_node_ids);
 
   //
   // Populate the parameter list, and also put parameters into the op map.
@@ -3844,7 +4181,7 @@ Status Builder::TranslateGraph(
       std::vector<std::string> constant_values(ng::shape_size(ng_shape), "0");
       auto ng_const_input = ConstructNgNode<opset::Constant>(
           prov_tag, ng_et, ng_shape, constant_values);
-      SaveNgOp(ng_op_map, parm->name(), ng_const_input);
+      SaveNgOp(ng_op_map, parm, ng_const_input);
     } else {
       if (is_variable) {
         ng::Output<ng::Node> ng_const_input;
@@ -3901,9 +4238,9 @@ Status Builder::TranslateGraph(
                                     "; don't know how to convert");
         }
 
-        SaveNgOp(ng_op_map, parm->name(), ng_const_input);
+        SaveNgOp(ng_op_map, parm, ng_const_input);
       } else
-        SaveNgOp(ng_op_map, parm->name(), ng_param);
+        SaveNgOp(ng_op_map, parm, ng_param);
     }
     ng_parameter_list[index] =
         ngraph::as_type_ptr<opset::Parameter>(ng_param.get_node_shared_ptr());
@@ -3912,35 +4249,29 @@ Status Builder::TranslateGraph(
   //
   // Now create the nGraph ops from TensorFlow ops.
   //
-  for (auto op : tf_ops) {
+  bool profile_translation =
+      util::GetEnv("OPENVINO_TF_PROFILE_TRANSLATION") == "1";
+  std::vector<std::pair<const std::string*, int64>> op_times;
+  for (const auto& op_and_fun : plan.ops) {
+    const Node* op = op_and_fun.first;
     OVTF_VLOG(2) << "Constructing op " << op->name() << " which is "
                  << op->type_string();
 
-    const function<Status(const Node*, const std::vector<const Tensor*>&,
-                          Builder::OpMap&)>* op_fun;
-
+    Timer op_time;
     try {
-      op_fun = &(TRANSLATE_OP_MAP.at(op->type_string()));
-    } catch (const std::out_of_range&) {
-      // -----------------------------
-      // Catch-all for unsupported ops
-      // -----------------------------
-      OVTF_VLOG(3) << "No translation handler registered for op: " << op->name()
-                   << " (" << op->type_string() << ")";
-      OVTF_VLOG(3) << op->def().DebugString();
-      return errors::InvalidArgument(
-          "No translation handler registered for op: ", op->name(), " (",
-          op->type_string(), ")\n", op->def().DebugString());
-    }
-
-    try {
-      TF_RETURN_IF_ERROR((*op_fun)(op, static_input_map, ng_op_map));
+      TF_RETURN_IF_ERROR((*op_and_fun.second)(op, static_input_map, ng_op_map));
     } catch (const std::exception& e) {
       return errors::Internal("Unhandled exception in op handler: ", op->name(),
                               " (", op->type_string(), ")\n",
                               op->def().DebugString(), "\n", "what(): ",
                               e.what());
     }
+    if (profile_translation) {
+      op_times.emplace_back(&op->type_string(), op_time.ElapsedInMicroSec());
+    }
+  }
+  if (profile_translation) {
+    UpdateTranslationProfile(name, op_times);
   }
 
   //
@@ -4009,6 +4340,31 @@ Status Builder::TranslateGraph(
                             ": " + string(exp.what()));
   }
 
+  //
+  // Attach the tracing info to the nodes of the function.
+  //
+  {
+    std::unordered_set<const ng::Node*> function_nodes;
+    for (const auto& node : ng_function->get_ops()) {
+      function_nodes.insert(node.get());
+    }
+    for (const auto& param : ng_parameter_list) {
+      function_nodes.insert(param.get());
+    }
+    for (const auto& result : ng_result_list) {
+      function_nodes.insert(result.get());
+    }
+    s_pending_tracing_info = nullptr;
+    bool log_placement = api::IsLoggingPlacement();
+    for (const auto& tracing_info : pending_tracing_info) {
+      if (function_nodes.count(tracing_info.first.get())) {
+        AttachTracingInfo(tracing_info.second, tracing_info.first,
+                          log_placement);
+      }
+    }
+    pending_tracing_info.clear();
+  }
+
   //
   // Apply additional passes on the nGraph function here.
   //
@@ -4022,6 +4378,7 @@ Status Builder::TranslateGraph(
     }
     passes.run_passes(ng_function);
   }
+  TF_RETURN_IF_ERROR(SimplifyFunction(ng_function));
   OVTF_VLOG(5) << "Done with passes";
   //
   // Request row-major layout on results.
@@ -6,6 +6,8 @@
 #ifndef OPENVINO_TF_BRIDGE_BUILDER_H_
 #define OPENVINO_TF_BRIDGE_BUILDER_H_
 
+#include <array>
+#include <map>
 #include <ostream>
 #include <vector>
 
@@ -19,6 +21,25 @@ namespace openvino_tensorflow {
 
 class Builder {
  public:
+  // The translated outputs of each TF node, indexed by node id
+  using OpMap = std::vector<std::vector<ngraph::Output<ngraph::Node>>>;
+  using TranslateOpFunction = std::function<Status(
+      const Node*, const std::vector<const Tensor*>&, Builder::OpMap&)>;
+
+  // The nodes of a TF graph in the order they are translated, along with the
+  // translation handler of each op. It only depends on the graph, so it can be
+  // created once and reused when the graph is translated again for other
+  // input shapes.
+  struct TranslationPlan {
+    std::vector<const Node*> params;
+    std::vector<const Node*> ret_vals;
+    std::vector<std::pair<const Node*, const TranslateOpFunction*>> ops;
+    int num_node_ids = 0;
+  };
+
+  static Status CreateTranslationPlan(const Graph* tf_graph,
+                                      TranslationPlan& plan);
+
   static Status TranslateGraph(
       const std::vector<TensorShape>& inputs,
       const std::vector<const Tensor*>& static_input_map, const Graph* tf_graph,
@@ -31,8 +52,26 @@ class Builder {
       ngraph::ResultVector& ng_func_result_list,
       const std::vector<Tensor>& tf_input_tensors);
 
-  using OpMap = std::unordered_map<std::string,
-                                   std::vector<ngraph::Output<ngraph::Node>>>;
+  static Status TranslateGraph(
+      const std::vector<TensorShape>& inputs,
+      const std::vector<const Tensor*>& static_input_map,
+      const TranslationPlan& plan, const string name,
+      std::shared_ptr<ngraph::Function>& ng_function,
+      ngraph::ResultVector& ng_func_result_list,
+      const std::vector<Tensor>& tf_input_tensors);
+
+  // Time spent in the translation handlers of an op type, collected when
+  // OPENVINO_TF_PROFILE_TRANSLATION=1. histogram counts the calls that took
+  // less than 10us, 100us, 1ms, 10ms and longer.
+  struct TranslationProfile {
+    int64 count = 0;
+    int64 total_us = 0;
+    int64 max_us = 0;
+    std::array<int64, 5> histogram{};
+  };
+  static std::map<std::string, TranslationProfile> GetTranslationProfile();
+  static void ResetTranslationProfile();
+
   using ConstMap = std::map<
       DataType,
       std::pair<std::function<Status(const Node*, ngraph::element::Type,
@@ -68,6 +107,8 @@ class Builder {
   // But when present they are correct and agree with provenance tags
   // 2. Attaches friendly names.
   // 3. Prints a log if OPENVINO_TF_LOG_PLACEMENT=1
+  // During TranslateGraph, this is deferred until the function is created and
+  // only done for the nodes that are part of it.
   static void SetTracingInfo(const std::string& op_name,
                              const ngraph::Output<ngraph::Node> ng_node);
 };
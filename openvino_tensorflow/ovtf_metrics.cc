@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <sstream>
+
+#include "openvino_tensorflow/ovtf_metrics.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::map<std::string, int64> Metrics::s_counters;
+std::mutex Metrics::s_counters_mutex;
+
+void Metrics::Increment(const std::string& name, int64 delta) {
+  std::lock_guard<std::mutex> lock(s_counters_mutex);
+  s_counters[name] += delta;
+}
+
+void Metrics::Set(const std::string& name, int64 value) {
+  std::lock_guard<std::mutex> lock(s_counters_mutex);
+  s_counters[name] = value;
+}
+
+void Metrics::UpdateMax(const std::string& name, int64 value) {
+  std::lock_guard<std::mutex> lock(s_counters_mutex);
+  auto& counter = s_counters[name];
+  if (value > counter) counter = value;
+}
+
+int64 Metrics::Get(const std::string& name) {
+  std::lock_guard<std::mutex> lock(s_counters_mutex);
+  auto it = s_counters.find(name);
+  return it == s_counters.end() ? 0 : it->second;
+}
+
+std::map<std::string, int64> Metrics::GetAll() {
+  std::lock_guard<std::mutex> lock(s_counters_mutex);
+  return s_counters;
+}
+
+void Metrics::Reset() {
+  std::lock_guard<std::mutex> lock(s_counters_mutex);
+  s_counters.clear();
+}
+
+void Metrics::Dump(std::string& metrics) {
+  std::stringstream ss;
+  for (const auto& it : GetAll()) {
+    ss << it.first << " " << it.second << "\n";
+  }
+  metrics = ss.str();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
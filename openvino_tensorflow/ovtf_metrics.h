@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+// Process-wide counters of openvino_tensorflow (e.g. the amount of work
+// abandoned because of cancelled steps). They can be read from Python with
+// openvino_tensorflow.get_metrics().
+
+#ifndef OPENVINO_TF_METRICS_H_
+#define OPENVINO_TF_METRICS_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+class Metrics {
+ public:
+  static void Increment(const std::string& name, int64 delta = 1);
+  static void Set(const std::string& name, int64 value);
+  // Raises the counter to value if it is lower
+  static void UpdateMax(const std::string& name, int64 value);
+  // Returns 0 for counters that have never been incremented
+  static int64 Get(const std::string& name);
+  static std::map<std::string, int64> GetAll();
+  static void Reset();
+  // Writes one "<name> <value>" line per counter
+  static void Dump(std::string& metrics);
+
+ private:
+  static std::map<std::string, int64> s_counters;
+  static std::mutex s_counters_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_METRICS_H_
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/lib/strings/numbers.h"
+
+#include "api.h"
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/partition_clusters.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+//
+// AssignClusters grows the clusters as much as possible, so a large model
+// often ends up in a single cluster whose translation and compile take
+// minutes and gigabytes. When a cap is set, this pass splits every cluster
+// above it:
+//
+//   1. The nodes of the cluster are ordered topologically. Since a cluster
+//      never has a path leaving it and coming back, any run of consecutive
+//      nodes in this order is a valid cluster, and the runs can't form a
+//      cycle with each other or with the other clusters.
+//   2. The runs are built greedily: each one grows up to the cap, then is
+//      cut back to the position in its second half where the fewest
+//      estimated bytes cross the cut.
+//   3. Constants without inputs are left out of the order and duplicated
+//      into every run that reads them, so that the weights don't become
+//      tensors exchanged between the runs.
+//
+
+static int64 GetCap(const string& name) {
+  string value = util::GetEnv(name);
+  int64 cap;
+  if (value.empty() || !strings::safe_strto64(value, &cap) || cap <= 0) {
+    return 0;
+  }
+  return cap;
+}
+
+// Number of elements of a shape, the unknown dimensions counting as 1
+static int64 NumElements(const PartialTensorShape& shape) {
+  if (shape.unknown_rank()) return 1;
+  int64 num_elements = 1;
+  for (int i = 0; i < shape.dims(); i++) {
+    num_elements *= max<int64>(1, shape.dim_size(i));
+  }
+  return num_elements;
+}
+
+static bool GetOutputShape(const Node* node, int output,
+                           PartialTensorShape& shape) {
+  std::vector<PartialTensorShape> shapes;
+  if (!GetNodeAttr(node->attrs(), "_output_shapes", &shapes).ok() ||
+      output >= (int)shapes.size()) {
+    return false;
+  }
+  shape = shapes[output];
+  return true;
+}
+
+static int64 EstimateTensorBytes(const Node* node, int output) {
+  PartialTensorShape shape;
+  int64 num_elements =
+      GetOutputShape(node, output, shape) ? NumElements(shape) : 1;
+  return num_elements *
+         max(1, DataTypeSize(BaseType(node->output_type(output))));
+}
+
+static bool IsDuplicableConstant(const Node* node) {
+  if (node->type_string() != "Const") return false;
+  for (auto edge : node->in_edges()) {
+    if (!edge->src()->IsSource()) return false;
+  }
+  return true;
+}
+
+int64 EstimateNodeFlops(const Node* node) {
+  PartialTensorShape output_shape;
+  int64 output_elements =
+      GetOutputShape(node, 0, output_shape) ? NumElements(output_shape) : 1;
+
+  // Ops reading constant weights, with the number of trailing weight
+  // dimensions that make the output channels
+  static const std::map<string, int> weighted_ops = {
+      {"MatMul", 1},
+      {"BatchMatMul", 1},
+      {"BatchMatMulV2", 1},
+      {"Conv2D", 1},
+      {"Conv3D", 1},
+      {"DepthwiseConv2dNative", 2}};
+  auto it = weighted_ops.find(node->type_string());
+  const Edge* weight_edge;
+  const TensorProto* weight;
+  if (it != weighted_ops.end() && node->input_edge(1, &weight_edge).ok() &&
+      weight_edge->src()->type_string() == "Const" &&
+      GetNodeAttr(weight_edge->src()->attrs(), "value", &weight).ok()) {
+    TensorShape weight_shape(weight->tensor_shape());
+    int64 output_channels = 1;
+    bool transpose_b = false;
+    if (node->type_string() == "MatMul" &&
+        GetNodeAttr(node->attrs(), "transpose_b", &transpose_b).ok() &&
+        transpose_b && weight_shape.dims() == 2) {
+      output_channels = weight_shape.dim_size(0);
+    } else {
+      for (int i = max(0, weight_shape.dims() - it->second);
+           i < weight_shape.dims(); i++) {
+        output_channels *= weight_shape.dim_size(i);
+      }
+    }
+    // A multiply-add per weight per output position
+    return max<int64>(1, 2 * weight_shape.num_elements() /
+                             max<int64>(1, output_channels) *
+                             output_elements);
+  }
+  return max<int64>(1, output_elements);
+}
+
+Status PartitionClusters(Graph* graph) {
+  const int64 max_nodes = GetCap("OPENVINO_TF_MAX_CLUSTER_NODES");
+  const int64 max_flops = GetCap("OPENVINO_TF_MAX_CLUSTER_FLOPS");
+  if (max_nodes == 0 && max_flops == 0) return Status::OK();
+
+  std::vector<Node*> order;
+  GetReversePostOrder(*graph, &order, NodeComparatorName());
+  std::map<int, std::vector<Node*>> cluster_nodes;
+  std::map<int, std::vector<Node*>> cluster_constants;
+  for (auto node : order) {
+    int cluster;
+    if (!GetNodeCluster(node, &cluster).ok()) continue;
+    if (IsDuplicableConstant(node)) {
+      cluster_constants[cluster].push_back(node);
+    } else {
+      cluster_nodes[cluster].push_back(node);
+    }
+  }
+
+  int num_split_clusters = 0;
+  for (const auto& it : cluster_nodes) {
+    const auto& nodes = it.second;
+    const int num_nodes = nodes.size();
+    std::vector<int64> flops(num_nodes, 0);
+    int64 total_flops = 0;
+    if (max_flops > 0) {
+      for (int i = 0; i < num_nodes; i++) {
+        flops[i] = EstimateNodeFlops(nodes[i]);
+        total_flops += flops[i];
+      }
+    }
+    if ((max_nodes == 0 || num_nodes <= max_nodes) &&
+        (max_flops == 0 || total_flops <= max_flops)) {
+      continue;
+    }
+
+    // crossing_bytes[p] is the estimated size of the tensors produced before
+    // position p and read at or after it
+    std::map<const Node*, int> positions;
+    for (int i = 0; i < num_nodes; i++) {
+      positions[nodes[i]] = i;
+    }
+    std::vector<int64> crossing_bytes(num_nodes + 1, 0);
+    for (int i = 0; i < num_nodes; i++) {
+      std::map<int, int> last_reader;
+      for (auto edge : nodes[i]->out_edges()) {
+        if (edge->IsControlEdge()) continue;
+        auto position = positions.find(edge->dst());
+        if (position == positions.end()) continue;
+        auto& reader = last_reader[edge->src_output()];
+        reader = max(reader, position->second);
+      }
+      for (const auto& reader : last_reader) {
+        int64 bytes = EstimateTensorBytes(nodes[i], reader.first);
+        crossing_bytes[i + 1] += bytes;
+        crossing_bytes[reader.second + 1] -= bytes;
+      }
+    }
+    for (int i = 1; i <= num_nodes; i++) {
+      crossing_bytes[i] += crossing_bytes[i - 1];
+    }
+
+    std::vector<std::pair<int, int>> pieces;
+    int begin = 0;
+    while (begin < num_nodes) {
+      int end = begin;
+      int64 piece_flops = 0;
+      while (end < num_nodes &&
+             (end == begin ||
+              ((max_nodes == 0 || end - begin < max_nodes) &&
+               (max_flops == 0 || piece_flops + flops[end] <= max_flops)))) {
+        piece_flops += flops[end];
+        end++;
+      }
+      if (end < num_nodes) {
+        int best_cut = end;
+        for (int cut = end - 1; cut >= begin + max(1, (end - begin) / 2);
+             cut--) {
+          if (crossing_bytes[cut] < crossing_bytes[best_cut]) best_cut = cut;
+        }
+        end = best_cut;
+      }
+      pieces.push_back({begin, end});
+      begin = end;
+    }
+
+    std::map<const Node*, int> piece_clusters;
+    for (size_t i = 0; i < pieces.size(); i++) {
+      int cluster_idx =
+          i == 0 ? it.first : (int)NGraphClusterManager::NewCluster();
+      for (int j = pieces[i].first; j < pieces[i].second; j++) {
+        nodes[j]->AddAttr("_ovtf_cluster", cluster_idx);
+        piece_clusters[nodes[j]] = cluster_idx;
+      }
+    }
+
+    int num_copies = 0;
+    for (auto constant : cluster_constants[it.first]) {
+      std::map<int, std::vector<const Edge*>> edges_by_cluster;
+      for (auto edge : constant->out_edges()) {
+        auto piece = piece_clusters.find(edge->dst());
+        if (piece != piece_clusters.end()) {
+          edges_by_cluster[piece->second].push_back(edge);
+        }
+      }
+      if (edges_by_cluster.empty()) continue;
+      auto edges_it = edges_by_cluster.begin();
+      constant->AddAttr("_ovtf_cluster", edges_it->first);
+      for (++edges_it; edges_it != edges_by_cluster.end(); ++edges_it) {
+        Node* copy = graph->CopyNode(constant);
+        copy->set_name(graph->NewName(constant->name()));
+        copy->AddAttr("_ovtf_cluster", edges_it->first);
+        graph->AddControlEdge(graph->source_node(), copy);
+        for (auto edge : edges_it->second) {
+          Node* dst = edge->dst();
+          int dst_input = edge->dst_input();
+          bool is_control = edge->IsControlEdge();
+          graph->RemoveEdge(edge);
+          if (is_control) {
+            graph->AddControlEdge(copy, dst);
+          } else {
+            graph->AddEdge(copy, 0, dst, dst_input);
+          }
+        }
+        num_copies++;
+      }
+    }
+
+    OVTF_VLOG(1) << "Split cluster " << it.first << " of " << num_nodes
+                 << " nodes (" << total_flops << " estimated FLOPs) into "
+                 << pieces.size() << " clusters, duplicating " << num_copies
+                 << " constants";
+    num_split_clusters++;
+  }
+
+  if (api::IsLoggingPlacement()) {
+    std::cout << "OVTF_SUMMARY: Number of clusters split by the size cap: "
+              << num_split_clusters << std::endl;
+  }
+  return Status::OK();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,32 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef OPENVINO_TF_BRIDGE_PARTITION_CLUSTERS_H_
+#define OPENVINO_TF_BRIDGE_PARTITION_CLUSTERS_H_
+#pragma once
+
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Splits the clusters bigger than OPENVINO_TF_MAX_CLUSTER_NODES (nodes other
+// than duplicable constants) or OPENVINO_TF_MAX_CLUSTER_FLOPS (estimated
+// FLOPs) into pieces under the cap, so that no translation or compile grows
+// unbounded. Each piece is a run of consecutive nodes in a topological order
+// of its cluster, cut where the fewest bytes cross. Constants used by several
+// pieces are duplicated into each of them. Runs after AssignClusters.
+Status PartitionClusters(Graph* graph);
+
+// Estimated number of floating point operations of a node, from its
+// "_output_shapes" attribute and the shape of its constant weights. Falls
+// back to 1 per output element, or 1 when the shapes are unknown.
+int64 EstimateNodeFlops(const Node* node);
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_BRIDGE_PARTITION_CLUSTERS_H_
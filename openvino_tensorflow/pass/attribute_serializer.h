@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ngraph/ngraph.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// Writes the attributes of a node to a string, as long as they are all of
+// types it knows
+class AttributeSerializer : public ngraph::AttributeVisitor {
+ public:
+  using ngraph::AttributeVisitor::on_adapter;
+
+  void on_adapter(const std::string& name,
+                  ngraph::ValueAccessor<void>& adapter) override {
+    auto visitor_adapter = dynamic_cast<ngraph::VisitorAdapter*>(&adapter);
+    if (visitor_adapter == nullptr) {
+      m_supported = false;
+      return;
+    }
+    m_stream << name << "{";
+    visitor_adapter->visit_attributes(*this);
+    m_stream << "}";
+  }
+  void on_adapter(const std::string& name,
+                  ngraph::ValueAccessor<std::string>& adapter) override {
+    m_stream << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(const std::string& name,
+                  ngraph::ValueAccessor<bool>& adapter) override {
+    m_stream << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(const std::string& name,
+                  ngraph::ValueAccessor<int64_t>& adapter) override {
+    m_stream << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(const std::string& name,
+                  ngraph::ValueAccessor<double>& adapter) override {
+    m_stream << name << "=" << adapter.get() << ";";
+  }
+  void on_adapter(
+      const std::string& name,
+      ngraph::ValueAccessor<std::vector<int64_t>>& adapter) override {
+    WriteVector(name, adapter.get());
+  }
+  void on_adapter(const std::string& name,
+                  ngraph::ValueAccessor<std::vector<float>>& adapter) override {
+    WriteVector(name, adapter.get());
+  }
+  void on_adapter(
+      const std::string& name,
+      ngraph::ValueAccessor<std::vector<std::string>>& adapter) override {
+    WriteVector(name, adapter.get());
+  }
+
+  bool IsSupported() const { return m_supported; }
+  std::string str() const { return m_stream.str(); }
+
+ private:
+  template <typename T>
+  void WriteVector(const std::string& name, const std::vector<T>& values) {
+    m_stream << name << "=[";
+    for (const auto& value : values) {
+      m_stream << value << ",";
+    }
+    m_stream << "];";
+  }
+
+  std::stringstream m_stream;
+  bool m_supported = true;
+};
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
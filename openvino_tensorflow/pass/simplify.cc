@@ -0,0 +1,272 @@
+/*****************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/rt_info.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/attribute_serializer.h"
+#include "openvino_tensorflow/pass/simplify.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+static bool FeedsResult(const ngraph::Output<ngraph::Node>& output) {
+  for (const auto& input : output.get_target_inputs()) {
+    if (ngraph::is_type<opset::Result>(input.get_node())) return true;
+  }
+  return false;
+}
+
+static bool FeedsResult(const shared_ptr<ngraph::Node>& node) {
+  for (const auto& output : node->outputs()) {
+    if (FeedsResult(output)) return true;
+  }
+  return false;
+}
+
+// Makes the readers of the output of node read replacement instead
+static void ReplaceWith(const shared_ptr<ngraph::Node>& node,
+                        const ngraph::Output<ngraph::Node>& replacement) {
+  node->output(0).replace(replacement);
+}
+
+// Makes the readers of the output of node read new_node instead, which
+// inherits the name and runtime info of node
+static void ReplaceWithNew(const shared_ptr<ngraph::Node>& node,
+                           const shared_ptr<ngraph::Node>& new_node) {
+  new_node->set_friendly_name(node->get_friendly_name());
+  ngraph::copy_runtime_info(node, new_node);
+  node->output(0).replace(new_node->output(0));
+}
+
+bool ConstantDeduplication::run_on_function(shared_ptr<ngraph::Function> f) {
+  bool changed = false;
+  unordered_map<size_t, vector<shared_ptr<opset::Constant>>> constants;
+  for (const auto& node : f->get_ordered_ops()) {
+    auto constant = ngraph::as_type_ptr<opset::Constant>(node);
+    if (constant == nullptr) continue;
+    const auto& type = constant->get_output_element_type(0);
+    // Sub-byte types are packed, leave them alone
+    if (type.bitwidth() < 8) continue;
+
+    size_t num_bytes = ngraph::shape_size(constant->get_shape()) * type.size();
+    auto data = static_cast<const uint8_t*>(constant->get_data_ptr());
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < num_bytes; i++) {
+      hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+
+    auto& candidates = constants[hash];
+    bool replaced = false;
+    if (!FeedsResult(constant)) {
+      for (const auto& candidate : candidates) {
+        if (candidate->get_output_element_type(0) == type &&
+            candidate->get_shape() == constant->get_shape() &&
+            memcmp(candidate->get_data_ptr(), data, num_bytes) == 0) {
+          ReplaceWith(constant, candidate->output(0));
+          replaced = true;
+          break;
+        }
+      }
+    }
+    if (replaced) {
+      changed = true;
+    } else {
+      candidates.push_back(constant);
+    }
+  }
+  return changed;
+}
+
+// Number of bits of the mantissa of a floating point type, including the
+// implicit one
+static size_t MantissaBits(const ngraph::element::Type& type) {
+  if (type == ngraph::element::f16) return 11;
+  if (type == ngraph::element::bf16) return 8;
+  if (type == ngraph::element::f32) return 24;
+  if (type == ngraph::element::f64) return 53;
+  return 0;
+}
+
+// Whether every value of type from is exactly represented in type to
+static bool IsLosslessConversion(const ngraph::element::Type& from,
+                                 const ngraph::element::Type& to) {
+  if (from == to || from == ngraph::element::boolean) return true;
+  if (from.is_real()) {
+    return to.is_real() && MantissaBits(to) > MantissaBits(from) &&
+           to.bitwidth() > from.bitwidth();
+  }
+  if (!from.is_integral_number()) return false;
+  size_t value_bits = from.bitwidth() - (from.is_signed() ? 1 : 0);
+  if (to.is_real()) return MantissaBits(to) >= value_bits;
+  if (!to.is_integral_number()) return false;
+  if (from.is_signed() && !to.is_signed()) return false;
+  return to.bitwidth() - (to.is_signed() ? 1 : 0) >= value_bits;
+}
+
+static bool IsReshapeLike(const shared_ptr<ngraph::Node>& node) {
+  return ngraph::is_type<opset::Reshape>(node) ||
+         ngraph::is_type<opset::Squeeze>(node) ||
+         ngraph::is_type<opset::Unsqueeze>(node);
+}
+
+static bool GetTransposeOrder(const shared_ptr<ngraph::Node>& node,
+                              vector<int64_t>& order) {
+  if (!ngraph::is_type<opset::Transpose>(node)) return false;
+  auto constant = ngraph::as_type_ptr<opset::Constant>(
+      node->input_value(1).get_node_shared_ptr());
+  if (constant == nullptr) return false;
+  order = constant->cast_vector<int64_t>();
+  auto rank = node->get_output_partial_shape(0).rank();
+  if (rank.is_dynamic() || order.size() != (size_t)rank.get_length()) {
+    return false;
+  }
+  for (auto axis : order) {
+    if (axis < 0 || axis >= (int64_t)order.size()) return false;
+  }
+  return true;
+}
+
+static bool IsIdentityOrder(const vector<int64_t>& order) {
+  for (size_t i = 0; i < order.size(); i++) {
+    if (order[i] != (int64_t)i) return false;
+  }
+  return true;
+}
+
+bool RedundantOpElimination::run_on_function(shared_ptr<ngraph::Function> f) {
+  bool changed = false;
+  for (const auto& node : f->get_ordered_ops()) {
+    if (node->get_output_size() != 1 || node->get_input_size() == 0 ||
+        FeedsResult(node->output(0))) {
+      continue;
+    }
+    auto input = node->input_value(0);
+    auto producer = input.get_node_shared_ptr();
+
+    if (ngraph::is_type<opset::Convert>(node)) {
+      const auto& type = node->get_output_element_type(0);
+      if (input.get_element_type() == type) {
+        ReplaceWith(node, input);
+        changed = true;
+      } else if (ngraph::is_type<opset::Convert>(producer) &&
+                 IsLosslessConversion(
+                     producer->get_input_element_type(0),
+                     producer->get_output_element_type(0))) {
+        auto source = producer->input_value(0);
+        if (source.get_element_type() == type) {
+          ReplaceWith(node, source);
+        } else {
+          ReplaceWithNew(node, make_shared<opset::Convert>(source, type));
+        }
+        changed = true;
+      }
+    } else if (IsReshapeLike(node)) {
+      if (!node->get_output_partial_shape(0).is_static() ||
+          !input.get_partial_shape().is_static()) {
+        continue;
+      }
+      const auto& shape = node->get_output_shape(0);
+      if (input.get_shape() == shape) {
+        ReplaceWith(node, input);
+        changed = true;
+      } else if (IsReshapeLike(producer) &&
+                 producer->get_input_partial_shape(0).is_static()) {
+        auto source = producer->input_value(0);
+        if (source.get_shape() == shape) {
+          ReplaceWith(node, source);
+        } else {
+          auto pattern = make_shared<opset::Constant>(
+              ngraph::element::i64, ngraph::Shape{shape.size()},
+              vector<int64_t>(shape.begin(), shape.end()));
+          ReplaceWithNew(node,
+                         make_shared<opset::Reshape>(source, pattern, false));
+        }
+        changed = true;
+      }
+    } else {
+      vector<int64_t> order, inner_order;
+      if (!GetTransposeOrder(node, order)) continue;
+      if (IsIdentityOrder(order)) {
+        ReplaceWith(node, input);
+        changed = true;
+      } else if (GetTransposeOrder(producer, inner_order) &&
+                 inner_order.size() == order.size()) {
+        // Axis i of the result is axis inner_order[order[i]] of the source
+        vector<int64_t> combined(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+          combined[i] = inner_order.at(order[i]);
+        }
+        auto source = producer->input_value(0);
+        if (IsIdentityOrder(combined)) {
+          ReplaceWith(node, source);
+        } else {
+          auto ng_order = make_shared<opset::Constant>(
+              ngraph::element::i64, ngraph::Shape{combined.size()}, combined);
+          ReplaceWithNew(node, make_shared<opset::Transpose>(source, ng_order));
+        }
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+bool CommonSubexpressionElimination::run_on_function(
+    shared_ptr<ngraph::Function> f) {
+  bool changed = false;
+  unordered_map<string, shared_ptr<ngraph::Node>> seen;
+  for (const auto& node : f->get_ordered_ops()) {
+    // Constants are left to ConstantDeduplication
+    if (ngraph::is_type<opset::Parameter>(node) ||
+        ngraph::is_type<opset::Result>(node) ||
+        ngraph::is_type<opset::Constant>(node) ||
+        node->get_output_size() == 0 ||
+        !node->get_control_dependencies().empty()) {
+      continue;
+    }
+    AttributeSerializer serializer;
+    if (!node->visit_attributes(serializer) || !serializer.IsSupported()) {
+      continue;
+    }
+    const auto& type_info = node->get_type_info();
+    stringstream key;
+    key << type_info.name << "/" << type_info.version << "(";
+    for (const auto& input : node->input_values()) {
+      key << static_cast<const void*>(input.get_node()) << ":"
+          << input.get_index() << ",";
+    }
+    key << ")" << serializer.str();
+
+    auto it = seen.find(key.str());
+    if (it == seen.end()) {
+      seen.emplace(key.str(), node);
+      continue;
+    }
+    if (FeedsResult(node)) continue;
+    for (size_t i = 0; i < node->get_output_size(); i++) {
+      node->output(i).replace(it->second->output(i));
+    }
+    OVTF_VLOG(5) << "CSE: " << node->get_friendly_name() << " replaced by "
+                 << it->second->get_friendly_name();
+    changed = true;
+  }
+  return changed;
+}
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
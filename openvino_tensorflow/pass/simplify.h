@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+*****************************************************************************/
+
+#pragma once
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/pass.hpp"
+#include "ngraph/util.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace pass {
+
+// The passes below remove the structural redundancy left by the translation
+// of each op on its own. None of them replaces an output read by a Result, so
+// that the outputs of the function keep their producers and names.
+
+// Replaces the constants of identical type, shape and value by one of them.
+class ConstantDeduplication : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+};
+
+// Removes the Convert, Reshape, Squeeze, Unsqueeze and Transpose ops that
+// don't change their input, and merges the chains of them:
+//   - Convert(Convert(x, T1), T2) becomes Convert(x, T2) when T1 represents
+//     every value of the type of x
+//   - chains of Reshape, Squeeze and Unsqueeze become a single Reshape
+//   - Transpose(Transpose(x, p1), p2) becomes Transpose(x, p1[p2])
+class RedundantOpElimination : public ngraph::pass::FunctionPass {
+ public:
+  RedundantOpElimination() {
+    set_property(ngraph::pass::PassProperty::REQUIRE_STATIC_SHAPE, true);
+  }
+  bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+};
+
+// Replaces the ops of the same type and attributes reading the same inputs
+// by one of them. Ops with attributes that can't be compared are left as is.
+class CommonSubexpressionElimination : public ngraph::pass::FunctionPass {
+ public:
+  bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+};
+
+}  // namespace pass
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -432,6 +432,20 @@ bool TransposeSinking::run_on_function(shared_ptr<ngraph::Function> f) {
   set<shared_ptr<ngraph::Node>> transposes_to_delete;
   unordered_map<std::string, ngraph::Shape> orig_result_out_shape;
 
+  // Without any transpose there is nothing to sink or swim, so skip the
+  // traversals and the revalidation of the whole function
+  bool has_transpose = false;
+  for (auto n : f->get_ops()) {
+    if (ngraph::is_type<opset::Transpose>(n)) {
+      has_transpose = true;
+      break;
+    }
+  }
+  if (!has_transpose) {
+    OVTF_VLOG(4) << "No transpose found, skipping TransposeSinking";
+    return false;
+  }
+
   if (util::DumpAllGraphs()) {
     util::DumpNGGraph(f, f->get_friendly_name() + "_before_TS");
   }
@@ -0,0 +1,476 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/placement_profile.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::map<int, GraphDef> PlacementProfile::s_graphs;
+std::map<int, PlacementProfile::ClusterStats> PlacementProfile::s_cluster_stats;
+std::map<std::string, PlacementProfile::NodeStats>
+    PlacementProfile::s_node_stats;
+std::mutex PlacementProfile::s_mutex;
+
+bool PlacementProfile::IsEnabled() {
+  static const bool enabled =
+      util::GetEnv("OPENVINO_TF_PROFILE_PLACEMENT") == "1";
+  return enabled;
+}
+
+void PlacementProfile::RegisterGraph(int graph_idx, const Graph* graph) {
+  GraphDef graph_def;
+  graph->ToGraphDef(&graph_def);
+  lock_guard<mutex> lock(s_mutex);
+  s_graphs[graph_idx] = move(graph_def);
+}
+
+void PlacementProfile::RecordClusterCall(int cluster_idx, int64 time_us,
+                                         const vector<int64>& input_bytes,
+                                         const vector<int64>& output_bytes) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& stats = s_cluster_stats[cluster_idx];
+  stats.calls++;
+  stats.total_us += time_us;
+  stats.input_bytes.resize(max(stats.input_bytes.size(), input_bytes.size()));
+  for (size_t i = 0; i < input_bytes.size(); i++) {
+    stats.input_bytes[i] += input_bytes[i];
+  }
+  stats.output_bytes.resize(
+      max(stats.output_bytes.size(), output_bytes.size()));
+  for (size_t i = 0; i < output_bytes.size(); i++) {
+    stats.output_bytes[i] += output_bytes[i];
+  }
+}
+
+void PlacementProfile::RecordNodeTimes(const string& node_times) {
+  lock_guard<mutex> lock(s_mutex);
+  for (const auto& line : str_util::Split(node_times, '\n')) {
+    vector<string> fields = str_util::Split(line, '\t');
+    int64 time_us;
+    if (fields.size() != 2 || !strings::safe_strto64(fields[1], &time_us)) {
+      continue;
+    }
+    auto& stats = s_node_stats[fields[0]];
+    stats.calls++;
+    stats.total_us += time_us;
+  }
+}
+
+void PlacementProfile::Reset() {
+  lock_guard<mutex> lock(s_mutex);
+  s_graphs.clear();
+  s_cluster_stats.clear();
+  s_node_stats.clear();
+}
+
+Status PlacementProfile::Export(const string& output_dir,
+                                vector<string>& files) {
+  map<int, GraphDef> graphs;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    graphs = s_graphs;
+  }
+  if (graphs.empty()) {
+    return errors::NotFound(
+        "No encapsulated graph was recorded, set OPENVINO_TF_PROFILE_PLACEMENT "
+        "to 1 before the graphs are rewritten");
+  }
+  for (const auto& it : graphs) {
+    string dot, json;
+    ExportGraph(it.first, it.second, dot, json);
+    string prefix = output_dir + "/ovtf_placement_" + to_string(it.first);
+    for (const auto& file : {make_pair(prefix + ".dot", &dot),
+                             make_pair(prefix + ".json", &json)}) {
+      std::ofstream out(file.first, std::ios_base::trunc);
+      out << *file.second;
+      if (!out) {
+        return errors::Internal("Can't write ", file.first);
+      }
+      files.push_back(file.first);
+    }
+  }
+  return Status::OK();
+}
+
+static string JsonString(const string& str) {
+  std::ostringstream out;
+  out << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if ((unsigned char)c < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c
+          << std::dec;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+  return out.str();
+}
+
+static string HtmlString(const string& str) {
+  string escaped;
+  for (char c : str) {
+    if (c == '<') {
+      escaped += "&lt;";
+    } else if (c == '>') {
+      escaped += "&gt;";
+    } else if (c == '&') {
+      escaped += "&amp;";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+static string FormatBytes(double bytes) {
+  const char* units[] = {"B", "KB", "MB", "GB"};
+  int unit = 0;
+  while (bytes >= 1024 && unit < 3) {
+    bytes /= 1024;
+    unit++;
+  }
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << bytes << " "
+      << units[unit];
+  return out.str();
+}
+
+static string FormatMS(int64 time_us) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3) << time_us / 1000.0 << " ms";
+  return out.str();
+}
+
+// White for no time, red for the most expensive cluster or region
+static string HeatColor(int64 time_us, int64 max_time_us) {
+  double share = max_time_us > 0 ? (double)time_us / max_time_us : 0;
+  int level = 255 - (int)(share * 200);
+  std::ostringstream out;
+  out << "#ff" << std::hex << std::setfill('0') << std::setw(2) << level
+      << std::setw(2) << level;
+  return out.str();
+}
+
+// Splits an input of a NodeDef into the name and the output index of its
+// source. Returns false for control inputs.
+static bool ParseInput(const string& input, string& src, int& src_output) {
+  if (!input.empty() && input[0] == '^') return false;
+  auto pos = input.rfind(':');
+  src_output = 0;
+  if (pos == string::npos ||
+      !strings::safe_strto32(input.substr(pos + 1), &src_output)) {
+    src = input;
+  } else {
+    src = input.substr(0, pos);
+  }
+  return true;
+}
+
+void PlacementProfile::ExportGraph(int graph_idx, const GraphDef& graph_def,
+                                   string& dot, string& json) {
+  map<int, ClusterStats> cluster_stats;
+  map<string, NodeStats> node_stats;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    cluster_stats = s_cluster_stats;
+    node_stats = s_node_stats;
+  }
+
+  // Every node belongs to an entity: its cluster, its fallback region, or
+  // itself for the arguments and return values of functions
+  const int num_nodes = graph_def.node_size();
+  map<string, int> node_ids;
+  for (int i = 0; i < num_nodes; i++) {
+    node_ids[graph_def.node(i).name()] = i;
+  }
+  vector<int> cluster_of(num_nodes, -1);
+  vector<bool> in_region(num_nodes, false);
+  for (int i = 0; i < num_nodes; i++) {
+    const auto& node = graph_def.node(i);
+    if (node.op() == "_nGraphEncapsulate") {
+      // Encapsulate ops without a cluster id are skipped
+      auto it = node.attr().find("ovtf_cluster");
+      if (it != node.attr().end()) cluster_of[i] = it->second.i();
+    } else {
+      in_region[i] = node.op() != "_Arg" && node.op() != "_Retval";
+    }
+  }
+
+  // The fallback regions are the connected sets of nodes left to TF
+  vector<int> parent(num_nodes);
+  std::iota(parent.begin(), parent.end(), 0);
+  std::function<int(int)> find_root = [&](int i) {
+    return parent[i] == i ? i : parent[i] = find_root(parent[i]);
+  };
+  for (int i = 0; i < num_nodes; i++) {
+    if (!in_region[i]) continue;
+    for (const auto& input : graph_def.node(i).input()) {
+      string src;
+      int src_output;
+      if (!ParseInput(input, src, src_output)) continue;
+      auto it = node_ids.find(src);
+      if (it != node_ids.end() && in_region[it->second]) {
+        parent[find_root(it->second)] = find_root(i);
+      }
+    }
+  }
+
+  struct Region {
+    vector<int> nodes;
+    map<string, int> op_types;
+    int64 calls = 0;
+    int64 total_us = 0;
+    bool timed = false;
+  };
+  map<int, int> region_of_root;
+  vector<Region> regions;
+  vector<string> entity_of(num_nodes);
+  for (int i = 0; i < num_nodes; i++) {
+    const auto& node = graph_def.node(i);
+    if (cluster_of[i] >= 0) {
+      entity_of[i] = "cluster_" + to_string(cluster_of[i]);
+      continue;
+    }
+    if (!in_region[i]) {
+      entity_of[i] = "node_" + to_string(i);
+      continue;
+    }
+    int root = find_root(i);
+    if (region_of_root.count(root) == 0) {
+      region_of_root[root] = regions.size();
+      regions.emplace_back();
+    }
+    int region_idx = region_of_root[root];
+    auto& region = regions[region_idx];
+    region.nodes.push_back(i);
+    region.op_types[node.op()]++;
+    auto it = node_stats.find(node.name());
+    if (it != node_stats.end()) {
+      region.timed = true;
+      region.calls = max(region.calls, it->second.calls);
+      region.total_us += it->second.total_us;
+    }
+    entity_of[i] = "region_" + to_string(region_idx);
+  }
+
+  // The edges between two entities, with their bytes per call when the
+  // cluster at one end has been called
+  struct BoundaryEdge {
+    int src;
+    int src_output;
+    int dst;
+    int dst_input;
+    double bytes_per_call;
+  };
+  vector<BoundaryEdge> edges;
+  for (int i = 0; i < num_nodes; i++) {
+    int dst_input = 0;
+    for (const auto& input : graph_def.node(i).input()) {
+      string src_name;
+      int src_output;
+      if (!ParseInput(input, src_name, src_output)) continue;
+      int input_idx = dst_input++;
+      auto it = node_ids.find(src_name);
+      if (it == node_ids.end()) continue;
+      int src = it->second;
+      if (entity_of[src] == entity_of[i]) continue;
+
+      double bytes_per_call = -1;
+      if (cluster_of[i] >= 0 && cluster_stats.count(cluster_of[i])) {
+        const auto& stats = cluster_stats[cluster_of[i]];
+        if (input_idx < (int)stats.input_bytes.size()) {
+          bytes_per_call = (double)stats.input_bytes[input_idx] / stats.calls;
+        }
+      } else if (cluster_of[src] >= 0 && cluster_stats.count(cluster_of[src])) {
+        const auto& stats = cluster_stats[cluster_of[src]];
+        if (src_output < (int)stats.output_bytes.size()) {
+          bytes_per_call = (double)stats.output_bytes[src_output] / stats.calls;
+        }
+      }
+      edges.push_back({src, src_output, i, input_idx, bytes_per_call});
+    }
+  }
+
+  int64 max_time_us = 0;
+  int64 total_time_us = 0;
+  for (int i = 0; i < num_nodes; i++) {
+    if (cluster_of[i] < 0 || cluster_stats.count(cluster_of[i]) == 0) continue;
+    max_time_us = max(max_time_us, cluster_stats[cluster_of[i]].total_us);
+    total_time_us += cluster_stats[cluster_of[i]].total_us;
+  }
+  for (const auto& region : regions) {
+    max_time_us = max(max_time_us, region.total_us);
+    total_time_us += region.total_us;
+  }
+
+  //
+  // DOT export, with the fallback regions collapsed into a single node
+  //
+  std::ostringstream dot_string;
+  dot_string << "digraph G {\n";
+  dot_string << "labelloc=\"t\";\n";
+  dot_string << "label=<<b>openvino_tensorflow placement profile: graph "
+             << graph_idx << "</b><br/>measured time: "
+             << FormatMS(total_time_us) << "<br/><br/>>;\n";
+  for (int i = 0; i < num_nodes; i++) {
+    const auto& node = graph_def.node(i);
+    if (cluster_of[i] >= 0) {
+      const auto& stats = cluster_stats[cluster_of[i]];
+      dot_string << entity_of[i] << " [label=<<b>OpenVINO cluster "
+                 << cluster_of[i] << "</b><br/>" << HtmlString(node.name())
+                 << "<br/>calls: " << stats.calls;
+      if (stats.calls > 0) {
+        dot_string << "<br/>per call: "
+                   << FormatMS(stats.total_us / stats.calls)
+                   << "<br/>total: " << FormatMS(stats.total_us);
+      }
+      dot_string << ">, shape=rect, style=\"filled,bold\", color=\"#0071c5\""
+                 << ", fillcolor=\"" << HeatColor(stats.total_us, max_time_us)
+                 << "\" ];\n";
+    } else if (!in_region[i]) {
+      dot_string << entity_of[i] << " [label=<" << HtmlString(node.op())
+                 << "<br/>" << HtmlString(node.name())
+                 << ">, shape=ellipse ];\n";
+    }
+  }
+  for (size_t r = 0; r < regions.size(); r++) {
+    const auto& region = regions[r];
+    dot_string << "region_" << r << " [label=<<b>TensorFlow region " << r
+               << "</b><br/>" << region.nodes.size() << " nodes:";
+    vector<pair<int, string>> op_types;
+    for (const auto& it : region.op_types) {
+      op_types.push_back({-it.second, it.first});
+    }
+    sort(op_types.begin(), op_types.end());
+    for (size_t i = 0; i < op_types.size() && i < 5; i++) {
+      dot_string << (i == 0 ? " " : ", ") << HtmlString(op_types[i].second)
+                 << "(" << -op_types[i].first << ")";
+    }
+    if (op_types.size() > 5) dot_string << ", ...";
+    if (region.timed) {
+      dot_string << "<br/>steps: " << region.calls;
+      if (region.calls > 0) {
+        dot_string << "<br/>per step: "
+                   << FormatMS(region.total_us / region.calls)
+                   << "<br/>total: " << FormatMS(region.total_us);
+      }
+    } else {
+      dot_string << "<br/>time not recorded";
+    }
+    dot_string << ">, shape=rect, style=\"filled,dashed\", fillcolor=\""
+               << HeatColor(region.total_us, max_time_us) << "\" ];\n";
+  }
+  // Parallel edges between two entities are merged
+  map<pair<string, string>, pair<int, double>> entity_edges;
+  for (const auto& edge : edges) {
+    auto& entity_edge =
+        entity_edges[{entity_of[edge.src], entity_of[edge.dst]}];
+    entity_edge.first++;
+    if (edge.bytes_per_call >= 0) {
+      entity_edge.second = max(0.0, entity_edge.second) + edge.bytes_per_call;
+    } else if (entity_edge.first == 1) {
+      entity_edge.second = -1;
+    }
+  }
+  for (const auto& it : entity_edges) {
+    dot_string << it.first.first << " -> " << it.first.second << " [label=\""
+               << it.second.first
+               << (it.second.first == 1 ? " tensor" : " tensors");
+    if (it.second.second >= 0) {
+      dot_string << "\\n" << FormatBytes(it.second.second) << "/call";
+      // Heavier edges are drawn thicker
+      dot_string << "\", penwidth=\""
+                 << 1 + std::log10(1 + it.second.second) / 2;
+    }
+    dot_string << "\"]\n";
+  }
+  dot_string << "}\n";
+  dot = dot_string.str();
+
+  //
+  // JSON export, with all the nodes of the regions and all the edges
+  //
+  std::ostringstream json_string;
+  json_string << "{\n  \"graph\": " << graph_idx
+              << ",\n  \"measured_time_us\": " << total_time_us
+              << ",\n  \"clusters\": [";
+  bool first = true;
+  for (int i = 0; i < num_nodes; i++) {
+    if (cluster_of[i] < 0) continue;
+    const auto& stats = cluster_stats[cluster_of[i]];
+    json_string << (first ? "\n" : ",\n") << "    {\"cluster\": "
+                << cluster_of[i]
+                << ", \"node\": " << JsonString(graph_def.node(i).name())
+                << ", \"calls\": " << stats.calls
+                << ", \"total_us\": " << stats.total_us << ", \"mean_us\": "
+                << (stats.calls > 0 ? stats.total_us / stats.calls : 0) << "}";
+    first = false;
+  }
+  json_string << "\n  ],\n  \"fallback_regions\": [";
+  for (size_t r = 0; r < regions.size(); r++) {
+    const auto& region = regions[r];
+    json_string << (r == 0 ? "\n" : ",\n") << "    {\"region\": " << r
+                << ", \"timed\": " << (region.timed ? "true" : "false")
+                << ", \"steps\": " << region.calls
+                << ", \"total_us\": " << region.total_us << ", \"mean_us\": "
+                << (region.calls > 0 ? region.total_us / region.calls : 0)
+                << ",\n     \"op_types\": {";
+    bool first_type = true;
+    for (const auto& it : region.op_types) {
+      json_string << (first_type ? "" : ", ") << JsonString(it.first) << ": "
+                  << it.second;
+      first_type = false;
+    }
+    json_string << "},\n     \"nodes\": [";
+    for (size_t i = 0; i < region.nodes.size(); i++) {
+      json_string << (i == 0 ? "" : ", ")
+                  << JsonString(graph_def.node(region.nodes[i]).name());
+    }
+    json_string << "]}";
+  }
+  json_string << "\n  ],\n  \"boundary_edges\": [";
+  for (size_t e = 0; e < edges.size(); e++) {
+    const auto& edge = edges[e];
+    json_string << (e == 0 ? "\n" : ",\n") << "    {\"src\": "
+                << JsonString(graph_def.node(edge.src).name())
+                << ", \"src_output\": " << edge.src_output
+                << ", \"src_entity\": " << JsonString(entity_of[edge.src])
+                << ", \"dst\": " << JsonString(graph_def.node(edge.dst).name())
+                << ", \"dst_input\": " << edge.dst_input
+                << ", \"dst_entity\": " << JsonString(entity_of[edge.dst])
+                << ", \"bytes_per_call\": ";
+    if (edge.bytes_per_call >= 0) {
+      json_string << (int64)edge.bytes_per_call << "}";
+    } else {
+      json_string << "null}";
+    }
+  }
+  json_string << "\n  ]\n}\n";
+  json = json_string.str();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_PLACEMENT_PROFILE_H_
+#define OPENVINO_TF_PLACEMENT_PROFILE_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Collects the encapsulated graphs and the time spent in each of their
+// clusters, and exports them as DOT and JSON files where every cluster and
+// every fallback region (a connected set of nodes left to TensorFlow) is
+// annotated with its time and number of calls, and every edge crossing a
+// cluster boundary with the bytes it carries. Enabled with
+// OPENVINO_TF_PROFILE_PLACEMENT. The time of the fallback regions comes from
+// the node times recorded with RecordNodeTimes(), e.g. from the step stats of
+// a traced session run.
+class PlacementProfile {
+ public:
+  static bool IsEnabled();
+  // Keeps a copy of the encapsulated graph graph_idx
+  static void RegisterGraph(int graph_idx, const Graph* graph);
+  // Records a call of a cluster and the size of its inputs and outputs
+  static void RecordClusterCall(int cluster_idx, int64 time_us,
+                                const std::vector<int64>& input_bytes,
+                                const std::vector<int64>& output_bytes);
+  // Records one step of the given nodes, one "<node name>\t<time in us>"
+  // line per node
+  static void RecordNodeTimes(const std::string& node_times);
+  // Writes ovtf_placement_<graph idx>.dot and .json for every registered
+  // graph to output_dir and returns their paths in files
+  static Status Export(const std::string& output_dir,
+                       std::vector<std::string>& files);
+  static void Reset();
+
+  // Returns the DOT and JSON exports of a graph
+  static void ExportGraph(int graph_idx, const GraphDef& graph_def,
+                          std::string& dot, std::string& json);
+
+ private:
+  struct ClusterStats {
+    int64 calls = 0;
+    int64 total_us = 0;
+    // Total bytes read from each input and written to each output
+    std::vector<int64> input_bytes;
+    std::vector<int64> output_bytes;
+  };
+  struct NodeStats {
+    int64 calls = 0;
+    int64 total_us = 0;
+  };
+
+  static std::map<int, GraphDef> s_graphs;
+  static std::map<int, ClusterStats> s_cluster_stats;
+  static std::map<std::string, NodeStats> s_node_stats;
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_PLACEMENT_PROFILE_H_
@@ -21,6 +21,9 @@
 #include "openvino_tensorflow/encapsulate_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/partition_clusters.h"
+#include "openvino_tensorflow/placement_profile.h"
+#include "openvino_tensorflow/strip_debug_ops.h"
 
 #include "ocm/include/ocm_nodes_checker.h"
 
@@ -53,6 +56,7 @@ mutex NGraphRewritePass::s_serial_counter_mutex;
 //
 // The pass has several phases, each executed in the below sequence:
 //
+//   0. Debug Op Stripping, if enabled [strip_debug_ops.cc]
 //   1. Marking [mark_for_clustering.cc]
 //   2. Cluster Assignment [assign_clusters.cc]
 //   3. Cluster Deassignment [deassign_clusters.cc]
@@ -127,9 +131,18 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
 
     // Now Process the Graph
 
-    // 1. Mark for clustering then, if requested, dump the graphs.
     std::set<string> skip_these_nodes = {};
 
+    // 0. Strip the debug ops if requested, then dump the graphs.
+    StrippedNodeBoundaries stripped_boundaries;
+    if (IsDebugOpStrippingEnabled()) {
+      TF_RETURN_IF_ERROR(
+          StripDebugOps(graph, skip_these_nodes, &stripped_boundaries));
+      util::DumpTFGraph(graph, idx, "stripped");
+    }
+
+    // 1. Mark for clustering then, if requested, dump the graphs.
+
     // OCM call for marking supported nodes
     std::string device;
     BackendManager::GetBackendName(device);
@@ -179,12 +192,25 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
 
     // 2. Assign clusters then, if requested, dump the graphs.
     TF_RETURN_IF_ERROR(AssignClusters(graph));
+    TF_RETURN_IF_ERROR(PartitionClusters(graph));
     util::DumpTFGraph(graph, idx, "clustered");
 
     // 3. Deassign trivial clusters then, if requested, dump the graphs.
     TF_RETURN_IF_ERROR(DeassignClusters(graph));
     util::DumpTFGraph(graph, idx, "declustered");
 
+    if (IsDebugOpStrippingEnabled()) {
+      int avoided_splits =
+          CountAvoidedClusterSplits(graph, stripped_boundaries);
+      OVTF_VLOG(1) << "Cluster splits avoided by stripping debug ops: "
+                   << avoided_splits;
+      if (api::IsLoggingPlacement()) {
+        std::cout << "OVTF_SUMMARY: Number of cluster splits avoided by "
+                     "stripping debug ops: "
+                  << avoided_splits << std::endl;
+      }
+    }
+
     // 4. Encapsulate clusters then, if requested, dump the graphs.
     std::unordered_map<std::string, std::string> config_map;
     auto status = EncapsulateClusters(graph, idx, config_map);
@@ -193,6 +219,9 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
     }
 
     util::DumpTFGraph(graph, idx, "encapsulated");
+    if (PlacementProfile::IsEnabled()) {
+      PlacementProfile::RegisterGraph(idx, graph);
+    }
     return Status::OK();
   }
 };
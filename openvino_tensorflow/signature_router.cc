@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+
+#include "tensorflow/core/lib/strings/strcat.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/signature_router.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+static int GetEnvInt(const string& name, int default_value) {
+  string env = util::GetEnv(name);
+  return env.empty() ? default_value : max(1, atoi(env.c_str()));
+}
+
+SignatureRouter::SignatureRouter(int cluster_id)
+    : m_cluster_id(cluster_id),
+      m_next_id(0),
+      m_probation_calls(GetEnvInt("OPENVINO_TF_ROUTING_PROBATION_CALLS", 5)),
+      m_revalidate_calls(
+          GetEnvInt("OPENVINO_TF_ROUTING_REVALIDATE_CALLS", 1000)) {}
+
+bool SignatureRouter::IsEnabled() {
+  return util::GetEnv("OPENVINO_TF_RUNTIME_ROUTING") == "1";
+}
+
+SignatureRouter::Path SignatureRouter::Next(const string& signature) {
+  auto it = m_states.find(signature);
+  if (it == m_states.end()) {
+    State state;
+    state.id = m_next_id++;
+    OVTF_VLOG(1) << "OPENVINO_TF_ROUTING: cluster_" << m_cluster_id << "/sig_"
+                 << state.id << " is " << signature;
+    it = m_states.emplace(signature, state).first;
+  }
+  State& state = it->second;
+  if (state.decided) {
+    if (++state.calls_since_decision < m_revalidate_calls) {
+      return state.route;
+    }
+    // Start a new probation window
+    state.decided = false;
+    state.calls_since_decision = 0;
+    state.openvino.calls = state.openvino.total_us = 0;
+    state.tf.calls = state.tf.total_us = 0;
+  }
+  // Alternate between the paths, starting with OpenVINO
+  int64 openvino_calls = state.openvino.calls + (state.openvino.warm ? 1 : 0);
+  int64 tf_calls = state.tf.calls + (state.tf.warm ? 1 : 0);
+  return tf_calls < openvino_calls ? Path::TF : Path::OPENVINO;
+}
+
+void SignatureRouter::Record(const string& signature, Path path,
+                             int64 time_us) {
+  auto it = m_states.find(signature);
+  if (it == m_states.end() || it->second.decided) return;
+  State& state = it->second;
+  PathStats& stats = path == Path::OPENVINO ? state.openvino : state.tf;
+  if (!stats.warm) {
+    stats.warm = true;
+    return;
+  }
+  stats.calls++;
+  stats.total_us += time_us;
+  if (state.openvino.calls >= m_probation_calls &&
+      state.tf.calls >= m_probation_calls) {
+    Decide(state);
+  }
+}
+
+void SignatureRouter::Decide(State& state) {
+  int64 openvino_us = max<int64>(1, state.openvino.total_us /
+                                        state.openvino.calls);
+  int64 tf_us = max<int64>(1, state.tf.total_us / state.tf.calls);
+  state.decided = true;
+  state.route = tf_us < openvino_us ? Path::TF : Path::OPENVINO;
+
+  int64 speedup_pct = tf_us * 100 / openvino_us;
+  string prefix = strings::StrCat("routing/cluster_", m_cluster_id, "/sig_",
+                                  state.id, "/");
+  Metrics::Set(prefix + "route", state.route == Path::OPENVINO ? 1 : 0);
+  Metrics::Set(prefix + "speedup_pct", speedup_pct);
+  Metrics::Increment(state.route == Path::OPENVINO ? "routing_openvino_routes"
+                                                   : "routing_tf_routes");
+  OVTF_VLOG(1) << "OPENVINO_TF_ROUTING: cluster_" << m_cluster_id << "/sig_"
+               << state.id << " OpenVINO: " << openvino_us
+               << " us TF: " << tf_us << " us Route: "
+               << (state.route == Path::OPENVINO ? "OpenVINO" : "TF");
+}
+
+void SignatureRouter::Erase(const string& signature) {
+  m_states.erase(signature);
+}
+
+bool SignatureRouter::GetRoute(const string& signature, Path& route) const {
+  auto it = m_states.find(signature);
+  if (it == m_states.end() || !it->second.decided) return false;
+  route = it->second.route;
+  return true;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
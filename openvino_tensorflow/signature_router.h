@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_SIGNATURE_ROUTER_H_
+#define OPENVINO_TF_SIGNATURE_ROUTER_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Routes each input signature of a cluster to the faster of the OpenVINO
+// executable and the native TF fallback. Both paths are timed during a
+// probation window of a few calls each, after which the signature is routed
+// to the faster one. The decision is re-validated with a new probation
+// window every OPENVINO_TF_ROUTING_REVALIDATE_CALLS calls.
+//
+// The decisions are published as metrics named
+// "routing/cluster_<id>/sig_<n>/{route,speedup_pct}", where route is 1 for
+// OpenVINO and 0 for TF, and speedup_pct is the TF time per call in percent
+// of the OpenVINO time. The signature behind sig_<n> is logged at level 1.
+class SignatureRouter {
+ public:
+  enum class Path { OPENVINO, TF };
+
+  explicit SignatureRouter(int cluster_id);
+
+  // Returns true if OPENVINO_TF_RUNTIME_ROUTING is set to 1
+  static bool IsEnabled();
+
+  // Returns the path to use for the next call of signature
+  Path Next(const std::string& signature);
+  // Records the time of a call of signature made with path
+  void Record(const std::string& signature, Path path, int64 time_us);
+  // Forgets signature, e.g. when its executable is evicted
+  void Erase(const std::string& signature);
+
+  // Returns true and sets route if signature has left probation
+  bool GetRoute(const std::string& signature, Path& route) const;
+
+ private:
+  struct PathStats {
+    // The first call of each path loads the network or creates the session
+    // and is not timed
+    bool warm = false;
+    int64 calls = 0;
+    int64 total_us = 0;
+  };
+  struct State {
+    int id;
+    PathStats openvino;
+    PathStats tf;
+    bool decided = false;
+    Path route = Path::OPENVINO;
+    int64 calls_since_decision = 0;
+  };
+
+  void Decide(State& state);
+
+  int m_cluster_id;
+  int m_next_id;
+  int m_probation_calls;
+  int m_revalidate_calls;
+  std::unordered_map<std::string, State> m_states;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_SIGNATURE_ROUTER_H_
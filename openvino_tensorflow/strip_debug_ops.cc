@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <unordered_map>
+
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/strip_debug_ops.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+//
+// Graphs exported from training scripts often carry debug ops that are
+// no-ops at inference time. Some of them are not supported by the backend,
+// so every one of them splits the surrounding cluster in two, and adds a
+// pair of boundary copies. This pass runs before marking and:
+//
+//   1. Bypasses the single-input pass-through ops below, connecting their
+//      producer directly to their consumers. Control edges are forwarded
+//      so that the execution order is preserved.
+//   2. Removes PrintV2 nodes, which have no data outputs.
+//
+// Assertions fail the step on bad data, so they are only stripped when
+// OPENVINO_TF_STRIP_ASSERTS=1: Assert nodes are removed, and CheckNumerics
+// nodes are bypassed like the pass-through ops.
+//
+// Nodes reading from control flow ops or ref tensors, and nodes that sit on
+// a device boundary, are left alone.
+//
+
+static const std::set<string> kPassThroughOps = {
+    "DebugIdentity", "Identity", "PreventGradient",
+    "Print",         "Snapshot", "StopGradient"};
+
+bool IsDebugOpStrippingEnabled() {
+  return util::GetEnv("OPENVINO_TF_STRIP_DEBUG_OPS") == "1";
+}
+
+static bool CanBypass(const Node* node, const Edge** input_edge) {
+  if (node->num_inputs() < 1 || node->num_outputs() != 1) return false;
+  if (IsRefType(node->input_type(0))) return false;
+  if (!node->input_edge(0, input_edge).ok()) return false;
+  const Node* src = (*input_edge)->src();
+  if (src->IsControlFlow() || src->IsSource()) return false;
+  if (src->assigned_device_name() != node->assigned_device_name() ||
+      src->requested_device() != node->requested_device()) {
+    return false;
+  }
+  return true;
+}
+
+Status StripDebugOps(Graph* graph, const std::set<string>& skip_these_nodes,
+                     StrippedNodeBoundaries* boundaries) {
+  bool strip_asserts = util::GetEnv("OPENVINO_TF_STRIP_ASSERTS") == "1";
+  const auto& tf_to_ng_op_map = GetTFToNgOpMap();
+
+  // Nodes are visited in topological order so that the producer of a
+  // bypassed node is never a node that is bypassed later
+  std::vector<Node*> ordered;
+  GetReversePostOrder(*graph, &ordered);
+
+  std::vector<Node*> nodes_to_remove;
+  // Consumers of every bypassed node, used to look through chains of
+  // stripped nodes when recording the boundaries
+  std::unordered_map<int, std::vector<int>> bypassed_consumers;
+  int num_bypassed = 0, num_removed = 0;
+  for (Node* node : ordered) {
+    if (!node->IsOp()) continue;
+    if (skip_these_nodes.find(node->name()) != skip_these_nodes.end()) {
+      continue;
+    }
+    const string& op_type = node->type_string();
+
+    if (op_type == "PrintV2" || (op_type == "Assert" && strip_asserts)) {
+      nodes_to_remove.push_back(node);
+      num_removed++;
+      continue;
+    }
+
+    if (kPassThroughOps.find(op_type) == kPassThroughOps.end() &&
+        !(op_type == "CheckNumerics" && strip_asserts)) {
+      continue;
+    }
+    const Edge* input_edge;
+    if (!CanBypass(node, &input_edge)) continue;
+    Node* src = input_edge->src();
+    int src_output = input_edge->src_output();
+
+    std::vector<const Edge*> in_control_edges;
+    for (const Edge* edge : node->in_edges()) {
+      if (edge->IsControlEdge()) in_control_edges.push_back(edge);
+    }
+    std::vector<const Edge*> out_edges(node->out_edges().begin(),
+                                       node->out_edges().end());
+
+    std::vector<int> consumers;
+    for (const Edge* edge : out_edges) {
+      Node* dst = edge->dst();
+      if (edge->IsControlEdge()) {
+        graph->AddControlEdge(src, dst);
+      } else {
+        int dst_input = edge->dst_input();
+        graph->RemoveEdge(edge);
+        graph->AddEdge(src, src_output, dst, dst_input);
+        consumers.push_back(dst->id());
+      }
+      for (const Edge* control_edge : in_control_edges) {
+        graph->AddControlEdge(control_edge->src(), dst);
+      }
+    }
+
+    bypassed_consumers[node->id()] = consumers;
+    if (tf_to_ng_op_map.find(op_type) == tf_to_ng_op_map.end() &&
+        !consumers.empty()) {
+      boundaries->push_back(std::make_pair(src->id(), consumers));
+    }
+    OVTF_VLOG(4) << "Bypassing " << op_type << " node " << node->name();
+    nodes_to_remove.push_back(node);
+    num_bypassed++;
+  }
+
+  for (auto& boundary : *boundaries) {
+    std::vector<int> consumers;
+    std::vector<int> worklist = boundary.second;
+    while (!worklist.empty()) {
+      int id = worklist.back();
+      worklist.pop_back();
+      auto it = bypassed_consumers.find(id);
+      if (it == bypassed_consumers.end()) {
+        consumers.push_back(id);
+      } else {
+        worklist.insert(worklist.end(), it->second.begin(), it->second.end());
+      }
+    }
+    boundary.second = consumers;
+  }
+
+  for (Node* node : nodes_to_remove) {
+    OVTF_VLOG(4) << "Removing node " << node->name();
+    graph->RemoveNode(node);
+  }
+
+  OVTF_VLOG(1) << "StripDebugOps: bypassed " << num_bypassed
+               << " nodes, removed " << num_removed << " nodes";
+  return Status::OK();
+}
+
+int CountAvoidedClusterSplits(Graph* graph,
+                              const StrippedNodeBoundaries& boundaries) {
+  int num_avoided_splits = 0;
+  for (const auto& boundary : boundaries) {
+    Node* src = graph->FindNodeId(boundary.first);
+    int src_cluster;
+    if (src == nullptr || !GetNodeCluster(src, &src_cluster).ok()) continue;
+    for (int consumer_id : boundary.second) {
+      Node* dst = graph->FindNodeId(consumer_id);
+      int dst_cluster;
+      if (dst != nullptr && GetNodeCluster(dst, &dst_cluster).ok() &&
+          dst_cluster == src_cluster) {
+        num_avoided_splits++;
+        break;
+      }
+    }
+  }
+  return num_avoided_splits;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
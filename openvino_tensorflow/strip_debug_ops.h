@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef OPENVINO_TF_BRIDGE_STRIP_DEBUG_OPS_H_
+#define OPENVINO_TF_BRIDGE_STRIP_DEBUG_OPS_H_
+#pragma once
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// For every stripped node that could not have been clustered itself, holds
+// the id of its producer and the ids of its consumers
+using StrippedNodeBoundaries = std::vector<std::pair<int, std::vector<int>>>;
+
+// Returns true if OPENVINO_TF_STRIP_DEBUG_OPS is set to 1
+bool IsDebugOpStrippingEnabled();
+
+// Bypasses side-effect free debug ops (Print, StopGradient, PreventGradient,
+// Snapshot, Identity...) and removes PrintV2 nodes before marking, so that
+// they do not split the clusters. Assert nodes are removed and CheckNumerics
+// nodes bypassed only if OPENVINO_TF_STRIP_ASSERTS is set to 1. Nodes in
+// skip_these_nodes are left untouched.
+Status StripDebugOps(Graph* graph, const std::set<string>& skip_these_nodes,
+                     StrippedNodeBoundaries* boundaries);
+
+// Returns the number of stripped nodes whose producer and one of the
+// consumers ended up in the same cluster, i.e. the number of cluster splits
+// avoided by StripDebugOps
+int CountAvoidedClusterSplits(Graph* graph,
+                              const StrippedNodeBoundaries& boundaries);
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_BRIDGE_STRIP_DEBUG_OPS_H_
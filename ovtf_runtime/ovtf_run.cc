@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+// Loads an exported cluster bundle with the TF-free runtime, runs it on zero
+// filled inputs and reports the startup time, the inference latency and the
+// peak memory of the process.
+//
+// Usage: ovtf_run <bundle_prefix> [device] [iterations]
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "ovtf_runtime/ovtf_runtime.h"
+
+using namespace std;
+using Clock = chrono::high_resolution_clock;
+
+static double ElapsedInMS(const Clock::time_point& start) {
+  return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+static long PeakRSSInKB() {
+#ifndef _WIN32
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+#else
+  return -1;
+#endif
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <bundle_prefix> [device] [iterations]"
+         << endl;
+    return 1;
+  }
+  string bundle_prefix = argv[1];
+  string device = argc > 2 ? argv[2] : "";
+  int iterations = argc > 3 ? stoi(argv[3]) : 10;
+
+  auto start = Clock::now();
+  try {
+    ovtf_runtime::Model model(bundle_prefix, device);
+    double load_time = ElapsedInMS(start);
+
+    vector<vector<char>> input_data, output_data;
+    vector<const void*> inputs;
+    vector<void*> outputs;
+    for (const auto& spec : model.GetInputs()) {
+      input_data.emplace_back(spec.byte_size, 0);
+      inputs.push_back(input_data.back().data());
+    }
+    for (const auto& spec : model.GetOutputs()) {
+      output_data.emplace_back(spec.byte_size, 0);
+      outputs.push_back(output_data.back().data());
+    }
+
+    auto first_start = Clock::now();
+    model.Run(inputs, outputs);
+    double first_inference_time = ElapsedInMS(first_start);
+    double startup_time = ElapsedInMS(start);
+
+    auto run_start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+      model.Run(inputs, outputs);
+    }
+    double average_time = iterations > 0 ? ElapsedInMS(run_start) / iterations
+                                         : 0;
+
+    cout << "OVTF_RUNTIME: Load-and-compile: " << load_time << " ms" << endl;
+    cout << "OVTF_RUNTIME: First-inference: " << first_inference_time << " ms"
+         << endl;
+    cout << "OVTF_RUNTIME: Startup: " << startup_time << " ms" << endl;
+    cout << "OVTF_RUNTIME: Average-inference: " << average_time << " ms"
+         << endl;
+    cout << "OVTF_RUNTIME: Peak-RSS: " << PeakRSSInKB() << " KB" << endl;
+  } catch (const exception& exp) {
+    cerr << "Failed to run " << bundle_prefix << ": " << exp.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include "ovtf_runtime/ovtf_runtime.h"
+
+using namespace std;
+
+namespace ovtf_runtime {
+
+static InferenceEngine::Precision ToPrecision(const string& element_type) {
+  static const map<string, InferenceEngine::Precision> precisions = {
+      {"f32", InferenceEngine::Precision::FP32},
+      {"f16", InferenceEngine::Precision::FP16},
+      {"u8", InferenceEngine::Precision::U8},
+      {"i8", InferenceEngine::Precision::I8},
+      {"u16", InferenceEngine::Precision::U16},
+      {"i16", InferenceEngine::Precision::I16},
+      {"i32", InferenceEngine::Precision::I32},
+      {"u64", InferenceEngine::Precision::U64},
+      {"i64", InferenceEngine::Precision::I64},
+      {"boolean", InferenceEngine::Precision::BOOL}};
+  auto it = precisions.find(element_type);
+  if (it == precisions.end()) {
+    throw runtime_error("Unsupported element type " + element_type);
+  }
+  return it->second;
+}
+
+static InferenceEngine::Blob::Ptr MakeBlob(const TensorSpec& spec,
+                                           const void* data) {
+  auto precision = ToPrecision(spec.element_type);
+  InferenceEngine::TensorDesc desc(
+      precision, spec.shape,
+      InferenceEngine::TensorDesc::getLayoutByDims(spec.shape));
+  // The blobs never write to the input buffers
+  void* ptr = const_cast<void*>(data);
+  switch (precision) {
+    case InferenceEngine::Precision::FP32:
+      return InferenceEngine::make_shared_blob<float>(desc, (float*)ptr);
+    case InferenceEngine::Precision::FP16:
+    case InferenceEngine::Precision::I16:
+      return InferenceEngine::make_shared_blob<int16_t>(desc, (int16_t*)ptr);
+    case InferenceEngine::Precision::U8:
+    case InferenceEngine::Precision::BOOL:
+      return InferenceEngine::make_shared_blob<uint8_t>(desc, (uint8_t*)ptr);
+    case InferenceEngine::Precision::I8:
+      return InferenceEngine::make_shared_blob<int8_t>(desc, (int8_t*)ptr);
+    case InferenceEngine::Precision::U16:
+      return InferenceEngine::make_shared_blob<uint16_t>(desc, (uint16_t*)ptr);
+    case InferenceEngine::Precision::I32:
+      return InferenceEngine::make_shared_blob<int32_t>(desc, (int32_t*)ptr);
+    case InferenceEngine::Precision::U64:
+      return InferenceEngine::make_shared_blob<uint64_t>(desc, (uint64_t*)ptr);
+    case InferenceEngine::Precision::I64:
+      return InferenceEngine::make_shared_blob<int64_t>(desc, (int64_t*)ptr);
+    default:
+      throw runtime_error("Can't create blob for " + spec.name);
+  }
+}
+
+// Parses "<name> <element type> [d0,d1,...]" into spec
+static void ParseTensorSpec(istringstream& line, TensorSpec& spec) {
+  string shape;
+  line >> spec.name >> spec.element_type >> shape;
+  if (shape.size() < 2 || shape.front() != '[' || shape.back() != ']') {
+    throw runtime_error("Malformed shape " + shape + " for " + spec.name);
+  }
+  spec.shape.clear();
+  istringstream dims(shape.substr(1, shape.size() - 2));
+  string dim;
+  size_t num_elements = 1;
+  while (getline(dims, dim, ',')) {
+    spec.shape.push_back(stoul(dim));
+    num_elements *= spec.shape.back();
+  }
+  spec.byte_size = num_elements * ToPrecision(spec.element_type).size();
+}
+
+void Model::ParseSignature(const string& sig_path, const string& bundle_dir) {
+  ifstream sig_file(sig_path);
+  if (!sig_file.is_open()) {
+    throw runtime_error("Unable to open " + sig_path);
+  }
+
+  string line;
+  getline(sig_file, line);
+  if (line != "ovtf_bundle 1") {
+    throw runtime_error(sig_path + " is not a supported bundle signature");
+  }
+
+  while (getline(sig_file, line)) {
+    istringstream line_stream(line);
+    string kind;
+    line_stream >> kind;
+    if (kind == "device") {
+      line_stream >> m_device;
+    } else if (kind == "input" || kind == "skipped_input" ||
+               kind == "output") {
+      size_t position;
+      line_stream >> position;
+      auto& specs = (kind == "output") ? m_outputs : m_inputs;
+      if (position != specs.size()) {
+        throw runtime_error("Unexpected position in " + sig_path + ": " +
+                            line);
+      }
+      TensorSpec spec;
+      if (kind == "skipped_input") {
+        spec.skipped = true;
+      } else {
+        ParseTensorSpec(line_stream, spec);
+      }
+      specs.push_back(spec);
+    } else if (kind == "hoisted") {
+      HoistedParam param;
+      string data_file;
+      ParseTensorSpec(line_stream, param.spec);
+      line_stream >> data_file;
+      ifstream data_stream(bundle_dir + data_file, ios::binary);
+      param.data.resize(param.spec.byte_size);
+      if (!data_stream.read(param.data.data(), param.data.size())) {
+        throw runtime_error("Unable to read " + bundle_dir + data_file);
+      }
+      m_hoisted_params.push_back(move(param));
+    } else if (!kind.empty()) {
+      throw runtime_error("Unexpected entry in " + sig_path + ": " + line);
+    }
+  }
+}
+
+Model::Model(const string& bundle_prefix, const string& device) {
+  auto pos = bundle_prefix.find_last_of("/\\");
+  string bundle_dir =
+      (pos == string::npos) ? "" : bundle_prefix.substr(0, pos + 1);
+  ParseSignature(bundle_prefix + ".sig", bundle_dir);
+  if (!device.empty()) m_device = device;
+
+  auto network =
+      m_core.ReadNetwork(bundle_prefix + ".xml", bundle_prefix + ".bin");
+
+  auto inputs_info = network.getInputsInfo();
+  for (const auto& spec : m_inputs) {
+    if (spec.skipped) continue;
+    auto it = inputs_info.find(spec.name);
+    if (it == inputs_info.end()) {
+      throw runtime_error("Input " + spec.name + " not found in the IR");
+    }
+    it->second->setPrecision(ToPrecision(spec.element_type));
+  }
+  auto outputs_info = network.getOutputsInfo();
+  for (const auto& spec : m_outputs) {
+    auto it = outputs_info.find(spec.name);
+    if (it == outputs_info.end()) {
+      throw runtime_error("Output " + spec.name + " not found in the IR");
+    }
+    it->second->setPrecision(ToPrecision(spec.element_type));
+  }
+
+  m_exe_network = m_core.LoadNetwork(network, m_device);
+  m_infer_req = m_exe_network.CreateInferRequest();
+  for (auto& param : m_hoisted_params) {
+    m_infer_req.SetBlob(param.spec.name,
+                        MakeBlob(param.spec, param.data.data()));
+  }
+}
+
+void Model::Run(const vector<const void*>& inputs,
+                const vector<void*>& outputs) {
+  if (inputs.size() != m_inputs.size() || outputs.size() != m_outputs.size()) {
+    throw runtime_error("Expected " + to_string(m_inputs.size()) +
+                        " inputs and " + to_string(m_outputs.size()) +
+                        " outputs");
+  }
+  for (size_t i = 0; i < m_inputs.size(); i++) {
+    if (m_inputs[i].skipped) continue;
+    m_infer_req.SetBlob(m_inputs[i].name, MakeBlob(m_inputs[i], inputs[i]));
+  }
+  for (size_t i = 0; i < m_outputs.size(); i++) {
+    m_infer_req.SetBlob(m_outputs[i].name,
+                        MakeBlob(m_outputs[i], outputs[i]));
+  }
+  m_infer_req.Infer();
+}
+
+}  // namespace ovtf_runtime
+
+struct ovtf_model {
+  std::unique_ptr<ovtf_runtime::Model> model;
+};
+
+static thread_local std::string g_last_error;
+
+ovtf_model* ovtf_model_load(const char* bundle_prefix, const char* device) {
+  try {
+    std::unique_ptr<ovtf_model> model(new ovtf_model);
+    model->model.reset(
+        new ovtf_runtime::Model(bundle_prefix, device ? device : ""));
+    return model.release();
+  } catch (const std::exception& exp) {
+    g_last_error = exp.what();
+    return nullptr;
+  }
+}
+
+void ovtf_model_free(ovtf_model* model) { delete model; }
+
+size_t ovtf_model_num_inputs(const ovtf_model* model) {
+  return model->model->GetInputs().size();
+}
+
+size_t ovtf_model_num_outputs(const ovtf_model* model) {
+  return model->model->GetOutputs().size();
+}
+
+size_t ovtf_model_input_byte_size(const ovtf_model* model, size_t index) {
+  return model->model->GetInputs().at(index).byte_size;
+}
+
+size_t ovtf_model_output_byte_size(const ovtf_model* model, size_t index) {
+  return model->model->GetOutputs().at(index).byte_size;
+}
+
+int ovtf_model_run(ovtf_model* model, const void* const* inputs,
+                   void* const* outputs) {
+  try {
+    std::vector<const void*> input_ptrs(
+        inputs, inputs + model->model->GetInputs().size());
+    std::vector<void*> output_ptrs(outputs,
+                                   outputs + model->model->GetOutputs().size());
+    model->model->Run(input_ptrs, output_ptrs);
+    return 0;
+  } catch (const std::exception& exp) {
+    g_last_error = exp.what();
+    return -1;
+  }
+}
+
+const char* ovtf_last_error() { return g_last_error.c_str(); }
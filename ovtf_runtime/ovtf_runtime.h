@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+// Minimal runtime for the cluster bundles exported by
+// openvino_tensorflow.export_ir(). A bundle is made of <prefix>.xml,
+// <prefix>.bin and <prefix>.sig, the latter describing the inputs and outputs
+// of the cluster in the order used by TensorFlow. The runtime only depends on
+// the OpenVINO™ Inference Engine, so a fully offloaded model can be deployed
+// without the TensorFlow runtime.
+
+#ifndef OVTF_RUNTIME_H_
+#define OVTF_RUNTIME_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+namespace ovtf_runtime {
+
+struct TensorSpec {
+  // Name of the tensor in the IR, empty for skipped inputs
+  std::string name;
+  // nGraph element type name, e.g. "f32"
+  std::string element_type;
+  std::vector<size_t> shape;
+  size_t byte_size = 0;
+  // Inputs not used by the cluster are kept so that the positions match
+  // the TensorFlow graph, but their data is ignored
+  bool skipped = false;
+};
+
+class Model {
+ public:
+  // Loads the bundle and compiles it for the device. If device is empty, the
+  // device recorded in the bundle is used. Throws std::runtime_error on
+  // failure.
+  explicit Model(const std::string& bundle_prefix,
+                 const std::string& device = "");
+
+  const std::vector<TensorSpec>& GetInputs() const { return m_inputs; }
+  const std::vector<TensorSpec>& GetOutputs() const { return m_outputs; }
+
+  // inputs[i] and outputs[i] must point to buffers of
+  // GetInputs()[i].byte_size and GetOutputs()[i].byte_size bytes.
+  // The inputs of skipped tensors may be null.
+  void Run(const std::vector<const void*>& inputs,
+           const std::vector<void*>& outputs);
+
+ private:
+  void ParseSignature(const std::string& sig_path,
+                      const std::string& bundle_dir);
+
+  struct HoistedParam {
+    TensorSpec spec;
+    std::vector<char> data;
+  };
+
+  std::string m_device;
+  std::vector<TensorSpec> m_inputs;
+  std::vector<TensorSpec> m_outputs;
+  std::vector<HoistedParam> m_hoisted_params;
+  InferenceEngine::Core m_core;
+  InferenceEngine::ExecutableNetwork m_exe_network;
+  InferenceEngine::InferRequest m_infer_req;
+};
+
+}  // namespace ovtf_runtime
+
+extern "C" {
+#endif  // __cplusplus
+
+typedef struct ovtf_model ovtf_model;
+
+// Returns NULL on failure, see ovtf_last_error()
+ovtf_model* ovtf_model_load(const char* bundle_prefix, const char* device);
+void ovtf_model_free(ovtf_model* model);
+
+size_t ovtf_model_num_inputs(const ovtf_model* model);
+size_t ovtf_model_num_outputs(const ovtf_model* model);
+size_t ovtf_model_input_byte_size(const ovtf_model* model, size_t index);
+size_t ovtf_model_output_byte_size(const ovtf_model* model, size_t index);
+
+// Returns 0 on success, see ovtf_last_error() otherwise
+int ovtf_model_run(ovtf_model* model, const void* const* inputs,
+                   void* const* outputs);
+
+// Message of the last error raised in the calling thread
+const char* ovtf_last_error();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // OVTF_RUNTIME_H_
@@ -38,7 +38,8 @@ __all__ = [
     'is_grappler_enabled', 'update_config',
     'set_disabled_ops', 'get_disabled_ops',
     'enable_dynamic_fallback', 'disable_dynamic_fallback',
-    'export_ir',
+    'export_ir', 'get_metrics', 'reset_metrics', 'get_model_usage',
+    'record_step_stats', 'export_placement_profile', 'reset_placement_profile',
 ]
 
 if system() == 'Darwin':
@@ -137,6 +138,19 @@ if ovtf_classic_loaded:
     openvino_tensorflow_lib.freeClusterInfo.restype = ctypes.c_void_p
     openvino_tensorflow_lib.freeErrMsg.argtypes = []
     openvino_tensorflow_lib.freeErrMsg.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.get_metrics.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.get_metrics.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.freeMetrics.argtypes = []
+    openvino_tensorflow_lib.freeMetrics.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.get_model_usage.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.get_model_usage.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.freeModelUsage.argtypes = []
+    openvino_tensorflow_lib.freeModelUsage.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.record_node_times.argtypes = [ctypes.c_char_p]
+    openvino_tensorflow_lib.export_placement_profile.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.POINTER(ctypes.c_char_p)]
+    openvino_tensorflow_lib.export_placement_profile.restype = ctypes.c_bool
+    openvino_tensorflow_lib.freePlacementFiles.argtypes = []
+    openvino_tensorflow_lib.freePlacementFiles.restype = ctypes.c_void_p
 
     def enable():
         openvino_tensorflow_lib.enable()
@@ -188,7 +202,12 @@ if ovtf_classic_loaded:
     def is_grappler_enabled():
         return openvino_tensorflow_lib.is_grappler_enabled()
 
-    def update_config(config, backend_name = "CPU", device_id = ""):
+    def update_config(config, backend_name = "CPU", device_id = "",
+                      model_tag = "", model_quotas = None):
+        # model_tag groups the graphs run with this config into one model,
+        # whose resources are limited by model_quotas, a dict with the
+        # optional keys "max_cache_mb", "max_concurrent_compiles" and
+        # "max_threads_per_network"
         #updating session config if grappler is enabled
         if(openvino_tensorflow_lib.is_grappler_enabled()):
             opt_name = 'ovtf-optimizer'
@@ -205,6 +224,10 @@ if ovtf_classic_loaded:
             ovtf_optimizer = rewriter_options.custom_optimizers.add()
             ovtf_optimizer.name = opt_name
             ovtf_optimizer.parameter_map["device_id"].s = device_id.encode()
+            if model_tag:
+                ovtf_optimizer.parameter_map["model_tag"].s = model_tag.encode()
+            for key, value in (model_quotas or {}).items():
+                ovtf_optimizer.parameter_map[key].s = str(value).encode()
             config.MergeFrom(tf.compat.v1.ConfigProto(graph_options=tf.compat.v1.GraphOptions(rewrite_options=rewriter_options)))
             # For reference, if we want to provide configuration support(backend parameters)
             # in a python script using the ovtf-optimizer
@@ -243,6 +266,61 @@ if ovtf_classic_loaded:
 
         return cluster_string
 
+    def get_metrics():
+        metrics = ctypes.c_char_p()
+        openvino_tensorflow_lib.get_metrics(ctypes.byref(metrics))
+        metrics_string = metrics.value.decode("utf-8")
+        openvino_tensorflow_lib.freeMetrics()
+        result = {}
+        for line in metrics_string.splitlines():
+            name, value = line.rsplit(" ", 1)
+            result[name] = int(value)
+        return result
+
+    def reset_metrics():
+        openvino_tensorflow_lib.reset_metrics()
+
+    def get_model_usage():
+        usage = ctypes.c_char_p()
+        openvino_tensorflow_lib.get_model_usage(ctypes.byref(usage))
+        usage_string = usage.value.decode("utf-8")
+        openvino_tensorflow_lib.freeModelUsage()
+        result = {}
+        for line in usage_string.splitlines():
+            model, counter = line.split("\t", 1)
+            name, value = counter.rsplit(" ", 1)
+            result.setdefault(model, {})[name] = int(value)
+        return result
+
+    def record_step_stats(run_metadata):
+        # Records the time of every node of a step traced with
+        # tf.compat.v1.RunOptions(trace_level=FULL_TRACE), to annotate the
+        # fallback regions of the placement profile
+        node_times = {}
+        for dev_stats in run_metadata.step_stats.dev_stats:
+            for node_stats in dev_stats.node_stats:
+                name = node_stats.node_name.split(":")[0]
+                node_times[name] = node_times.get(name, 0) + \
+                    node_stats.op_end_rel_micros - node_stats.op_start_rel_micros
+        openvino_tensorflow_lib.record_node_times("\n".join(
+            "%s\t%d" % item for item in node_times.items()).encode("utf-8"))
+
+    def export_placement_profile(output_dir, run_metadata=None):
+        if run_metadata is not None:
+            record_step_stats(run_metadata)
+        files = ctypes.c_char_p()
+        err_msg = ctypes.c_char_p()
+        if not openvino_tensorflow_lib.export_placement_profile(output_dir.encode("utf-8"), ctypes.byref(files), ctypes.byref(err_msg)):
+            err_string = err_msg.value.decode("utf-8")
+            openvino_tensorflow_lib.freeErrMsg()
+            raise Exception("Cannot export the placement profile: "+err_string)
+        files_string = files.value.decode("utf-8")
+        openvino_tensorflow_lib.freePlacementFiles()
+        return files_string.splitlines()
+
+    def reset_placement_profile():
+        openvino_tensorflow_lib.reset_placement_profile()
+
     __version__ = \
     "OpenVINO integration with TensorFlow version: " + str(openvino_tensorflow_lib.version()) + "\n" + \
     "OpenVINO version used for this build: " + str(openvino_tensorflow_lib.openvino_version()) + "\n" + \
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/deassign_clusters.h"
+#include "openvino_tensorflow/encapsulate_clusters.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+struct RewriteResult {
+  Status status;
+  int num_encapsulates = 0;
+  int cluster_idx = -1;
+  int num_abs_in_cluster = 0;
+  bool trivial_cluster_deassigned = false;
+};
+
+// Builds, for every graph, a non-trivial cluster
+//
+//   const ---> abs_0 ---> ... ---> abs_<chain_length - 1> ---> identity
+//
+// and a trivial one
+//
+//   const_trivial ---> neg ---> identity_trivial
+//
+// where both identities are left unmarked, then runs cluster assignment,
+// deassignment and encapsulation on it.
+static void RewriteGraph(int graph_id, int chain_length,
+                         RewriteResult* result) {
+  Graph g(OpRegistry::Global());
+  Tensor t_input(DT_FLOAT, TensorShape{2, 3});
+
+  auto build = [&]() -> Status {
+    Node* prev;
+    TF_RETURN_IF_ERROR(NodeBuilder("const", "Const")
+                           .Attr("dtype", DT_FLOAT)
+                           .Attr("value", t_input)
+                           .Attr("_ovtf_marked_for_clustering", true)
+                           .Finalize(&g, &prev));
+    g.AddEdge(g.source_node(), Graph::kControlSlot, prev, Graph::kControlSlot);
+    for (int i = 0; i < chain_length; i++) {
+      TF_RETURN_IF_ERROR(NodeBuilder("abs_" + to_string(i), "Abs")
+                             .Input(prev, 0)
+                             .Attr("T", DT_FLOAT)
+                             .Attr("_ovtf_marked_for_clustering", true)
+                             .Finalize(&g, &prev));
+    }
+    Node* identity;
+    TF_RETURN_IF_ERROR(NodeBuilder("identity", "Identity")
+                           .Input(prev, 0)
+                           .Attr("T", DT_FLOAT)
+                           .Finalize(&g, &identity));
+    g.AddEdge(identity, Graph::kControlSlot, g.sink_node(),
+              Graph::kControlSlot);
+
+    Node* const_trivial;
+    TF_RETURN_IF_ERROR(NodeBuilder("const_trivial", "Const")
+                           .Attr("dtype", DT_FLOAT)
+                           .Attr("value", t_input)
+                           .Attr("_ovtf_marked_for_clustering", true)
+                           .Finalize(&g, &const_trivial));
+    g.AddEdge(g.source_node(), Graph::kControlSlot, const_trivial,
+              Graph::kControlSlot);
+    Node* neg;
+    TF_RETURN_IF_ERROR(NodeBuilder("neg", "Neg")
+                           .Input(const_trivial, 0)
+                           .Attr("T", DT_FLOAT)
+                           .Attr("_ovtf_marked_for_clustering", true)
+                           .Finalize(&g, &neg));
+    Node* identity_trivial;
+    TF_RETURN_IF_ERROR(NodeBuilder("identity_trivial", "Identity")
+                           .Input(neg, 0)
+                           .Attr("T", DT_FLOAT)
+                           .Finalize(&g, &identity_trivial));
+    g.AddEdge(identity_trivial, Graph::kControlSlot, g.sink_node(),
+              Graph::kControlSlot);
+
+    TF_RETURN_IF_ERROR(AssignClusters(&g));
+    TF_RETURN_IF_ERROR(DeassignClusters(&g));
+    int neg_cluster;
+    result->trivial_cluster_deassigned =
+        !GetNodeCluster(neg, &neg_cluster).ok();
+
+    std::unordered_map<std::string, std::string> config_map;
+    return EncapsulateClusters(&g, graph_id, config_map);
+  };
+  result->status = build();
+  if (!result->status.ok()) return;
+
+  for (auto node : g.op_nodes()) {
+    if (node->type_string() != "_nGraphEncapsulate") continue;
+    result->num_encapsulates++;
+    result->status = GetNodeAttr(node->attrs(), "ovtf_cluster",
+                                 &result->cluster_idx);
+    if (!result->status.ok()) return;
+  }
+  GraphDef* cluster_graph =
+      NGraphClusterManager::GetClusterGraph(result->cluster_idx);
+  if (cluster_graph == nullptr) return;
+  for (const auto& node_def : cluster_graph->node()) {
+    if (node_def.op() == "Abs") result->num_abs_in_cluster++;
+  }
+}
+
+// Rewrites independent graphs from several threads at once, the way
+// concurrently created sessions do, and checks that every graph gets its own
+// cluster with exactly its own nodes.
+TEST(ConcurrentRewrite, IndependentGraphs) {
+  auto env_map = StoreEnv({"OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS",
+                           "OPENVINO_TF_MIN_NONTRIVIAL_NODES"});
+  UnsetEnvVariable("OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS");
+  UnsetEnvVariable("OPENVINO_TF_MIN_NONTRIVIAL_NODES");
+
+  const int num_threads = 8;
+  const int num_rounds = 4;
+  for (int round = 0; round < num_rounds; round++) {
+    std::vector<RewriteResult> results(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+      // Different chain lengths so that mixed up clusters are detected
+      threads.emplace_back(RewriteGraph, round * num_threads + i, 10 + i,
+                           &results[i]);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    std::set<int> cluster_indices;
+    for (int i = 0; i < num_threads; i++) {
+      ASSERT_OK(results[i].status);
+      ASSERT_EQ(results[i].num_encapsulates, 1);
+      ASSERT_TRUE(results[i].trivial_cluster_deassigned);
+      ASSERT_EQ(results[i].num_abs_in_cluster, 10 + i);
+      cluster_indices.insert(results[i].cluster_idx);
+    }
+    ASSERT_EQ(cluster_indices.size(), (size_t)num_threads);
+  }
+
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -10,6 +10,7 @@
 
 #include "openvino_tensorflow/cluster_manager.h"
 #include "openvino_tensorflow/encapsulate_clusters.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
 #include "openvino_tensorflow/version.h"
 #include "test/test_utilities.h"
 
@@ -264,6 +265,222 @@ TEST(EncapsulateClusters, PopulateLibrary) {
   // No Add or Const nodes left in the graph
   ASSERT_EQ(num_tf_nodes, 0);
 }
+
+// The static inputs of the encapsulate are found from the nodes inside the
+// cluster
+//  x ------> reshape(0) <------ shape
+TEST(EncapsulateClusters, StaticInputs) {
+  NGraphClusterManager::EvictAllClusters();
+  Graph g(OpRegistry::Global());
+
+  Tensor t_x(DT_FLOAT, TensorShape{2, 3});
+  Tensor t_shape(DT_INT32, TensorShape{1});
+  t_shape.flat<int32>().data()[0] = 6;
+
+  int cluster_idx = NGraphClusterManager::NewCluster();
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_x)
+                .Finalize(&g, &x));
+
+  Node* shape;
+  ASSERT_OK(NodeBuilder("shape", "Const")
+                .Attr("dtype", DT_INT32)
+                .Attr("value", t_shape)
+                .Finalize(&g, &shape));
+
+  Node* reshape;
+  ASSERT_OK(NodeBuilder("reshape", "Reshape")
+                .Input(x, 0)
+                .Input(shape, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("Tshape", DT_INT32)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_idx)
+                .Attr("_ovtf_static_inputs", std::vector<int32>{1})
+                .Finalize(&g, &reshape));
+
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(reshape, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &abs));
+
+  std::unordered_map<std::string, std::string> config_map;
+  ASSERT_OK(EncapsulateClusters(&g, 0, config_map));
+
+  // reshape reads from the args in the cluster graph
+  auto subgraph = NGraphClusterManager::GetClusterGraph(cluster_idx);
+  bool found_reshape = false;
+  for (int i = 0; i < subgraph->node_size(); i++) {
+    if (subgraph->node(i).name() == "reshape") {
+      found_reshape = true;
+      ASSERT_EQ(subgraph->node(i).input_size(), 2);
+      ASSERT_EQ(subgraph->node(i).input(0), "ngraph_input_0");
+      ASSERT_EQ(subgraph->node(i).input(1), "ngraph_input_1");
+    }
+  }
+  ASSERT_TRUE(found_reshape);
+
+  int num_encapsulates = 0;
+  for (auto node : g.op_nodes()) {
+    if (node->type_string() != "_nGraphEncapsulate") continue;
+    num_encapsulates++;
+    std::vector<int32> static_inputs;
+    ASSERT_OK(
+        GetNodeAttr(node->attrs(), "_ovtf_static_inputs", &static_inputs));
+    ASSERT_EQ(static_inputs, std::vector<int32>{1});
+  }
+  ASSERT_EQ(num_encapsulates, 1);
+}
+
+// The inputs read through different identities are merged, and the inputs
+// only read by nodes that no output of the cluster depends on are pruned
+//
+//  x ---> identity_a ---> add(0) ---> abs
+//  | |                     ^
+//  | '--> identity_b ------'
+//  |
+//  '----> neg(0) ---> sqrt(0) - - -> (control edge to sink)
+TEST(EncapsulateClusters, CanonicalInputs) {
+  NGraphClusterManager::EvictAllClusters();
+  Metrics::Reset();
+  Graph g(OpRegistry::Global());
+
+  Tensor t_x(DT_FLOAT, TensorShape{2, 3});
+  int cluster_idx = NGraphClusterManager::NewCluster();
+
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_x)
+                .Finalize(&g, &x));
+  Node* identity_a;
+  ASSERT_OK(NodeBuilder("identity_a", "Identity")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &identity_a));
+  Node* identity_b;
+  ASSERT_OK(NodeBuilder("identity_b", "Identity")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &identity_b));
+  Node* add;
+  ASSERT_OK(NodeBuilder("add", "Add")
+                .Input(identity_a, 0)
+                .Input(identity_b, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_idx)
+                .Finalize(&g, &add));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(add, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &abs));
+  Node* neg;
+  ASSERT_OK(NodeBuilder("neg", "Neg")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_idx)
+                .Finalize(&g, &neg));
+  Node* sqrt;
+  ASSERT_OK(NodeBuilder("sqrt", "Sqrt")
+                .Input(neg, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_idx)
+                .Finalize(&g, &sqrt));
+  g.AddControlEdge(sqrt, g.sink_node());
+
+  std::unordered_map<std::string, std::string> config_map;
+  ASSERT_OK(EncapsulateClusters(&g, 0, config_map));
+
+  // One arg for x, add and one retval
+  auto subgraph = NGraphClusterManager::GetClusterGraph(cluster_idx);
+  ASSERT_EQ(subgraph->node_size(), 3);
+  for (int i = 0; i < subgraph->node_size(); i++) {
+    const auto& node_def = subgraph->node(i);
+    ASSERT_NE(node_def.name(), "neg");
+    ASSERT_NE(node_def.name(), "sqrt");
+    if (node_def.name() == "add") {
+      ASSERT_EQ(node_def.input(0), "ngraph_input_0");
+      ASSERT_EQ(node_def.input(1), "ngraph_input_0");
+    }
+  }
+  ASSERT_EQ(Metrics::Get("merged_cluster_inputs"), 1);
+  ASSERT_EQ(Metrics::Get("pruned_cluster_inputs"), 1);
+
+  // The encapsulate reads x directly, and keeps the control edge of sqrt
+  int num_encapsulates = 0;
+  for (auto node : g.op_nodes()) {
+    if (node->type_string() != "_nGraphEncapsulate") continue;
+    num_encapsulates++;
+    ASSERT_EQ(node->num_inputs(), 1);
+    const Edge* edge;
+    ASSERT_OK(node->input_edge(0, &edge));
+    ASSERT_EQ(edge->src(), x);
+    bool found_sink = false;
+    for (auto out_edge : node->out_edges()) {
+      found_sink |= out_edge->IsControlEdge() && out_edge->dst()->IsSink();
+    }
+    ASSERT_TRUE(found_sink);
+  }
+  ASSERT_EQ(num_encapsulates, 1);
+}
+
+// Encapsulates a chain of 2k nodes split in blocks of 100 nodes. Every fifth
+// block is left unclustered, the others form one cluster each. The time taken
+// on larger graphs is measured by tools/encapsulate_large_graph.py.
+TEST(EncapsulateClusters, LargeGraph) {
+  NGraphClusterManager::EvictAllClusters();
+  Graph g(OpRegistry::Global());
+
+  const int num_nodes = 2000;
+  const int block_size = 100;
+
+  Tensor t_input(DT_FLOAT, TensorShape{2, 3});
+  Node* prev;
+  ASSERT_OK(NodeBuilder("input", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_input)
+                .Finalize(&g, &prev));
+
+  int num_clusters = 0, num_unclustered = 1;
+  int cluster_idx = -1;
+  for (int i = 0; i < num_nodes - 1; i++) {
+    int block = i / block_size;
+    bool clustered = (block % 5 != 4);
+    if (clustered && i % block_size == 0) {
+      cluster_idx = NGraphClusterManager::NewCluster();
+      num_clusters++;
+    }
+    NodeBuilder nb = NodeBuilder("abs_" + to_string(i), "Abs")
+                         .Input(prev, 0)
+                         .Attr("T", DT_FLOAT);
+    if (clustered) {
+      nb.Attr("_ovtf_marked_for_clustering", true)
+          .Attr("_ovtf_cluster", cluster_idx);
+    } else {
+      num_unclustered++;
+    }
+    ASSERT_OK(nb.Finalize(&g, &prev));
+  }
+  ASSERT_EQ(g.num_op_nodes(), num_nodes);
+
+  std::unordered_map<std::string, std::string> config_map;
+  ASSERT_OK(EncapsulateClusters(&g, 0, config_map));
+
+  ASSERT_EQ(g.num_op_nodes(), num_unclustered + num_clusters);
+  for (int i = 0; i < num_clusters; i++) {
+    // block_size nodes, one arg and one retval
+    ASSERT_EQ(NGraphClusterManager::GetClusterGraph(i)->node_size(),
+              block_size + 2);
+  }
+}
 }
 }
 }
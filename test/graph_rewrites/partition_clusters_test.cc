@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/partition_clusters.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// const ---> abs_0 ---> ... ---> abs_4 ---> add ---> identity
+//   |                                        ^
+//   '----------------------------------------'
+//
+// where everything but the identity is marked. The "_output_shapes" of abs_2
+// make its output much smaller than the others, so that it is the cheapest
+// place to cut.
+static Status BuildChain(Graph* g, Node** nodes) {
+  Tensor t_input(DT_FLOAT, TensorShape{100});
+  Node* constant;
+  TF_RETURN_IF_ERROR(NodeBuilder("const", "Const")
+                         .Attr("dtype", DT_FLOAT)
+                         .Attr("value", t_input)
+                         .Attr("_ovtf_marked_for_clustering", true)
+                         .Finalize(g, &constant));
+  Node* prev = constant;
+  for (int i = 0; i < 5; i++) {
+    // The shapes are only read by the estimates of the partitioner
+    std::vector<PartialTensorShape> shapes = {
+        PartialTensorShape({i == 2 ? 1 : 100})};
+    TF_RETURN_IF_ERROR(NodeBuilder("abs_" + to_string(i), "Abs")
+                           .Input(prev, 0)
+                           .Attr("T", DT_FLOAT)
+                           .Attr("_output_shapes", shapes)
+                           .Attr("_ovtf_marked_for_clustering", true)
+                           .Finalize(g, &nodes[i]));
+    prev = nodes[i];
+  }
+  TF_RETURN_IF_ERROR(NodeBuilder("add", "Add")
+                         .Input(prev, 0)
+                         .Input(constant, 0)
+                         .Attr("T", DT_FLOAT)
+                         .Attr("_ovtf_marked_for_clustering", true)
+                         .Finalize(g, &nodes[5]));
+  Node* identity;
+  TF_RETURN_IF_ERROR(NodeBuilder("identity", "Identity")
+                         .Input(nodes[5], 0)
+                         .Attr("T", DT_FLOAT)
+                         .Finalize(g, &identity));
+  nodes[6] = constant;
+  return Status::OK();
+}
+
+TEST(PartitionClusters, NoCap) {
+  auto env_map = StoreEnv(
+      {"OPENVINO_TF_MAX_CLUSTER_NODES", "OPENVINO_TF_MAX_CLUSTER_FLOPS"});
+  UnsetEnvVariable("OPENVINO_TF_MAX_CLUSTER_NODES");
+  UnsetEnvVariable("OPENVINO_TF_MAX_CLUSTER_FLOPS");
+
+  Graph g(OpRegistry::Global());
+  Node* nodes[7];
+  ASSERT_OK(BuildChain(&g, nodes));
+  ASSERT_OK(AssignClusters(&g));
+  ASSERT_OK(PartitionClusters(&g));
+
+  int first_cluster, cluster;
+  ASSERT_OK(GetNodeCluster(nodes[0], &first_cluster));
+  for (int i = 1; i < 7; i++) {
+    ASSERT_OK(GetNodeCluster(nodes[i], &cluster));
+    ASSERT_EQ(cluster, first_cluster);
+  }
+
+  RestoreEnv(env_map);
+}
+
+TEST(PartitionClusters, CutAtSmallestTensor) {
+  auto env_map = StoreEnv(
+      {"OPENVINO_TF_MAX_CLUSTER_NODES", "OPENVINO_TF_MAX_CLUSTER_FLOPS"});
+  SetEnvVariable("OPENVINO_TF_MAX_CLUSTER_NODES", "4");
+  UnsetEnvVariable("OPENVINO_TF_MAX_CLUSTER_FLOPS");
+
+  Graph g(OpRegistry::Global());
+  Node* nodes[7];
+  ASSERT_OK(BuildChain(&g, nodes));
+  int num_op_nodes = g.num_op_nodes();
+  ASSERT_OK(AssignClusters(&g));
+  ASSERT_OK(PartitionClusters(&g));
+
+  // The first cluster stops after abs_2 rather than growing to the cap
+  int clusters[7];
+  for (int i = 0; i < 7; i++) {
+    ASSERT_OK(GetNodeCluster(nodes[i], &clusters[i]));
+  }
+  ASSERT_EQ(clusters[0], clusters[1]);
+  ASSERT_EQ(clusters[0], clusters[2]);
+  ASSERT_NE(clusters[2], clusters[3]);
+  ASSERT_EQ(clusters[3], clusters[4]);
+  ASSERT_EQ(clusters[3], clusters[5]);
+
+  // The constant stays with abs_0, and add reads a copy in its own cluster
+  ASSERT_EQ(clusters[6], clusters[0]);
+  ASSERT_EQ(g.num_op_nodes(), num_op_nodes + 1);
+  const Edge* edge;
+  ASSERT_OK(nodes[5]->input_edge(1, &edge));
+  ASSERT_NE(edge->src(), nodes[6]);
+  ASSERT_EQ(edge->src()->type_string(), "Const");
+  int copy_cluster;
+  ASSERT_OK(GetNodeCluster(edge->src(), &copy_cluster));
+  ASSERT_EQ(copy_cluster, clusters[5]);
+
+  RestoreEnv(env_map);
+}
+
+TEST(PartitionClusters, EstimateNodeFlops) {
+  Graph g(OpRegistry::Global());
+  Tensor t_weights(DT_FLOAT, TensorShape{8, 16});
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Finalize(&g, &x));
+  Node* weights;
+  ASSERT_OK(NodeBuilder("weights", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_weights)
+                .Finalize(&g, &weights));
+  std::vector<PartialTensorShape> shapes = {PartialTensorShape({4, 16})};
+  Node* matmul;
+  ASSERT_OK(NodeBuilder("matmul", "MatMul")
+                .Input(x, 0)
+                .Input(weights, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shapes)
+                .Finalize(&g, &matmul));
+  Node* relu;
+  ASSERT_OK(NodeBuilder("relu", "Relu")
+                .Input(matmul, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_output_shapes", shapes)
+                .Finalize(&g, &relu));
+  Node* neg;
+  ASSERT_OK(NodeBuilder("neg", "Neg")
+                .Input(relu, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &neg));
+
+  // 2 * 8 FLOPs for each of the 4 x 16 outputs
+  ASSERT_EQ(EstimateNodeFlops(matmul), 1024);
+  ASSERT_EQ(EstimateNodeFlops(relu), 64);
+  ASSERT_EQ(EstimateNodeFlops(neg), 1);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/strip_debug_ops.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// const(0) ---> CheckNumerics ---> StopGradient ---> abs ---> identity
+//                                                     ^
+//                                                     |
+//                                             assert -+ (control)
+TEST(StripDebugOps, BypassAndRemove) {
+  auto env_map = StoreEnv({"OPENVINO_TF_STRIP_ASSERTS"});
+  SetEnvVariable("OPENVINO_TF_STRIP_ASSERTS", "1");
+
+  Graph g(OpRegistry::Global());
+
+  Tensor t_input(DT_FLOAT, TensorShape{2, 3});
+  Tensor t_cond(DT_BOOL, TensorShape{});
+  t_cond.scalar<bool>()() = true;
+
+  Node* node1;
+  ASSERT_OK(NodeBuilder("node1", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_input)
+                .Finalize(&g, &node1));
+
+  Node* check;
+  ASSERT_OK(NodeBuilder("check", "CheckNumerics")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("message", "nan found")
+                .Finalize(&g, &check));
+
+  Node* stop;
+  ASSERT_OK(NodeBuilder("stop", "StopGradient")
+                .Input(check, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &stop));
+
+  Node* cond;
+  ASSERT_OK(NodeBuilder("cond", "Const")
+                .Attr("dtype", DT_BOOL)
+                .Attr("value", t_cond)
+                .Finalize(&g, &cond));
+
+  Node* assert_node;
+  ASSERT_OK(NodeBuilder("assert", "Assert")
+                .Input(cond, 0)
+                .Input(std::vector<NodeBuilder::NodeOut>{{node1, 0}})
+                .Attr("T", {DT_FLOAT})
+                .Finalize(&g, &assert_node));
+
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(stop, 0)
+                .ControlInput(assert_node)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &abs));
+
+  // The last Identity is preserved, e.g. because it is a fetch node
+  Node* identity;
+  ASSERT_OK(NodeBuilder("identity", "Identity")
+                .Input(abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &identity));
+
+  ASSERT_EQ(g.num_op_nodes(), 7);
+
+  StrippedNodeBoundaries boundaries;
+  ASSERT_OK(StripDebugOps(&g, {"identity"}, &boundaries));
+
+  // CheckNumerics, StopGradient and Assert are gone
+  ASSERT_EQ(g.num_op_nodes(), 4);
+  for (auto node : g.op_nodes()) {
+    ASSERT_NE(node->type_string(), "CheckNumerics");
+    ASSERT_NE(node->type_string(), "StopGradient");
+    ASSERT_NE(node->type_string(), "Assert");
+  }
+
+  // abs now reads directly from the const
+  const Edge* abs_input;
+  ASSERT_OK(abs->input_edge(0, &abs_input));
+  ASSERT_EQ(abs_input->src(), node1);
+
+  // The identity is left untouched
+  const Edge* identity_input;
+  ASSERT_OK(identity->input_edge(0, &identity_input));
+  ASSERT_EQ(identity_input->src(), abs);
+
+  // Neither CheckNumerics nor StopGradient can be translated, so both of
+  // them are recorded as cluster boundaries
+  ASSERT_EQ(boundaries.size(), 2u);
+
+  // Nothing has been clustered
+  ASSERT_EQ(CountAvoidedClusterSplits(&g, boundaries), 0);
+
+  RestoreEnv(env_map);
+}
+
+TEST(StripDebugOps, KeepAssertByDefault) {
+  auto env_map = StoreEnv({"OPENVINO_TF_STRIP_ASSERTS"});
+  UnsetEnvVariable("OPENVINO_TF_STRIP_ASSERTS");
+
+  Graph g(OpRegistry::Global());
+
+  Tensor t_input(DT_FLOAT, TensorShape{2, 3});
+  Node* input;
+  ASSERT_OK(NodeBuilder("input", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_input)
+                .Finalize(&g, &input));
+
+  // CheckNumerics is an assertion as well
+  Node* check;
+  ASSERT_OK(NodeBuilder("check", "CheckNumerics")
+                .Input(input, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("message", "nan found")
+                .Finalize(&g, &check));
+
+  Tensor t_cond(DT_BOOL, TensorShape{});
+  t_cond.scalar<bool>()() = true;
+
+  Node* cond;
+  ASSERT_OK(NodeBuilder("cond", "Const")
+                .Attr("dtype", DT_BOOL)
+                .Attr("value", t_cond)
+                .Finalize(&g, &cond));
+
+  Node* assert_node;
+  ASSERT_OK(NodeBuilder("assert", "Assert")
+                .Input(cond, 0)
+                .Input(std::vector<NodeBuilder::NodeOut>{{cond, 0}})
+                .Attr("T", {DT_BOOL})
+                .Finalize(&g, &assert_node));
+
+  StrippedNodeBoundaries boundaries;
+  ASSERT_OK(StripDebugOps(&g, {}, &boundaries));
+  ASSERT_EQ(g.num_op_nodes(), 4);
+  ASSERT_EQ(boundaries.size(), 0u);
+
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/manager.hpp"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/pass/simplify.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+template <class TPass>
+static void RunPass(const shared_ptr<ngraph::Function>& func) {
+  ngraph::pass::Manager pass_manager;
+  pass_manager.register_pass<TPass>();
+  pass_manager.run_passes(func);
+}
+
+//  X    C1    C2 (same value as C1)
+//   \  /  \  /
+//   Add    Add
+//     \    /
+//      Mul
+TEST(Simplify, ConstantsAndCSE) {
+  auto x = make_shared<opset::Parameter>(ngraph::element::f32,
+                                         ngraph::Shape{2, 3});
+  auto c1 = make_shared<opset::Constant>(ngraph::element::f32, ngraph::Shape{},
+                                         vector<float>{2});
+  auto c2 = make_shared<opset::Constant>(ngraph::element::f32, ngraph::Shape{},
+                                         vector<float>{2});
+  auto add1 = make_shared<opset::Add>(x, c1);
+  auto add2 = make_shared<opset::Add>(x, c2);
+  auto mul = make_shared<opset::Multiply>(add1, add2);
+  auto func = make_shared<ngraph::Function>(ngraph::OutputVector{mul},
+                                            ngraph::ParameterVector{x});
+
+  RunPass<pass::ConstantDeduplication>(func);
+  ASSERT_EQ(count_ops_of_type<opset::Constant>(func), 1);
+  ASSERT_EQ(count_ops_of_type<opset::Add>(func), 2);
+
+  RunPass<pass::CommonSubexpressionElimination>(func);
+  ASSERT_EQ(count_ops_of_type<opset::Add>(func), 1);
+  ASSERT_EQ(mul->input_value(0), mul->input_value(1));
+}
+
+// Ops of different attributes are not merged
+TEST(Simplify, CSEComparesAttributes) {
+  auto x = make_shared<opset::Parameter>(ngraph::element::f32,
+                                         ngraph::Shape{2, 3});
+  auto axes = make_shared<opset::Constant>(ngraph::element::i64,
+                                           ngraph::Shape{1}, vector<int64>{1});
+  auto sum1 = make_shared<opset::ReduceSum>(x, axes, true);
+  auto sum2 = make_shared<opset::ReduceSum>(x, axes, false);
+  auto sum3 = make_shared<opset::ReduceSum>(x, axes, false);
+  auto func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{make_shared<opset::Abs>(sum1),
+                           make_shared<opset::Abs>(sum2),
+                           make_shared<opset::Abs>(sum3)},
+      ngraph::ParameterVector{x});
+
+  RunPass<pass::CommonSubexpressionElimination>(func);
+  ASSERT_EQ(count_ops_of_type<opset::ReduceSum>(func), 2);
+  // The Abs reading sum2 and sum3 now read the same op, but they feed
+  // results, so they are kept
+  ASSERT_EQ(count_ops_of_type<opset::Abs>(func), 3);
+}
+
+// X (f16) -> Convert (f32) -> Convert (f16) -> Transpose -> Transpose ->
+// Reshape -> Unsqueeze -> Abs
+TEST(Simplify, RedundantOps) {
+  auto x = make_shared<opset::Parameter>(ngraph::element::f16,
+                                         ngraph::Shape{2, 3, 4});
+  auto to_f32 = make_shared<opset::Convert>(x, ngraph::element::f32);
+  auto to_f16 = make_shared<opset::Convert>(to_f32, ngraph::element::f16);
+  auto order1 = make_shared<opset::Constant>(
+      ngraph::element::i64, ngraph::Shape{3}, vector<int64>{1, 2, 0});
+  auto transpose1 = make_shared<opset::Transpose>(to_f16, order1);
+  auto order2 = make_shared<opset::Constant>(
+      ngraph::element::i64, ngraph::Shape{3}, vector<int64>{2, 0, 1});
+  auto transpose2 = make_shared<opset::Transpose>(transpose1, order2);
+  auto shape = make_shared<opset::Constant>(
+      ngraph::element::i64, ngraph::Shape{2}, vector<int64>{6, 4});
+  auto reshape = make_shared<opset::Reshape>(transpose2, shape, false);
+  auto axis = make_shared<opset::Constant>(ngraph::element::i64,
+                                           ngraph::Shape{1}, vector<int64>{0});
+  auto unsqueeze = make_shared<opset::Unsqueeze>(reshape, axis);
+  auto abs = make_shared<opset::Abs>(unsqueeze);
+  auto func = make_shared<ngraph::Function>(ngraph::OutputVector{abs},
+                                            ngraph::ParameterVector{x});
+
+  RunPass<pass::RedundantOpElimination>(func);
+  ASSERT_EQ(count_ops_of_type<opset::Convert>(func), 0);
+  ASSERT_EQ(count_ops_of_type<opset::Transpose>(func), 0);
+  ASSERT_EQ(count_ops_of_type<opset::Unsqueeze>(func), 0);
+  ASSERT_EQ(count_ops_of_type<opset::Reshape>(func), 1);
+  auto new_reshape = abs->input_value(0).get_node_shared_ptr();
+  ASSERT_TRUE(ngraph::is_type<opset::Reshape>(new_reshape));
+  ASSERT_EQ(new_reshape->input_value(0), x->output(0));
+  ASSERT_EQ(abs->get_output_shape(0), (ngraph::Shape{1, 6, 4}));
+}
+
+// A conversion that loses values is kept
+TEST(Simplify, LossyConvertKept) {
+  auto x = make_shared<opset::Parameter>(ngraph::element::f32,
+                                         ngraph::Shape{2});
+  auto to_i32 = make_shared<opset::Convert>(x, ngraph::element::i32);
+  auto to_f32 = make_shared<opset::Convert>(to_i32, ngraph::element::f32);
+  auto func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{make_shared<opset::Abs>(to_f32)},
+      ngraph::ParameterVector{x});
+
+  RunPass<pass::RedundantOpElimination>(func);
+  ASSERT_EQ(count_ops_of_type<opset::Convert>(func), 2);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -12,6 +12,8 @@ tf.compat.v1.disable_eager_execution()
 import numpy as np
 import pytest
 
+import openvino_tensorflow
+
 from common import NgraphTest
 
 
@@ -66,3 +68,59 @@ class TestCropAndResize(NgraphTest):
                 self.without_ngraph(run_test), self.with_ngraph(run_test), 1e-5,
                 1e-6):
             raise AssertionError
+
+    def test_crop_and_resize_runtime_boxes(self):
+
+        BATCH_SIZE = 2
+        NUM_BOXES = 5
+        IMAGE_HEIGHT = 32
+        IMAGE_WIDTH = 24
+        CHANNELS = 3
+        CROP_SIZE = (7, 7)
+        NUM_STEPS = 4
+
+        image = np.random.normal(
+            size=(BATCH_SIZE, IMAGE_HEIGHT, IMAGE_WIDTH, CHANNELS))
+        # Flipped boxes and boxes partly outside of the image included
+        boxes = [
+            np.random.uniform(size=(NUM_BOXES, 4), low=-0.2, high=1.2)
+            for _ in range(NUM_STEPS)
+        ]
+        box_indices = [
+            np.random.randint(size=(NUM_BOXES,), low=0, high=BATCH_SIZE)
+            for _ in range(NUM_STEPS)
+        ]
+        image_ph = tf.compat.v1.placeholder(tf.float32, image.shape)
+        boxes_ph = tf.compat.v1.placeholder(tf.float32, (NUM_BOXES, 4))
+        box_indices_ph = tf.compat.v1.placeholder(tf.int32, (NUM_BOXES,))
+        outputs = [
+            tf.image.crop_and_resize(
+                image_ph,
+                boxes_ph,
+                box_indices_ph,
+                CROP_SIZE,
+                method=method,
+                extrapolation_value=0.5) for method in ["bilinear", "nearest"]
+        ]
+
+        def run_test(sess):
+            return [
+                sess.run(
+                    outputs,
+                    feed_dict={
+                        image_ph: image,
+                        boxes_ph: boxes[i],
+                        box_indices_ph: box_indices[i]
+                    }) for i in range(NUM_STEPS)
+            ]
+
+        openvino_tensorflow.reset_metrics()
+        ngraph_results = self.with_ngraph(run_test)
+        # The boxes are fed at runtime, so every step reuses the executable
+        # compiled by the first one
+        assert openvino_tensorflow.get_metrics().get("compiled_executables",
+                                                     0) == 1
+        tf_results = self.without_ngraph(run_test)
+        for ngraph_step, tf_step in zip(ngraph_results, tf_results):
+            for ngraph_output, tf_output in zip(ngraph_step, tf_step):
+                assert np.allclose(ngraph_output, tf_output, 1e-4, 1e-5)
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/compile_scheduler.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(CompileScheduler, ConcurrencyLimit) {
+  auto env_map = StoreEnv({"OPENVINO_TF_MAX_CONCURRENT_COMPILES",
+                           "OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB"});
+  SetEnvVariable("OPENVINO_TF_MAX_CONCURRENT_COMPILES", "1");
+  UnsetEnvVariable("OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB");
+  ASSERT_TRUE(CompileScheduler::IsEnabled());
+  Metrics::Reset();
+
+  auto first = CompileScheduler::TryAdmit(0);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(CompileScheduler::TryAdmit(0), nullptr);
+
+  // A queued compile starts once the running one is done
+  atomic<bool> admitted(false);
+  thread waiter([&admitted]() {
+    auto ticket = CompileScheduler::Admit(0, []() { return false; });
+    admitted = ticket != nullptr;
+  });
+  this_thread::sleep_for(chrono::milliseconds(50));
+  EXPECT_FALSE(admitted);
+  first.reset();
+  waiter.join();
+  ASSERT_TRUE(admitted);
+  ASSERT_EQ(Metrics::Get("compile_queue_waits"), 1);
+  ASSERT_GT(Metrics::Get("compile_queue_wait_us"), 0);
+
+  // A cancelled compile leaves the queue
+  first = CompileScheduler::TryAdmit(0);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(CompileScheduler::Admit(0, []() { return true; }), nullptr);
+  ASSERT_EQ(Metrics::Get("compile_queue_abandoned"), 1);
+  first.reset();
+  ASSERT_NE(CompileScheduler::TryAdmit(0), nullptr);
+
+  Metrics::Reset();
+  RestoreEnv(env_map);
+}
+
+TEST(CompileScheduler, MemoryBudget) {
+  auto env_map = StoreEnv({"OPENVINO_TF_MAX_CONCURRENT_COMPILES",
+                           "OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB"});
+  UnsetEnvVariable("OPENVINO_TF_MAX_CONCURRENT_COMPILES");
+  SetEnvVariable("OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB", "1");
+  ASSERT_TRUE(CompileScheduler::IsEnabled());
+
+  // A compile larger than the budget still runs on its own
+  const int64 mb = 1024 * 1024;
+  auto large = CompileScheduler::TryAdmit(2 * mb);
+  ASSERT_NE(large, nullptr);
+  ASSERT_EQ(CompileScheduler::TryAdmit(1), nullptr);
+  large.reset();
+
+  auto half = CompileScheduler::TryAdmit(mb / 2);
+  ASSERT_NE(half, nullptr);
+  auto other_half = CompileScheduler::TryAdmit(mb / 2);
+  ASSERT_NE(other_half, nullptr);
+  ASSERT_EQ(CompileScheduler::TryAdmit(1), nullptr);
+
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/public/version.h"
+
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/compile_scheduler.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/ie_tensor.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// Runs an encapsulate op computing Abs on its input, with the cancellation
+// manager of each step given by the test
+class AbsEncapsulate {
+ public:
+  Status Init() {
+    int cluster = NGraphClusterManager::NewCluster();
+    Graph graph(OpRegistry::Global());
+    Node* arg;
+    TF_RETURN_IF_ERROR(NodeBuilder("arg", "_Arg")
+                           .Attr("T", DT_FLOAT)
+                           .Attr("index", 0)
+                           .Finalize(&graph, &arg));
+    Node* abs;
+    TF_RETURN_IF_ERROR(NodeBuilder("abs", "Abs")
+                           .Input(arg, 0)
+                           .Attr("T", DT_FLOAT)
+                           .Finalize(&graph, &abs));
+    Node* ret;
+    TF_RETURN_IF_ERROR(NodeBuilder("ret", "_Retval")
+                           .Input(abs, 0)
+                           .Attr("T", DT_FLOAT)
+                           .Attr("index", 0)
+                           .Finalize(&graph, &ret));
+    graph.ToGraphDef(NGraphClusterManager::GetClusterGraph(cluster));
+
+    NodeDef node_def;
+    TF_RETURN_IF_ERROR(NodeDefBuilder("encapsulate", "_nGraphEncapsulate")
+                           .Input(FakeInput(DataTypeVector{DT_FLOAT}))
+                           .Attr("Tresults", DataTypeVector{DT_FLOAT})
+                           .Attr("ovtf_cluster", cluster)
+                           .Attr("ngraph_graph_id", 0)
+                           .Finalize(&node_def));
+    m_device = DeviceFactory::NewDevice("CPU", SessionOptions(),
+                                        "/job:localhost/replica:0/task:0");
+    Status status;
+    m_kernel = CreateOpKernel(DEVICE_CPU, m_device.get(),
+                              m_device->GetAllocator(AllocatorAttributes()),
+                              node_def, TF_GRAPH_DEF_VERSION, &status);
+    return status;
+  }
+
+  Status Run(Tensor input, CancellationManager* cancellation_manager,
+             Tensor* output = nullptr) {
+    gtl::InlinedVector<TensorValue, 4> inputs{TensorValue(&input)};
+    AllocatorAttributes output_attr;
+    OpKernelContext::Params params;
+    params.device = m_device.get();
+    params.op_kernel = m_kernel.get();
+    params.inputs = &inputs;
+    params.output_attr_array = &output_attr;
+    params.cancellation_manager = cancellation_manager;
+    OpKernelContext ctx(&params);
+    m_kernel->Compute(&ctx);
+    if (ctx.status().ok() && output != nullptr) {
+      *output = *ctx.mutable_output(0);
+    }
+    return ctx.status();
+  }
+
+ private:
+  std::unique_ptr<Device> m_device;
+  std::unique_ptr<OpKernel> m_kernel;
+};
+
+static Tensor MakeInput() {
+  Tensor input(DT_FLOAT, TensorShape({2, 3}));
+  AssignInputValues<float>(input, {-1.0f, 2.0f, -3.0f, 4.0f, -5.0f, 6.0f});
+  return input;
+}
+
+TEST(EncapsulateCancellation, CancelledBeforeExecuting) {
+  // The steps would otherwise fall back to TF instead of failing
+  NGraphClusterManager::DisableClusterFallback();
+  AbsEncapsulate encapsulate;
+  ASSERT_OK(encapsulate.Init());
+  Metrics::Reset();
+
+  CancellationManager cancellation_manager;
+  cancellation_manager.StartCancel();
+  Status status = encapsulate.Run(MakeInput(), &cancellation_manager);
+  ASSERT_TRUE(errors::IsCancelled(status)) << status;
+  ASSERT_EQ(Metrics::Get("cancelled_steps"), 1);
+  ASSERT_EQ(Metrics::Get("compiled_executables"), 0);
+
+  Metrics::Reset();
+  NGraphClusterManager::EnableClusterFallback();
+}
+
+TEST(EncapsulateCancellation, CancelledWhileWaitingToCompile) {
+  auto env_map = StoreEnv({"OPENVINO_TF_MAX_CONCURRENT_COMPILES",
+                           "OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB"});
+  SetEnvVariable("OPENVINO_TF_MAX_CONCURRENT_COMPILES", "1");
+  UnsetEnvVariable("OPENVINO_TF_COMPILE_MEMORY_BUDGET_MB");
+  NGraphClusterManager::DisableClusterFallback();
+  AbsEncapsulate encapsulate;
+  ASSERT_OK(encapsulate.Init());
+  Metrics::Reset();
+
+  // The only compile slot is taken, so the step waits in the queue until
+  // it is cancelled
+  auto ticket = CompileScheduler::TryAdmit(0);
+  ASSERT_NE(ticket, nullptr);
+  CancellationManager waiting_manager;
+  Status waiting_status;
+  thread step([&]() {
+    waiting_status = encapsulate.Run(MakeInput(), &waiting_manager);
+  });
+  this_thread::sleep_for(chrono::milliseconds(100));
+  waiting_manager.StartCancel();
+  step.join();
+  ASSERT_TRUE(errors::IsCancelled(waiting_status)) << waiting_status;
+  ASSERT_EQ(Metrics::Get("cancelled_steps"), 1);
+  ASSERT_EQ(Metrics::Get("abandoned_compiles"), 1);
+  ASSERT_EQ(Metrics::Get("compile_queue_abandoned"), 1);
+  ASSERT_EQ(Metrics::Get("compiled_executables"), 0);
+
+  // Nothing was cached, the next step compiles once the slot is free
+  ticket.reset();
+  CancellationManager manager;
+  Tensor output;
+  ASSERT_OK(encapsulate.Run(MakeInput(), &manager, &output));
+  ASSERT_EQ(Metrics::Get("compiled_executables"), 1);
+  auto values = output.flat<float>();
+  for (int i = 0; i < values.size(); i++) {
+    ASSERT_EQ(values(i), float(i + 1));
+  }
+
+  // The callback of a finished step is deregistered
+  manager.StartCancel();
+  ASSERT_EQ(Metrics::Get("cancelled_steps"), 1);
+  CancellationManager next_manager;
+  ASSERT_OK(encapsulate.Run(MakeInput(), &next_manager));
+  ASSERT_EQ(Metrics::Get("compiled_executables"), 1);
+
+  Metrics::Reset();
+  NGraphClusterManager::EnableClusterFallback();
+  RestoreEnv(env_map);
+}
+
+TEST(EncapsulateCancellation, CancelledInference) {
+  auto param =
+      make_shared<opset::Parameter>(ngraph::element::f32, ngraph::Shape{2, 3});
+  auto abs = make_shared<opset::Abs>(param);
+  auto func = make_shared<ngraph::Function>(ngraph::OutputVector{abs},
+                                            ngraph::ParameterVector{param});
+  Executable exec(func, "CPU", "CPU");
+  ASSERT_FALSE(exec.IsHostEvaluated());
+
+  vector<float> data{-1.0f, 2.0f, -3.0f, 4.0f, -5.0f, 6.0f};
+  vector<shared_ptr<ngraph::runtime::Tensor>> inputs{make_shared<IETensor>(
+      ngraph::element::f32, ngraph::Shape{2, 3}, data.data())};
+
+  // A call cancelled by the callback of its step throws without inferring
+  IE_InferCancellation cancelled;
+  cancelled.Cancel();
+  vector<shared_ptr<ngraph::runtime::Tensor>> outputs;
+  ASSERT_ANY_THROW(exec.Call(inputs, outputs, false, &cancelled));
+
+  // and leaves the next calls of the executable alone
+  IE_InferCancellation live;
+  outputs.clear();
+  ASSERT_TRUE(exec.Call(inputs, outputs, false, &live));
+  ASSERT_FALSE(live.IsCancelled());
+  ASSERT_EQ(outputs.size(), 1u);
+  vector<float> values(6);
+  outputs[0]->read(values.data(), values.size() * sizeof(float));
+  ASSERT_EQ(values, (vector<float>{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}));
+  // The request is unbound at the end of the call
+  ASSERT_NO_THROW(live.Cancel());
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/ie_tensor.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// data (f32) ---> ShapeOf ---> StridedSlice[1:2] ---> Range(0, dim, 1)
+static shared_ptr<ngraph::Function> BuildShapeRange(
+    const ngraph::Shape& data_shape) {
+  auto data = make_shared<opset::Parameter>(ngraph::element::f32, data_shape);
+  auto shape = make_shared<opset::ShapeOf>(data, ngraph::element::i64);
+  auto begin =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {1});
+  auto end =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {2});
+  auto stride =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {1});
+  auto dim = make_shared<opset::StridedSlice>(shape, begin, end, stride,
+                                              vector<int64_t>{0},
+                                              vector<int64_t>{0});
+  auto axis =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {0});
+  auto scalar = make_shared<opset::Squeeze>(dim, axis);
+  auto start =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{}, {0});
+  auto step =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{}, {1});
+  auto range = make_shared<opset::Range>(start, scalar, step,
+                                         ngraph::element::i64);
+  return make_shared<ngraph::Function>(ngraph::OutputVector{range},
+                                       ngraph::ParameterVector{data},
+                                       "shape_range");
+}
+
+TEST(HostEvaluation, IsHostEvaluable) {
+  auto env_map = StoreEnv({"OPENVINO_TF_HOST_EVAL_MAX_NODES"});
+  UnsetEnvVariable("OPENVINO_TF_HOST_EVAL_MAX_NODES");
+
+  // The f32 data is only read by ShapeOf
+  auto func = BuildShapeRange(ngraph::Shape{2, 5});
+  ASSERT_TRUE(Executable::IsHostEvaluable(func));
+  // ShapeOf, StridedSlice, Squeeze and Range
+  ASSERT_FALSE(Executable::IsHostEvaluable(func, 3));
+  SetEnvVariable("OPENVINO_TF_HOST_EVAL_MAX_NODES", "0");
+  ASSERT_FALSE(Executable::IsHostEvaluable(func));
+
+  // Floating point computations run with IE
+  auto param = make_shared<opset::Parameter>(ngraph::element::f32,
+                                             ngraph::Shape{2});
+  auto neg = make_shared<opset::Negative>(param);
+  auto float_func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{neg}, ngraph::ParameterVector{param});
+  ASSERT_FALSE(Executable::IsHostEvaluable(float_func, 16));
+
+  // and so do large integer tensors
+  auto large = make_shared<opset::Parameter>(ngraph::element::i32,
+                                             ngraph::Shape{64, 64});
+  auto large_neg = make_shared<opset::Negative>(large);
+  auto large_func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{large_neg}, ngraph::ParameterVector{large});
+  ASSERT_FALSE(Executable::IsHostEvaluable(large_func, 16));
+
+  RestoreEnv(env_map);
+}
+
+TEST(HostEvaluation, TrialEvaluate) {
+  ASSERT_TRUE(Executable::TrialEvaluate(BuildShapeRange(ngraph::Shape{2, 5})));
+  // The data only read by ShapeOf isn't allocated, whatever its size
+  ASSERT_TRUE(Executable::TrialEvaluate(
+      BuildShapeRange(ngraph::Shape{1 << 20, 1 << 10})));
+
+  // The ones make the divisor zero, so this function runs with IE even if
+  // nGraph could evaluate it on other inputs
+  auto param = make_shared<opset::Parameter>(ngraph::element::i32,
+                                             ngraph::Shape{2});
+  auto zero = make_shared<opset::Subtract>(param, param);
+  auto div = make_shared<opset::Divide>(param, zero);
+  auto div_func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{div}, ngraph::ParameterVector{param});
+  ASSERT_TRUE(Executable::IsHostEvaluable(div_func, 16));
+  ASSERT_FALSE(Executable::TrialEvaluate(div_func));
+}
+
+TEST(HostEvaluation, Call) {
+  auto env_map = StoreEnv({"OPENVINO_TF_HOST_EVAL_MAX_NODES"});
+  UnsetEnvVariable("OPENVINO_TF_HOST_EVAL_MAX_NODES");
+
+  Executable exec(BuildShapeRange(ngraph::Shape{2, 5}), "CPU", "CPU");
+  ASSERT_TRUE(exec.IsHostEvaluated());
+  ASSERT_TRUE(exec.IsReentrant());
+
+  vector<float> data(10, 1.0f);
+  vector<shared_ptr<ngraph::runtime::Tensor>> inputs{make_shared<IETensor>(
+      ngraph::element::f32, ngraph::Shape{2, 5}, data.data())};
+  vector<shared_ptr<ngraph::runtime::Tensor>> outputs;
+  ASSERT_TRUE(exec.Call(inputs, outputs));
+  ASSERT_EQ(outputs.size(), 1u);
+  ASSERT_EQ(outputs[0]->get_element_type(), ngraph::element::i64);
+  ASSERT_EQ(outputs[0]->get_shape(), ngraph::Shape{5});
+  vector<int64_t> values(5);
+  outputs[0]->read(values.data(), values.size() * sizeof(int64_t));
+  ASSERT_EQ(values, (vector<int64_t>{0, 1, 2, 3, 4}));
+
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/ie_adaptive_engine.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(IEAdaptiveEngine, ModeSelectorHysteresis) {
+  AdaptiveModeSelector selector(1.5, 1.1, 0.25);
+  // Sequential calls stay in latency mode
+  for (int i = 0; i < 10; i++) {
+    ASSERT_FALSE(selector.Update(1));
+  }
+  ASSERT_DOUBLE_EQ(selector.GetLoad(), 1.0);
+  // An occasional overlap doesn't switch
+  ASSERT_FALSE(selector.Update(2));
+  ASSERT_DOUBLE_EQ(selector.GetLoad(), 1.25);
+  ASSERT_FALSE(selector.Update(1));
+
+  // A burst switches to throughput mode
+  ASSERT_TRUE(selector.Update(4));
+  ASSERT_TRUE(selector.IsThroughputMode());
+  // and stays there while the load is above the low threshold, even under
+  // the high one
+  ASSERT_TRUE(selector.Update(1));
+  ASSERT_TRUE(selector.Update(1));
+  ASSERT_TRUE(selector.Update(1));
+  ASSERT_LT(selector.GetLoad(), 1.5);
+  int num_calls = 0;
+  while (selector.Update(1)) {
+    num_calls++;
+    ASSERT_GT(selector.GetLoad(), 1.1);
+    ASSERT_LT(num_calls, 10);
+  }
+  ASSERT_LE(selector.GetLoad(), 1.1);
+  ASSERT_FALSE(selector.IsThroughputMode());
+}
+
+// Cancelling a call leaves the other calls running on the engine untouched
+TEST(IEAdaptiveEngine, PerCallCancellation) {
+  IE_InferCancellation first, second;
+  {
+    IE_CancellationScope scope(&second);
+    scope.Bind(InferenceEngine::InferRequest());
+  }
+  first.Cancel();
+  ASSERT_TRUE(first.IsCancelled());
+  ASSERT_FALSE(second.IsCancelled());
+  ASSERT_THROW(first.Bind(InferenceEngine::InferRequest()),
+               std::runtime_error);
+  {
+    IE_CancellationScope scope(&second);
+    ASSERT_NO_THROW(scope.Bind(InferenceEngine::InferRequest()));
+  }
+  // No request is bound once the scope has ended
+  second.Cancel();
+  ASSERT_TRUE(second.IsCancelled());
+
+  // Engines called without a cancellation ignore the scope
+  IE_CancellationScope scope(nullptr);
+  ASSERT_NO_THROW(scope.Bind(InferenceEngine::InferRequest()));
+}
+
+TEST(IEAdaptiveEngine, Policy) {
+  auto env_map = StoreEnv({"OPENVINO_TF_ADAPTIVE_STREAMS"});
+
+  UnsetEnvVariable("OPENVINO_TF_ADAPTIVE_STREAMS");
+  ASSERT_EQ(IE_Adaptive_Engine::GetPolicy(),
+            IE_Adaptive_Engine::Policy::DISABLED);
+  SetEnvVariable("OPENVINO_TF_ADAPTIVE_STREAMS", "1");
+  ASSERT_EQ(IE_Adaptive_Engine::GetPolicy(),
+            IE_Adaptive_Engine::Policy::ADAPTIVE);
+  SetEnvVariable("OPENVINO_TF_ADAPTIVE_STREAMS", "latency");
+  ASSERT_EQ(IE_Adaptive_Engine::GetPolicy(),
+            IE_Adaptive_Engine::Policy::LATENCY);
+  SetEnvVariable("OPENVINO_TF_ADAPTIVE_STREAMS", "throughput");
+  ASSERT_EQ(IE_Adaptive_Engine::GetPolicy(),
+            IE_Adaptive_Engine::Policy::THROUGHPUT);
+  SetEnvVariable("OPENVINO_TF_ADAPTIVE_STREAMS", "0");
+  ASSERT_EQ(IE_Adaptive_Engine::GetPolicy(),
+            IE_Adaptive_Engine::Policy::DISABLED);
+
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/ie_autotuner.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(IEAutoTuner, SerializeConfig) {
+  IE_AutoTuner::Config config = {{"CPU_THREADS_NUM", "4"},
+                                 {"CPU_THROUGHPUT_STREAMS", "1"}};
+  string str = IE_AutoTuner::SerializeConfig(config);
+  ASSERT_EQ(str, "CPU_THREADS_NUM=4;CPU_THROUGHPUT_STREAMS=1");
+
+  IE_AutoTuner::Config parsed;
+  ASSERT_TRUE(IE_AutoTuner::DeserializeConfig(str, parsed));
+  ASSERT_EQ(parsed, config);
+
+  // The default configuration is serialized as an empty string
+  ASSERT_EQ(IE_AutoTuner::SerializeConfig({}), "");
+  ASSERT_TRUE(IE_AutoTuner::DeserializeConfig("", parsed));
+  ASSERT_TRUE(parsed.empty());
+
+  ASSERT_FALSE(IE_AutoTuner::DeserializeConfig("CPU_THREADS_NUM", parsed));
+  ASSERT_FALSE(IE_AutoTuner::DeserializeConfig("=4", parsed));
+}
+
+TEST(IEAutoTuner, CandidateConfigs) {
+  auto cpu_candidates = IE_AutoTuner::GetCandidateConfigs("CPU");
+  ASSERT_GT(cpu_candidates.size(), 1u);
+  ASSERT_TRUE(cpu_candidates[0].empty());
+
+  // Devices without tuning candidates only keep the default configuration
+  auto myriad_candidates = IE_AutoTuner::GetCandidateConfigs("MYRIAD");
+  ASSERT_EQ(myriad_candidates.size(), 1u);
+  ASSERT_TRUE(myriad_candidates[0].empty());
+}
+
+TEST(IEAutoTuner, StoreAndLookup) {
+  auto env_map = StoreEnv({"OPENVINO_TF_CACHE_DIR"});
+  UnsetEnvVariable("OPENVINO_TF_CACHE_DIR");
+
+  IE_AutoTuner::Config config = {{"CPU_THROUGHPUT_STREAMS", "2"}};
+  IE_AutoTuner::StoreConfig("CPU:test_cluster:f32{1,2}", config);
+
+  IE_AutoTuner::Config found;
+  ASSERT_TRUE(IE_AutoTuner::LookupConfig("CPU:test_cluster:f32{1,2}", found));
+  ASSERT_EQ(found, config);
+  ASSERT_FALSE(IE_AutoTuner::LookupConfig("CPU:test_cluster:f32{2,2}", found));
+
+  RestoreEnv(env_map);
+}
+
+static shared_ptr<ngraph::Function> BuildScale(float scale) {
+  auto param =
+      make_shared<opset::Parameter>(ngraph::element::f32, ngraph::Shape{2});
+  auto constant =
+      opset::Constant::create(ngraph::element::f32, ngraph::Shape{}, {scale});
+  auto mul = make_shared<opset::Multiply>(param, constant);
+  return make_shared<ngraph::Function>(ngraph::OutputVector{mul},
+                                       ngraph::ParameterVector{param},
+                                       "ovtf_cluster_0");
+}
+
+TEST(IEAutoTuner, FunctionHash) {
+  auto hash = IE_AutoTuner::GetFunctionHash(BuildScale(2.0f));
+  ASSERT_EQ(hash.size(), 16u);
+  ASSERT_EQ(IE_AutoTuner::GetFunctionHash(BuildScale(2.0f)), hash);
+  // Same name, inputs and ops, but another constant
+  ASSERT_NE(IE_AutoTuner::GetFunctionHash(BuildScale(3.0f)), hash);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/ie_pipeline_engine.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// param ---> mul ---> relu ---> abs ---> neg ---> exp ---> add ---> mul_out
+//   const --'  |                                          ^      ^
+//              '------------------------------------------'      |
+//   const -------------------------------------------------------'
+static shared_ptr<ngraph::Function> BuildSkipConnection(
+    const ngraph::PartialShape& shape) {
+  auto param = make_shared<opset::Parameter>(ngraph::element::f32, shape);
+  auto scale = opset::Constant::create(ngraph::element::f32, ngraph::Shape{},
+                                       {2.0f});
+  auto mul = make_shared<opset::Multiply>(param, scale);
+  auto relu = make_shared<opset::Relu>(mul);
+  auto abs = make_shared<opset::Abs>(relu);
+  auto neg = make_shared<opset::Negative>(abs);
+  auto exp = make_shared<opset::Exp>(neg);
+  auto add = make_shared<opset::Add>(exp, relu);
+  auto mul_out = make_shared<opset::Multiply>(add, scale);
+  return make_shared<ngraph::Function>(
+      ngraph::OutputVector{mul_out}, ngraph::ParameterVector{param}, "skip");
+}
+
+TEST(IEPipelineEngine, PartitionFunction) {
+  auto func = BuildSkipConnection(ngraph::Shape{4, 8});
+  auto partition = PartitionFunction(func, 3);
+  ASSERT_GE(partition.stages.size(), 2u);
+  ASSERT_LE(partition.stages.size(), 3u);
+  ASSERT_EQ(partition.parameter_values.size(), 1u);
+  ASSERT_EQ(partition.result_values.size(), 1u);
+
+  // Every stage only reads values fed to the function or produced by a
+  // previous stage
+  set<size_t> available(partition.parameter_values.begin(),
+                        partition.parameter_values.end());
+  size_t num_compute_ops = 0;
+  for (const auto& stage : partition.stages) {
+    ASSERT_NE(stage.function, nullptr);
+    ASSERT_NO_THROW(stage.function->validate_nodes_and_infer_types());
+    ASSERT_EQ(stage.function->get_parameters().size(),
+              stage.input_values.size());
+    ASSERT_EQ(stage.function->get_results().size(),
+              stage.output_values.size());
+    ASSERT_FALSE(stage.output_values.empty());
+    for (auto value : stage.input_values) {
+      ASSERT_EQ(available.count(value), 1u);
+    }
+    for (auto value : stage.output_values) {
+      ASSERT_LT(value, partition.num_values);
+      available.insert(value);
+    }
+    for (const auto& op : stage.function->get_ops()) {
+      if (ngraph::op::is_parameter(op) || ngraph::op::is_output(op)) continue;
+      // Constants are duplicated, not passed between the stages
+      if (ngraph::op::is_constant(op)) continue;
+      num_compute_ops++;
+    }
+  }
+  ASSERT_EQ(num_compute_ops, 7u);
+  ASSERT_EQ(available.count(partition.result_values[0]), 1u);
+  // The result is produced by the last stage
+  const auto& last_outputs = partition.stages.back().output_values;
+  ASSERT_NE(find(last_outputs.begin(), last_outputs.end(),
+                 partition.result_values[0]),
+            last_outputs.end());
+}
+
+TEST(IEPipelineEngine, PartitionFunctionUnsupported) {
+  // A single stage doesn't make a pipeline
+  ASSERT_TRUE(
+      PartitionFunction(BuildSkipConnection(ngraph::Shape{4, 8}), 1)
+          .stages.empty());
+  // The stages exchange tensors of static shapes
+  ASSERT_TRUE(PartitionFunction(BuildSkipConnection(ngraph::PartialShape{
+                                    ngraph::Dimension::dynamic(), 8}),
+                                2)
+                  .stages.empty());
+}
+
+TEST(IEPipelineEngine, MakeMicroBatchFunction) {
+  auto micro_func =
+      MakeMicroBatchFunction(BuildSkipConnection(ngraph::Shape{4, 8}), 2);
+  ASSERT_NE(micro_func, nullptr);
+  ASSERT_EQ(micro_func->get_results()[0]->get_shape(), (ngraph::Shape{2, 8}));
+  // The batch must be divisible by the number of micro-batches
+  ASSERT_EQ(MakeMicroBatchFunction(BuildSkipConnection(ngraph::Shape{3, 8}), 2),
+            nullptr);
+
+  // A reduction over the rows keeps the shapes of its micro-batches but not
+  // their values
+  auto param =
+      make_shared<opset::Parameter>(ngraph::element::f32, ngraph::Shape{4, 8});
+  auto relu = make_shared<opset::Relu>(param);
+  auto axis =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {0});
+  auto sum = make_shared<opset::ReduceSum>(relu, axis, true);
+  auto centered = make_shared<opset::Subtract>(relu, sum);
+  auto func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{centered}, ngraph::ParameterVector{param});
+  ASSERT_EQ(MakeMicroBatchFunction(func, 2), nullptr);
+
+  // while a reduction over the features keeps the rows apart
+  auto features =
+      opset::Constant::create(ngraph::element::i64, ngraph::Shape{1}, {-1});
+  auto row_sum = make_shared<opset::ReduceSum>(relu, features, true);
+  auto row_centered = make_shared<opset::Subtract>(relu, row_sum);
+  auto row_func = make_shared<ngraph::Function>(
+      ngraph::OutputVector{row_centered}, ngraph::ParameterVector{param});
+  ASSERT_NE(MakeMicroBatchFunction(row_func, 2), nullptr);
+}
+
+TEST(IEPipelineEngine, NumStages) {
+  auto env_map = StoreEnv({"OPENVINO_TF_PIPELINE_STAGES"});
+
+  UnsetEnvVariable("OPENVINO_TF_PIPELINE_STAGES");
+  ASSERT_EQ(IE_Pipeline_Engine::GetNumStages(), 0);
+  SetEnvVariable("OPENVINO_TF_PIPELINE_STAGES", "1");
+  ASSERT_EQ(IE_Pipeline_Engine::GetNumStages(), 0);
+  SetEnvVariable("OPENVINO_TF_PIPELINE_STAGES", "4");
+  ASSERT_EQ(IE_Pipeline_Engine::GetNumStages(), 4);
+
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
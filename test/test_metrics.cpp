@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(Metrics, IncrementAndDump) {
+  Metrics::Reset();
+  ASSERT_EQ(Metrics::Get("cancelled_steps"), 0);
+
+  Metrics::Increment("cancelled_steps");
+  Metrics::Increment("cancelled_steps");
+  Metrics::Increment("abandoned_compiles", 3);
+  ASSERT_EQ(Metrics::Get("cancelled_steps"), 2);
+  ASSERT_EQ(Metrics::Get("abandoned_compiles"), 3);
+  ASSERT_EQ(Metrics::GetAll().size(), 2u);
+
+  // Counters are dumped in name order
+  string metrics;
+  Metrics::Dump(metrics);
+  ASSERT_EQ(metrics, "abandoned_compiles 3\ncancelled_steps 2\n");
+
+  Metrics::Reset();
+  ASSERT_EQ(Metrics::Get("cancelled_steps"), 0);
+  Metrics::Dump(metrics);
+  ASSERT_EQ(metrics, "");
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <atomic>
+#include <list>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/model_resources.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static const list<string> kQuotaEnv = {
+    "OPENVINO_TF_MODEL_MAX_CACHE_MB",
+    "OPENVINO_TF_MODEL_MAX_CONCURRENT_COMPILES",
+    "OPENVINO_TF_MODEL_MAX_THREADS_PER_NETWORK"};
+
+TEST(ModelResources, Quotas) {
+  auto env_map = StoreEnv(kQuotaEnv);
+  SetEnvVariable("OPENVINO_TF_MODEL_MAX_CACHE_MB", "64");
+  UnsetEnvVariable("OPENVINO_TF_MODEL_MAX_CONCURRENT_COMPILES");
+  SetEnvVariable("OPENVINO_TF_MODEL_MAX_THREADS_PER_NETWORK", "2");
+
+  auto defaults = ModelResources::GetDefaultQuotas();
+  ASSERT_EQ(defaults.max_cache_bytes, 64 * 1024 * 1024);
+  ASSERT_EQ(defaults.max_concurrent_compiles, 0);
+  ASSERT_EQ(defaults.max_threads_per_network, 2);
+
+  // The attributes of the op override the defaults
+  auto quotas = ModelResources::ParseQuotas(
+      {{"max_concurrent_compiles", "1"}, {"max_threads_per_network", "4"}},
+      defaults);
+  ASSERT_EQ(quotas.max_cache_bytes, 64 * 1024 * 1024);
+  ASSERT_EQ(quotas.max_concurrent_compiles, 1);
+  ASSERT_EQ(quotas.max_threads_per_network, 4);
+
+  ASSERT_EQ(ModelResources::GetModelName({{"model_tag", "ranker"}}, 3),
+            "ranker");
+  ASSERT_EQ(ModelResources::GetModelName({}, 3), "graph_3");
+
+  ModelResources::Reset();
+  ModelResources::SetQuotas("ranker", quotas);
+  auto config = ModelResources::GetPluginConfig("ranker", "CPU");
+  ASSERT_EQ(config["CPU_THREADS_NUM"], "4");
+  ASSERT_TRUE(ModelResources::GetPluginConfig("ranker", "GPU").empty());
+
+  ModelResources::Reset();
+  RestoreEnv(env_map);
+}
+
+TEST(ModelResources, CacheQuota) {
+  auto env_map = StoreEnv(kQuotaEnv);
+  for (const auto& name : kQuotaEnv) UnsetEnvVariable(name);
+  ModelResources::Reset();
+
+  ModelResources::Quotas quotas;
+  quotas.max_cache_bytes = 100;
+  ModelResources::SetQuotas("a", quotas);
+  int op1, op2;
+
+  ModelResources::AddExecutable("a", &op1, "k1", 40);
+  ModelResources::AddExecutable("a", &op2, "k2", 40);
+  ModelResources::TouchExecutable("a", &op1, "k1");
+  // Evicts k2, the least recently used executable, from the other op
+  ModelResources::AddExecutable("a", &op1, "k3", 40);
+  auto usage = ModelResources::GetUsage()["a"];
+  ASSERT_EQ(usage["cache_bytes"], 80);
+  ASSERT_EQ(usage["executables"], 2);
+  ASSERT_EQ(usage["quota_evictions"], 1);
+  ASSERT_TRUE(ModelResources::TakeEvicted("a", &op1).empty());
+  ASSERT_EQ(ModelResources::TakeEvicted("a", &op2), vector<string>{"k2"});
+  ASSERT_TRUE(ModelResources::TakeEvicted("a", &op2).empty());
+
+  // Other models are not affected
+  ModelResources::AddExecutable("b", &op2, "k1", 1000);
+  ASSERT_EQ(ModelResources::GetUsage()["b"]["quota_evictions"], 0);
+  ASSERT_EQ(ModelResources::GetUsage()["a"]["cache_bytes"], 80);
+
+  ModelResources::RemoveOwner("a", &op1);
+  usage = ModelResources::GetUsage()["a"];
+  ASSERT_EQ(usage["cache_bytes"], 0);
+  ASSERT_EQ(usage["executables"], 0);
+  ASSERT_EQ(usage["cache_peak_bytes"], 80);
+
+  ModelResources::Reset();
+  RestoreEnv(env_map);
+}
+
+TEST(ModelResources, CompileQuota) {
+  auto env_map = StoreEnv(kQuotaEnv);
+  for (const auto& name : kQuotaEnv) UnsetEnvVariable(name);
+  ModelResources::Reset();
+
+  ModelResources::Quotas quotas;
+  quotas.max_concurrent_compiles = 1;
+  ModelResources::SetQuotas("a", quotas);
+
+  auto first = ModelResources::TryAdmitCompile("a");
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(ModelResources::TryAdmitCompile("a"), nullptr);
+  // Models without quota are not blocked
+  ASSERT_NE(ModelResources::TryAdmitCompile("b"), nullptr);
+
+  atomic<bool> admitted(false);
+  thread waiter([&admitted]() {
+    auto slot = ModelResources::AdmitCompile("a", []() { return false; });
+    admitted = slot != nullptr;
+  });
+  this_thread::sleep_for(chrono::milliseconds(50));
+  EXPECT_FALSE(admitted);
+  first.reset();
+  waiter.join();
+  ASSERT_TRUE(admitted);
+
+  first = ModelResources::TryAdmitCompile("a");
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(ModelResources::AdmitCompile("a", []() { return true; }),
+            nullptr);
+  auto usage = ModelResources::GetUsage()["a"];
+  ASSERT_EQ(usage["compiles"], 3);
+  ASSERT_EQ(usage["compile_waits"], 1);
+  ASSERT_EQ(usage["compiles_abandoned"], 1);
+  ASSERT_EQ(usage["running_compiles"], 1);
+  first.reset();
+
+  ModelResources::Reset();
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
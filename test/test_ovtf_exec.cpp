@@ -21,7 +21,9 @@
 #include "tensorflow/core/platform/env.h"
 
 #include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/ovtf_metrics.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 
 #include "ngraph/ngraph.hpp"
@@ -313,6 +315,142 @@ TEST_F(NGraphExecTest, NGraphPassConstantFolding2) {
   unsetenv("OPENVINO_TF_CONSTANT_FOLDING");
 }
 
+TEST_F(NGraphExecTest, TranslationPlanReuse) {
+  auto env_map = StoreEnv({"OPENVINO_TF_PROFILE_TRANSLATION"});
+  SetEnvVariable("OPENVINO_TF_PROFILE_TRANSLATION", "1");
+  Builder::ResetTranslationProfile();
+  Metrics::Reset();
+
+  Graph input_graph(OpRegistry::Global());
+  ASSERT_OK(LoadGraph("test_axpy_launchop.pbtxt", &input_graph));
+
+  Builder::TranslationPlan plan;
+  ASSERT_OK(Builder::CreateTranslationPlan(&input_graph, plan));
+  ASSERT_EQ(plan.params.size(), 2u);
+  ASSERT_EQ(plan.ret_vals.size(), 2u);
+  ASSERT_EQ(plan.ops.size(), 3u);
+
+  std::vector<TensorShape> input_shapes{TensorShape({2, 3}),
+                                        TensorShape({2, 3})};
+  std::vector<const Tensor*> static_input_map(input_shapes.size(), nullptr);
+  std::vector<Tensor> tf_input_tensors;
+
+  // The same plan is used for both translations
+  for (int i = 0; i < 2; i++) {
+    shared_ptr<ng::Function> ng_function;
+    ng::ResultVector ng_result_list;
+    ASSERT_OK(Builder::TranslateGraph(input_shapes, static_input_map, plan,
+                                      "test_ovtf_exec", ng_function,
+                                      ng_result_list, tf_input_tensors));
+    ASSERT_EQ(ng_function->get_results().size(), 2u);
+
+    // The tracing info is attached to the nodes of the function
+    for (const auto& result : ng_function->get_results()) {
+      ASSERT_NE(result->get_friendly_name().find("_retval"), string::npos);
+      ASSERT_FALSE(result->get_provenance_tags().empty());
+    }
+  }
+
+  auto profile = Builder::GetTranslationProfile();
+  ASSERT_EQ(profile.size(), 3u);
+  for (const auto& kv : profile) {
+    ASSERT_EQ(kv.second.count, 2);
+    int64 num_calls = 0;
+    for (auto calls : kv.second.histogram) num_calls += calls;
+    ASSERT_EQ(num_calls, 2);
+    string prefix = "translation_profile/" + kv.first;
+    ASSERT_EQ(Metrics::Get(prefix + "/calls"), 2);
+    ASSERT_EQ(Metrics::Get(prefix + "/total_us"), kv.second.total_us);
+    ASSERT_EQ(Metrics::Get(prefix + "/max_us"), kv.second.max_us);
+  }
+
+  Builder::ResetTranslationProfile();
+  Metrics::Reset();
+  RestoreEnv(env_map);
+}
+
+// x(_Arg 0) --+
+//             +--> Slice --> _Retval
+// b(_Arg 1) --+      ^
+//                    |
+//           size(Const {1, 2})
+TEST_F(NGraphExecTest, SliceWithRuntimeBegin) {
+  auto env_map = StoreEnv(
+      {"OPENVINO_TF_BACKEND", "OPENVINO_TF_DYNAMIC_STATIC_INPUTS"});
+  SetBackendUsingEnvVar("CPU");
+  SetEnvVariable("OPENVINO_TF_DYNAMIC_STATIC_INPUTS", "1");
+
+  Graph g(OpRegistry::Global());
+  Node* x;
+  ASSERT_OK(NodeBuilder("x", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&g, &x));
+  Node* begin;
+  ASSERT_OK(NodeBuilder("begin", "_Arg")
+                .Attr("T", DT_INT32)
+                .Attr("index", 1)
+                .Finalize(&g, &begin));
+  Tensor t_size(DT_INT32, TensorShape({2}));
+  AssignInputValues(t_size, vector<int32>{1, 2});
+  Node* size;
+  ASSERT_OK(NodeBuilder("size", "Const")
+                .Attr("dtype", DT_INT32)
+                .Attr("value", t_size)
+                .Finalize(&g, &size));
+  Node* slice;
+  ASSERT_OK(NodeBuilder("slice", "Slice")
+                .Input(x, 0)
+                .Input(begin, 0)
+                .Input(size, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("Index", DT_INT32)
+                .Finalize(&g, &slice));
+  Node* retval;
+  ASSERT_OK(NodeBuilder("retval", "_Retval")
+                .Input(slice, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&g, &retval));
+
+  // Only the size remains static, so the value of begin is not part of the
+  // signature of the cluster
+  ASSERT_OK(GetAttributeSetters().at("Slice")(slice));
+  ASSERT_FALSE(InputIsStatic(slice, 1));
+  ASSERT_TRUE(InputIsStatic(slice, 2));
+  std::vector<int32> static_inputs;
+  ASSERT_OK(GetStaticInputs(&g, &static_inputs));
+  ASSERT_TRUE(static_inputs.empty());
+
+  shared_ptr<ng::Function> ng_function;
+  ASSERT_OK(TranslateTFGraphNoStatic({TensorShape({3, 4}), TensorShape({2})},
+                                     g, ng_function));
+  ASSERT_EQ(ng_function->get_parameters().size(), 2u);
+  ASSERT_EQ(ng_function->get_results()[0]->get_shape(), (ng::Shape{1, 2}));
+
+  // The same executable serves every value of begin
+  auto backend = BackendManager::GetBackend();
+  auto exec = backend->Compile(ng_function);
+  float v_x[3][4] = {{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}};
+  auto t_x = make_shared<IETensor>(ng::element::f32, ng::Shape{3, 4});
+  t_x->write(&v_x, sizeof(v_x));
+  std::vector<std::pair<std::vector<int32>, std::vector<float>>> cases{
+      {{0, 0}, {0, 1}}, {{1, 2}, {6, 7}}, {{2, 1}, {9, 10}},
+      // Out of range values of begin are clamped
+      {{5, 3}, {10, 11}}, {{-1, -2}, {0, 1}}};
+  for (const auto& c : cases) {
+    auto t_begin = make_shared<IETensor>(ng::element::i32, ng::Shape{2});
+    t_begin->write(c.first.data(), c.first.size() * sizeof(int32));
+    vector<shared_ptr<ng::runtime::Tensor>> outputs;
+    exec->Call({t_x, t_begin}, outputs);
+    std::vector<float> result(2);
+    outputs[0]->read(result.data(), result.size() * sizeof(float));
+    ASSERT_EQ(result, c.second);
+  }
+
+  RestoreEnv(env_map);
+}
+
 }  // namespace testing
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/placement_profile.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static void AddNode(GraphDef& graph_def, const string& name, const string& op,
+                    const vector<string>& inputs) {
+  NodeDef* node = graph_def.add_node();
+  node->set_name(name);
+  node->set_op(op);
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+}
+
+// x ---> pre ---> encap(cluster 7) --1--> post ---> post2       other
+//  '-------------------^ (control)
+// stray is an encapsulate op without a cluster, it is left out of the clusters
+// and of the regions
+TEST(PlacementProfile, ExportGraph) {
+  PlacementProfile::Reset();
+  GraphDef graph_def;
+  AddNode(graph_def, "x", "Placeholder", {});
+  AddNode(graph_def, "pre", "Cast", {"x"});
+  AddNode(graph_def, "encap", "_nGraphEncapsulate", {"pre", "^x"});
+  (*graph_def.mutable_node(2)->mutable_attr())["ovtf_cluster"].set_i(7);
+  AddNode(graph_def, "post", "TopKV2", {"encap:1"});
+  AddNode(graph_def, "post2", "Identity", {"post"});
+  AddNode(graph_def, "other", "Const", {});
+  AddNode(graph_def, "stray", "_nGraphEncapsulate", {});
+
+  PlacementProfile::RecordClusterCall(0, 500, {}, {});
+  PlacementProfile::RecordClusterCall(7, 1000, {400}, {100, 800});
+  PlacementProfile::RecordClusterCall(7, 3000, {400}, {100, 800});
+  PlacementProfile::RecordNodeTimes("pre\t30\npost\t50\npost2\t10\nbad line");
+
+  string dot, json;
+  PlacementProfile::ExportGraph(0, graph_def, dot, json);
+
+  ASSERT_NE(json.find("{\"cluster\": 7, \"node\": \"encap\", \"calls\": 2, "
+                      "\"total_us\": 4000, \"mean_us\": 2000}"),
+            string::npos);
+  // The nodes left to TF form three regions, only the first two are timed
+  ASSERT_NE(json.find("{\"region\": 0, \"timed\": true, \"steps\": 1, "
+                      "\"total_us\": 30"),
+            string::npos);
+  ASSERT_NE(json.find("{\"region\": 1, \"timed\": true, \"steps\": 1, "
+                      "\"total_us\": 60"),
+            string::npos);
+  ASSERT_NE(json.find("{\"region\": 2, \"timed\": false"), string::npos);
+  ASSERT_NE(json.find("\"nodes\": [\"x\", \"pre\"]"), string::npos);
+  ASSERT_EQ(json.find("\"region\": 3"), string::npos);
+  ASSERT_EQ(json.find("\"cluster\": 0"), string::npos);
+  ASSERT_EQ(json.find("\"stray\""), string::npos);
+
+  // Only the data edges crossing the cluster boundary are reported, with
+  // their bytes per call
+  ASSERT_NE(json.find("{\"src\": \"pre\", \"src_output\": 0, \"src_entity\": "
+                      "\"region_0\", \"dst\": \"encap\", \"dst_input\": 0, "
+                      "\"dst_entity\": \"cluster_7\", \"bytes_per_call\": "
+                      "400}"),
+            string::npos);
+  ASSERT_NE(json.find("{\"src\": \"encap\", \"src_output\": 1, \"src_entity\": "
+                      "\"cluster_7\", \"dst\": \"post\", \"dst_input\": 0, "
+                      "\"dst_entity\": \"region_1\", \"bytes_per_call\": "
+                      "800}"),
+            string::npos);
+  ASSERT_EQ(json.find("\"src\": \"x\""), string::npos);
+
+  ASSERT_NE(dot.find("region_0 -> cluster_7 [label=\"1 tensor\\n400 B/call\""),
+            string::npos);
+  ASSERT_NE(dot.find("cluster_7 -> region_1 [label=\"1 tensor\\n800 B/call\""),
+            string::npos);
+  ASSERT_NE(dot.find("per call: 2.000 ms"), string::npos);
+
+  PlacementProfile::Reset();
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
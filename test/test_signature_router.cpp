@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (C) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/ovtf_metrics.h"
+#include "openvino_tensorflow/signature_router.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+using Path = SignatureRouter::Path;
+
+// Runs one call of signature, taking openvino_us or tf_us depending on the
+// path chosen by the router
+static Path RunCall(SignatureRouter& router, const string& signature,
+                    int64 openvino_us, int64 tf_us) {
+  Path path = router.Next(signature);
+  router.Record(signature, path, path == Path::OPENVINO ? openvino_us : tf_us);
+  return path;
+}
+
+TEST(SignatureRouter, RoutesEachSignatureToTheFasterPath) {
+  auto env_map = StoreEnv({"OPENVINO_TF_ROUTING_PROBATION_CALLS",
+                           "OPENVINO_TF_ROUTING_REVALIDATE_CALLS"});
+  SetEnvVariable("OPENVINO_TF_ROUTING_PROBATION_CALLS", "3");
+  SetEnvVariable("OPENVINO_TF_ROUTING_REVALIDATE_CALLS", "10");
+  Metrics::Reset();
+
+  SignatureRouter router(7);
+  Path route;
+  // Probation: the first call of each path is not timed, then both paths
+  // are timed 3 times, alternating between them
+  for (int i = 0; i < 8; i++) {
+    ASSERT_FALSE(router.GetRoute("batch1", route));
+    Path path = RunCall(router, "batch1", 100, 40);
+    ASSERT_EQ(path, i % 2 == 0 ? Path::OPENVINO : Path::TF);
+    RunCall(router, "batch64", 1000, 5000);
+  }
+  ASSERT_TRUE(router.GetRoute("batch1", route));
+  ASSERT_EQ(route, Path::TF);
+  ASSERT_TRUE(router.GetRoute("batch64", route));
+  ASSERT_EQ(route, Path::OPENVINO);
+
+  ASSERT_EQ(Metrics::Get("routing/cluster_7/sig_0/route"), 0);
+  ASSERT_EQ(Metrics::Get("routing/cluster_7/sig_0/speedup_pct"), 40);
+  ASSERT_EQ(Metrics::Get("routing/cluster_7/sig_1/route"), 1);
+  ASSERT_EQ(Metrics::Get("routing/cluster_7/sig_1/speedup_pct"), 500);
+
+  // The decision holds until it is re-validated, which picks up the change
+  for (int i = 0; i < 9; i++) {
+    ASSERT_EQ(RunCall(router, "batch1", 10, 40), Path::TF);
+  }
+  for (int i = 0; i < 6; i++) {
+    RunCall(router, "batch1", 10, 40);
+  }
+  ASSERT_TRUE(router.GetRoute("batch1", route));
+  ASSERT_EQ(route, Path::OPENVINO);
+
+  router.Erase("batch1");
+  ASSERT_FALSE(router.GetRoute("batch1", route));
+
+  Metrics::Reset();
+  RestoreEnv(env_map);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -24,6 +24,7 @@
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/public/session.h"
 
+#include "openvino_tensorflow/cluster_manager.h"
 #include "openvino_tensorflow/ovtf_builder.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 #include "openvino_tensorflow/version.h"
@@ -74,6 +75,47 @@ TEST(TFExec, SingleGraphOn2Threads) {
   thread1.join();
 }
 
+// The shape computations are evaluated on the host, an executable whose
+// steps run without the op lock. Each thread feeds its own shape, so a step
+// compiles while the other one runs, with a single compile admitted at once.
+TEST(TFExec, ReentrantStepsWithOneCompile) {
+  auto env_map = StoreEnv(
+      {"OPENVINO_TF_MAX_CONCURRENT_COMPILES", "OPENVINO_TF_DYNAMIC_FALLBACK"});
+  SetEnvVariable("OPENVINO_TF_MAX_CONCURRENT_COMPILES", "1");
+  // A compile that is not admitted waits instead of running with TF
+  SetEnvVariable("OPENVINO_TF_DYNAMIC_FALLBACK", "0");
+
+  Scope root = Scope::NewRootScope();
+  auto x = ops::Placeholder(root.WithOpName("x"), DT_FLOAT);
+  auto shape = ops::Shape(root.WithOpName("shape"), x);
+  auto one = ops::Const(root, 1);
+  auto y = ops::Add(root.WithOpName("y"), ops::Multiply(root, shape, one),
+                    one);
+  ClientSession session(root);
+
+  auto worker = [&](int rows) {
+    Tensor x_val(DT_FLOAT, TensorShape({rows, 3}));
+    AssignInputValues<float>(x_val, vector<float>(rows * 3, 1.0f));
+    for (int i = 0; i < 10; i++) {
+      std::vector<Tensor> outputs;
+      ASSERT_OK(session.Run({{x, x_val}}, {y}, &outputs));
+      ASSERT_EQ(outputs.size(), 1);
+      auto values = outputs[0].flat<int32>();
+      ASSERT_EQ(values.size(), 2);
+      EXPECT_EQ(values(0), rows + 1);
+      EXPECT_EQ(values(1), 4);
+    }
+  };
+
+  std::thread thread0(worker, 2);
+  std::thread thread1(worker, 5);
+  thread0.join();
+  thread1.join();
+
+  RestoreEnv(env_map);
+  NGraphClusterManager::EnableClusterFallback();
+}
+
 TEST(TFExec, hello_world) {
   Scope root = Scope::NewRootScope();
 
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares native TensorFlow with openvino_tensorflow on a list of models, to
+help decide whether a model should be onboarded.
+
+Every model runs natively (openvino_tensorflow.disable()) and with
+openvino_tensorflow at each of the requested batch sizes. Each run is a
+separate process, so that the peak memory is not shared between runs. The
+report includes the latency, the throughput, the peak RSS, the translation
+and compile times, the number of clusters, the percentage of the ops placed
+on OpenVINO™ and the ops that fall back to TensorFlow most often.
+
+The models are described by a JSON file holding a list of entries like:
+
+    [
+      {"name": "resnet50", "saved_model": "models/resnet50",
+       "signature": "serving_default"},
+      {"name": "mobilenet", "frozen_graph": "models/mobilenet.pb",
+       "inputs": {"input:0": {"shape": [-1, 224, 224, 3],
+                              "dtype": "float32"}},
+       "outputs": ["MobilenetV2/Predictions/Reshape_1:0"]}
+    ]
+
+A dimension of -1 (or an unknown dimension of a SavedModel signature) is
+replaced by the batch size for the first dimension and by 1 otherwise.
+
+Example:
+    python3 ab_compare.py --models models.json --batch_sizes 1,8,32 \\
+        --output ab_report.json
+"""
+
+import argparse
+import collections
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+# Op types that are part of any graph and are not interesting as fallbacks
+PLUMBING_OPS = {"NoOp", "_Arg", "_Retval", "_SOURCE", "_SINK"}
+
+
+def concrete_shape(shape, batch_size):
+    return [(batch_size if i == 0 else 1) if (d is None or d < 0) else d
+            for i, d in enumerate(shape)]
+
+
+def run_worker(model, mode, batch_size, backend, iterations, warmup):
+    """Runs one model in the current process and prints the result."""
+    import resource
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    if mode == "native":
+        ovtf.disable()
+    else:
+        ovtf.enable()
+        ovtf.set_backend(backend)
+
+    def random_input(shape, dtype):
+        dtype = tf.as_dtype(dtype)
+        if dtype.is_floating:
+            return np.random.rand(*shape).astype(dtype.as_numpy_dtype)
+        if dtype.is_bool:
+            return np.random.rand(*shape) > 0.5
+        return np.random.randint(0, 2, shape).astype(dtype.as_numpy_dtype)
+
+    start = time.time()
+    if "frozen_graph" in model:
+        tf.compat.v1.disable_eager_execution()
+        graph_def = tf.compat.v1.GraphDef()
+        with open(model["frozen_graph"], "rb") as graph_file:
+            graph_def.ParseFromString(graph_file.read())
+        graph = tf.Graph()
+        with graph.as_default():
+            tf.import_graph_def(graph_def, name="")
+        sess = tf.compat.v1.Session(graph=graph)
+        feed_dict = {
+            graph.get_tensor_by_name(name): random_input(
+                concrete_shape(spec["shape"], batch_size), spec["dtype"])
+            for name, spec in model["inputs"].items()
+        }
+        fetches = [graph.get_tensor_by_name(name) for name in model["outputs"]]
+        run = lambda: sess.run(fetches, feed_dict=feed_dict)
+    else:
+        loaded = tf.saved_model.load(model["saved_model"])
+        infer = loaded.signatures[model.get("signature", "serving_default")]
+        inputs = {
+            name: tf.constant(
+                random_input(
+                    concrete_shape(spec.shape.as_list(), batch_size),
+                    spec.dtype))
+            for name, spec in infer.structured_input_signature[1].items()
+        }
+        run = lambda: infer(**inputs)
+    load_ms = (time.time() - start) * 1000
+
+    # The first run includes the rewrite, the translation and the compile
+    start = time.time()
+    run()
+    first_inference_ms = (time.time() - start) * 1000
+    for _ in range(warmup):
+        run()
+
+    latencies = []
+    for _ in range(iterations):
+        start = time.time()
+        run()
+        latencies.append((time.time() - start) * 1000)
+    latencies.sort()
+
+    metrics = ovtf.get_metrics() if mode == "ovtf" else {}
+    result = {
+        "load_ms": load_ms,
+        "first_inference_ms": first_inference_ms,
+        "latency_mean_ms": sum(latencies) / len(latencies),
+        "latency_p50_ms": latencies[len(latencies) // 2],
+        "latency_p90_ms": latencies[int(len(latencies) * 0.9)],
+        "throughput_per_s": batch_size * 1000.0 * len(latencies) /
+                            sum(latencies),
+        "peak_rss_kb": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss,
+        "translate_ms": metrics.get("translate_us", 0) / 1000.0,
+        # Includes the loading of the networks by the first calls
+        "compile_ms": metrics.get("compile_us", 0) / 1000.0,
+    }
+    print_result(result)
+
+
+def parse_placement(output):
+    """Sums the placement summaries of all the rewritten graphs."""
+    nodes = assigned = clusters = 0
+    fallback_ops = collections.Counter()
+    for line in output.splitlines():
+        if line.startswith("OVTF_SUMMARY: Number of nodes in the graph:"):
+            nodes += int(line.split(":")[-1])
+        elif line.startswith("OVTF_SUMMARY: Number of nodes assigned a"):
+            assigned += int(line.split(":")[2].split()[0])
+        elif line.startswith("OVTF_SUMMARY: Number of ngraph clusters"):
+            clusters += int(line.split(":")[-1])
+        elif line.startswith("OP_placement:\tHost\t"):
+            op_type = line.rsplit("(", 1)[-1].rstrip(")")
+            if op_type not in PLUMBING_OPS:
+                fallback_ops[op_type] += 1
+    return {
+        "num_nodes": nodes,
+        "num_clusters": clusters,
+        "percent_placed": (assigned * 100.0 / nodes) if nodes else 0.0,
+        "fallback_ops": fallback_ops,
+    }
+
+
+def run_model(model, mode, batch_size, arguments):
+    env = dict(os.environ)
+    if mode == "ovtf":
+        # Prints the placement of every op, which is parsed below
+        env["OPENVINO_TF_LOG_PLACEMENT"] = "1"
+    worker_arguments = [
+        json.dumps(model), mode,
+        str(batch_size), arguments.backend,
+        str(arguments.iterations),
+        str(arguments.warmup)
+    ]
+
+    def top_placement(output):
+        placement = parse_placement(output)
+        placement["fallback_ops"] = dict(
+            placement["fallback_ops"].most_common(arguments.top_fallbacks))
+        return placement
+
+    return run_in_subprocess(__file__, worker_arguments, env,
+                             top_placement if mode == "ovtf" else None)
+
+
+def print_table(report):
+    columns = [("latency_mean_ms", "lat ms", "%9.2f"),
+               ("throughput_per_s", "thr/s", "%9.1f"),
+               ("peak_rss_kb", "RSS MB", "%9.0f")]
+    header = "%-20s %5s" % ("model", "batch")
+    for _, label, _ in columns:
+        header += " %9s %9s" % ("TF " + label, "OV " + label)
+    header += " %8s %8s %5s %7s  %s" % ("comp ms", "speedup", "clus", "placed",
+                                        "top fallbacks")
+    print(header)
+    print("-" * len(header))
+    for entry in report:
+        native, ovtf = entry["native"], entry["ovtf"]
+        line = "%-20s %5d" % (entry["model"][:20], entry["batch_size"])
+        if "error" in native or "error" in ovtf:
+            print(line + " failed, see the JSON report")
+            continue
+        for key, _, fmt in columns:
+            scale = 1.0 / 1024 if key == "peak_rss_kb" else 1.0
+            line += " " + fmt % (native[key] * scale)
+            line += " " + fmt % (ovtf[key] * scale)
+        line += " %8.0f %7.2fx %5d %6.1f%%  %s" % (
+            ovtf["translate_ms"] + ovtf["compile_ms"], entry["speedup"],
+            ovtf["num_clusters"], ovtf["percent_placed"],
+            ", ".join("%s(%d)" % kv for kv in ovtf["fallback_ops"].items()))
+        print(line)
+
+
+def main():
+    if len(sys.argv) > 1 and sys.argv[1] == "--worker":
+        model, mode, batch_size, backend, iterations, warmup = sys.argv[2:]
+        run_worker(
+            json.loads(model), mode, int(batch_size), backend, int(iterations),
+            int(warmup))
+        return
+
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--models',
+        help="JSON file listing the models and their inputs\n",
+        required=True)
+    parser.add_argument(
+        '--batch_sizes',
+        help="Comma separated batch sizes (1 by default)\n",
+        default="1")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--iterations',
+        type=int,
+        default=50,
+        help="Timed iterations of each run\n")
+    parser.add_argument(
+        '--warmup',
+        type=int,
+        default=5,
+        help="Untimed iterations after the first run\n")
+    parser.add_argument(
+        '--top_fallbacks',
+        type=int,
+        default=5,
+        help="Number of fallback op types to report\n")
+    parser.add_argument(
+        '--output', help="Writes the JSON report to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    with open(arguments.models) as models_file:
+        models = json.load(models_file)
+    batch_sizes = [int(b) for b in arguments.batch_sizes.split(",")]
+
+    report = []
+    for model in models:
+        name = model.get(
+            "name",
+            os.path.basename(
+                model.get("saved_model", model.get("frozen_graph", ""))))
+        for batch_size in batch_sizes:
+            entry = {"model": name, "batch_size": batch_size}
+            for mode in ["native", "ovtf"]:
+                print("Running %s at batch size %d with %s" %
+                      (name, batch_size, mode))
+                entry[mode] = run_model(model, mode, batch_size, arguments)
+            if "error" not in entry["native"] and "error" not in entry["ovtf"]:
+                entry["speedup"] = (entry["native"]["latency_mean_ms"] /
+                                    entry["ovtf"]["latency_mean_ms"])
+            report.append(entry)
+
+    print()
+    print_table(report)
+    if arguments.output:
+        with open(arguments.output, "w") as output_file:
+            json.dump(report, output_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares the executables pinned to the latency or the throughput plugin
+configuration with the ones switching between both with the load
+(OPENVINO_TF_ADAPTIVE_STREAMS), under a variable load. Each configuration
+runs in its own process, since the engine is selected when the clusters are
+compiled.
+
+The load alternates between phases of a single client sending requests one
+after the other and bursts of several clients sending requests at the same
+time. The latency is reported for the single client phases and the
+throughput for the bursts.
+
+Example:
+    python3 adaptive_streams.py --clients 8 --phases 4 --requests 50
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+POLICIES = ["latency", "throughput", "adaptive"]
+
+
+def run_worker(arguments):
+    """Runs the variable load in the current process and prints the
+    results."""
+    import threading
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    graph = tf.Graph()
+    with graph.as_default():
+        x = tf.compat.v1.placeholder(
+            tf.float32, shape=(arguments.batch_size, arguments.width), name="x")
+        y = x
+        for i in range(arguments.layers):
+            w = tf.constant(
+                rng.rand(arguments.width, arguments.width).astype(np.float32) /
+                arguments.width,
+                name="w_%d" % i)
+            y = tf.nn.relu(tf.matmul(y, w))
+        y = tf.identity(y, name="y")
+
+    feed = rng.rand(arguments.batch_size, arguments.width).astype(np.float32)
+    with tf.compat.v1.Session(graph=graph) as sess:
+        # Compiles the clusters
+        sess.run(y, feed_dict={x: feed})
+
+        def client(latencies):
+            for _ in range(arguments.requests):
+                start = time.time()
+                sess.run(y, feed_dict={x: feed})
+                latencies.append(time.time() - start)
+
+        low_latencies = []
+        burst_requests = 0
+        burst_time = 0.0
+        for phase in range(arguments.phases):
+            latencies = []
+            client(latencies)
+            # The first phase also lets the executables settle
+            if phase > 0:
+                low_latencies += latencies
+
+            threads = [
+                threading.Thread(target=client, args=([], ))
+                for _ in range(arguments.clients)
+            ]
+            start = time.time()
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            if phase > 0:
+                burst_time += time.time() - start
+                burst_requests += arguments.clients * arguments.requests
+
+    metrics = ovtf.get_metrics()
+    low_latencies = np.array(low_latencies) * 1000
+    print_result({
+        "low_load_mean_ms":
+        float(np.mean(low_latencies)),
+        "low_load_p90_ms":
+        float(np.percentile(low_latencies, 90)),
+        "burst_throughput_per_s":
+        arguments.batch_size * burst_requests / burst_time,
+        "adaptive_executables":
+        metrics.get("adaptive_executables", 0),
+        "adaptive_mode_switches":
+        metrics.get("adaptive_mode_switches", 0),
+    })
+
+
+def run_config(policy, arguments):
+    env = dict(os.environ)
+    env["OPENVINO_TF_ADAPTIVE_STREAMS"] = "1" if policy == "adaptive" else policy
+    return run_in_subprocess(__file__, sys.argv[1:], env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--clients',
+        type=int,
+        default=8,
+        help="Clients sending requests at the same time during a burst\n")
+    parser.add_argument(
+        '--phases',
+        type=int,
+        default=4,
+        help="Pairs of single client and burst phases, the first one\n"
+        "being untimed\n")
+    parser.add_argument(
+        '--requests',
+        type=int,
+        default=50,
+        help="Requests sent by each client in a phase\n")
+    parser.add_argument(
+        '--batch_size', type=int, default=1, help="Batch size\n")
+    parser.add_argument(
+        '--layers', type=int, default=16, help="Layers of the model\n")
+    parser.add_argument(
+        '--width', type=int, default=1024, help="Width of each layer\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for policy in POLICIES:
+        print("Running with the %s configuration" % policy)
+        results[policy] = run_config(policy, arguments)
+
+    print()
+    print("%12s %16s %16s %14s %10s" % ("config", "low load mean ms",
+                                        "low load p90 ms", "burst thr./s",
+                                        "switches"))
+    for policy, result in results.items():
+        if "error" in result:
+            print("%12s failed:\n  %s" % (policy,
+                                          "\n  ".join(result["error"])))
+            continue
+        print("%12s %16.2f %16.2f %14.1f %10d" %
+              (policy, result["low_load_mean_ms"], result["low_load_p90_ms"],
+               result["burst_throughput_per_s"],
+               result["adaptive_mode_switches"]))
+        if result["adaptive_executables"] == 0:
+            print("%12s the engine was not used on this backend" % "")
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
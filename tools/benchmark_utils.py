@@ -0,0 +1,53 @@
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Runner shared by the benchmark scripts of this directory.
+
+Each configuration of a benchmark runs in its own process, since
+openvino_tensorflow reads its environment variables when it is loaded. The
+script runs itself with --worker in this process, and the worker prints its
+result with print_result(), which run_in_subprocess() reads back.
+"""
+
+import json
+import os
+import subprocess
+import sys
+
+RESULT_PREFIX = "BENCHMARK_RESULT: "
+
+
+def print_result(result):
+    """Prints the result of a worker, a dict that can be serialized to JSON."""
+    print(RESULT_PREFIX + json.dumps(result))
+    sys.stdout.flush()
+
+
+def run_in_subprocess(script, worker_arguments, env=None, parse_output=None):
+    """Runs script with --worker and worker_arguments in a new process with
+    the environment env (the current one by default).
+
+    Returns the result printed by the worker, or {"error": <the last lines of
+    the output>} if the worker failed. parse_output, if given, is called with
+    the output of a successful worker and returns a dict merged into the
+    result.
+    """
+    command = [sys.executable,
+               os.path.abspath(script), "--worker"] + list(worker_arguments)
+    process = subprocess.run(
+        command,
+        env=env,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.STDOUT,
+        universal_newlines=True)
+    result = None
+    for line in process.stdout.splitlines():
+        if line.startswith(RESULT_PREFIX):
+            result = json.loads(line[len(RESULT_PREFIX):])
+    if process.returncode != 0 or result is None:
+        return {"error": process.stdout.strip().splitlines()[-20:]}
+    if parse_output is not None:
+        result.update(parse_output(process.stdout))
+    return result
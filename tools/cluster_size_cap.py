@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Measures the compile time, peak memory and steady latency of a deep model
+for several cluster size caps (OPENVINO_TF_MAX_CLUSTER_NODES or
+OPENVINO_TF_MAX_CLUSTER_FLOPS). Each cap runs in its own process, since the
+clusters are partitioned when the graph is rewritten.
+
+The model is a deep stack of dense layers, so that it forms one large
+cluster without a cap.
+
+Example:
+    python3 cluster_size_cap.py --caps 0,64,32,16 --layers 128
+    python3 cluster_size_cap.py --flops --caps 0,1000000000
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+
+def run_worker(arguments):
+    """Runs the model in the current process and prints the measurements."""
+    import resource
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    graph = tf.Graph()
+    with graph.as_default():
+        x = tf.compat.v1.placeholder(
+            tf.float32, shape=(arguments.batch_size, arguments.width), name="x")
+        y = x
+        for i in range(arguments.layers):
+            w = tf.constant(
+                rng.rand(arguments.width, arguments.width).astype(np.float32) /
+                arguments.width,
+                name="w_%d" % i)
+            b = tf.constant(
+                rng.rand(arguments.width).astype(np.float32), name="b_%d" % i)
+            y = tf.nn.relu(tf.matmul(y, w) + b)
+        y = tf.identity(y, name="y")
+
+    feed = rng.rand(arguments.batch_size, arguments.width).astype(np.float32)
+    with tf.compat.v1.Session(graph=graph) as sess:
+        # The first run translates and compiles the clusters
+        start = time.time()
+        sess.run(y, feed_dict={x: feed})
+        first_run = time.time() - start
+        for _ in range(arguments.warmup):
+            sess.run(y, feed_dict={x: feed})
+        start = time.time()
+        for _ in range(arguments.iterations):
+            sess.run(y, feed_dict={x: feed})
+        elapsed = time.time() - start
+
+    metrics = ovtf.get_metrics()
+    print_result({
+        "first_run_ms": first_run * 1000,
+        "translate_ms": metrics.get("translate_us", 0) / 1000,
+        "compile_ms": metrics.get("compile_us", 0) / 1000,
+        "clusters": metrics.get("compiled_executables", 0),
+        "peak_rss_mb": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss /
+        1024,
+        "latency_ms": elapsed * 1000 / arguments.iterations,
+    })
+
+
+def run_config(cap, arguments):
+    env = dict(os.environ)
+    env.pop("OPENVINO_TF_MAX_CLUSTER_NODES", None)
+    env.pop("OPENVINO_TF_MAX_CLUSTER_FLOPS", None)
+    if cap > 0:
+        name = "OPENVINO_TF_MAX_CLUSTER_FLOPS" if arguments.flops else \
+            "OPENVINO_TF_MAX_CLUSTER_NODES"
+        env[name] = str(cap)
+    return run_in_subprocess(__file__, sys.argv[1:], env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--caps',
+        default="0,64,32,16",
+        help="Comma separated caps, 0 being the uncapped baseline\n")
+    parser.add_argument(
+        '--flops',
+        action='store_true',
+        help="Caps the estimated FLOPs instead of the number of nodes\n")
+    parser.add_argument(
+        '--batch_size', type=int, default=1, help="Batch size\n")
+    parser.add_argument(
+        '--layers', type=int, default=128, help="Layers of the model\n")
+    parser.add_argument(
+        '--width', type=int, default=512, help="Width of each layer\n")
+    parser.add_argument(
+        '--iterations', type=int, default=100, help="Timed iterations\n")
+    parser.add_argument(
+        '--warmup',
+        type=int,
+        default=5,
+        help="Untimed iterations after the first run\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for cap in [int(c) for c in arguments.caps.split(",")]:
+        print("Running with cap %d" % cap)
+        results[cap] = run_config(cap, arguments)
+
+    print()
+    print("%12s %9s %13s %12s %11s %12s %11s" %
+          ("cap", "clusters", "first run ms", "translate ms", "compile ms",
+           "peak rss mb", "latency ms"))
+    for cap, result in results.items():
+        if "error" in result:
+            print("%12d failed:\n  %s" % (cap, "\n  ".join(result["error"])))
+            continue
+        print("%12d %9d %13.1f %12.1f %11.1f %12.1f %11.3f" %
+              (cap, result["clusters"], result["first_run_ms"],
+               result["translate_ms"], result["compile_ms"],
+               result["peak_rss_mb"], result["latency_ms"]))
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
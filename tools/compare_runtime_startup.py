@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares the startup time and memory of a fully offloaded model running
+with TensorFlow + openvino_tensorflow against the TF-free runtime
+(ovtf_runtime) running the exported cluster bundle.
+
+Example:
+    python3 compare_runtime_startup.py --saved_model resnet50/ \\
+        --export_dir bundle/ --ovtf_run build_cmake/artifacts/ovtf_runtime/ovtf_run
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import time
+
+# Runs in a separate process so that the measurements are not polluted by
+# this script. Prints a single JSON line with the results.
+TF_SCRIPT = r'''
+import json, resource, sys, time
+start = time.time()
+import numpy as np
+import tensorflow as tf
+import openvino_tensorflow as ovtf
+import_time = time.time() - start
+ovtf.set_backend(sys.argv[2])
+model = tf.saved_model.load(sys.argv[1])
+infer = model.signatures["serving_default"]
+inputs = {}
+for name, spec in infer.structured_input_signature[1].items():
+    shape = [1 if d is None else d for d in spec.shape.as_list()]
+    inputs[name] = tf.zeros(shape, dtype=spec.dtype)
+load_time = time.time() - start
+t = time.time()
+infer(**inputs)
+first_inference_time = time.time() - t
+startup_time = time.time() - start
+if sys.argv[3]:
+    ovtf.export_ir(sys.argv[3])
+print(json.dumps({
+    "import_ms": import_time * 1000,
+    "load_ms": load_time * 1000,
+    "first_inference_ms": first_inference_time * 1000,
+    "startup_ms": startup_time * 1000,
+    "peak_rss_kb": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss,
+}))
+'''
+
+
+def run_tf(arguments):
+    start = time.time()
+    output = subprocess.check_output([
+        sys.executable, "-c", TF_SCRIPT, arguments.saved_model,
+        arguments.backend, arguments.export_dir or ""
+    ])
+    wall_time = (time.time() - start) * 1000
+    result = json.loads(output.decode("utf-8").strip().splitlines()[-1])
+    result["wall_ms"] = wall_time
+    return result
+
+
+def run_ovtf_runtime(arguments, bundle_prefix):
+    start = time.time()
+    output = subprocess.check_output(
+        [arguments.ovtf_run, bundle_prefix, arguments.backend, "0"])
+    wall_time = (time.time() - start) * 1000
+    result = {"wall_ms": wall_time}
+    keys = {
+        "Load-and-compile": "load_ms",
+        "First-inference": "first_inference_ms",
+        "Startup": "startup_ms",
+        "Peak-RSS": "peak_rss_kb",
+    }
+    for line in output.decode("utf-8").splitlines():
+        if not line.startswith("OVTF_RUNTIME: "):
+            continue
+        key, value = line[len("OVTF_RUNTIME: "):].split(": ")
+        if key in keys:
+            result[keys[key]] = float(value.split()[0])
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--saved_model', help="Location of the SavedModel\n", required=True)
+    parser.add_argument(
+        '--export_dir',
+        help="Directory where the cluster bundle is exported\n",
+        required=True)
+    parser.add_argument(
+        '--ovtf_run', help="Location of the ovtf_run binary\n", required=True)
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    arguments = parser.parse_args()
+
+    if not os.path.isdir(arguments.export_dir):
+        os.makedirs(arguments.export_dir)
+
+    tf_result = run_tf(arguments)
+
+    bundles = glob.glob(os.path.join(arguments.export_dir, "*.sig"))
+    if len(bundles) != 1:
+        raise Exception(
+            "Expected exactly one cluster bundle in " + arguments.export_dir +
+            ", found " + str(len(bundles)) +
+            ". The model must be fully offloaded to a single cluster.")
+    runtime_result = run_ovtf_runtime(arguments, bundles[0][:-len(".sig")])
+
+    print("%-22s %18s %18s" % ("", "TF + ovtf", "ovtf_runtime"))
+    for key, label in [("wall_ms", "Process wall (ms)"),
+                       ("load_ms", "Load (ms)"),
+                       ("first_inference_ms", "First inference (ms)"),
+                       ("startup_ms", "Startup (ms)"),
+                       ("peak_rss_kb", "Peak RSS (KB)")]:
+        print("%-22s %18.1f %18.1f" % (label, tf_result.get(key, -1),
+                                       runtime_result.get(key, -1)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Measures the startup time of several independent sessions, created one
+after the other and then concurrently from a thread each. The first run of a
+session goes through the openvino_tensorflow rewrite pass (marking,
+clustering and encapsulation) and compiles its clusters, so the ratio of the
+two times shows how much of the startup runs in parallel.
+
+Example:
+    python3 concurrent_session_startup.py --sessions 8 --layers 50
+"""
+
+import argparse
+import json
+import threading
+import time
+
+import numpy as np
+import tensorflow as tf
+import openvino_tensorflow as ovtf
+
+tf.compat.v1.disable_eager_execution()
+
+
+def build_graph(seed, layers, width):
+    graph = tf.Graph()
+    with graph.as_default():
+        rng = np.random.RandomState(seed)
+        x = tf.compat.v1.placeholder(tf.float32, shape=(1, width), name="x")
+        y = x
+        for i in range(layers):
+            w = tf.constant(
+                rng.rand(width, width).astype(np.float32) / width,
+                name="w_%d" % i)
+            y = tf.nn.relu(tf.matmul(y, w))
+        y = tf.identity(y, name="y")
+    return graph, x, y
+
+
+def start_session(seed, arguments, times):
+    graph, x, y = build_graph(seed, arguments.layers, arguments.width)
+    start = time.time()
+    with tf.compat.v1.Session(graph=graph) as sess:
+        sess.run(y, feed_dict={x: np.ones((1, arguments.width), np.float32)})
+        times[seed] = (time.time() - start) * 1000
+
+
+def run_sequential(arguments):
+    times = {}
+    start = time.time()
+    for seed in range(arguments.sessions):
+        start_session(seed, arguments, times)
+    return (time.time() - start) * 1000, times
+
+
+def run_concurrent(arguments):
+    times = {}
+    threads = [
+        threading.Thread(target=start_session, args=(seed, arguments, times))
+        for seed in range(arguments.sessions)
+    ]
+    start = time.time()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    return (time.time() - start) * 1000, times
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--sessions',
+        type=int,
+        default=8,
+        help="Number of independent sessions\n")
+    parser.add_argument(
+        '--layers', type=int, default=50, help="Layers of each model\n")
+    parser.add_argument(
+        '--width', type=int, default=256, help="Width of each layer\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    ovtf.set_backend(arguments.backend)
+
+    # Warm up the imports, the backend and the op registrations, so that the
+    # first measured session does not pay for them
+    warmup = argparse.Namespace(layers=1, width=arguments.width)
+    start_session(0, warmup, {})
+
+    sequential_ms, sequential_times = run_sequential(arguments)
+    concurrent_ms, concurrent_times = run_concurrent(arguments)
+
+    print("%-28s %12s %12s" % ("", "sequential", "concurrent"))
+    print("%-28s %12.1f %12.1f" % ("Total startup (ms)", sequential_ms,
+                                   concurrent_ms))
+    print("%-28s %12.1f %12.1f" %
+          ("Slowest session (ms)", max(sequential_times.values()),
+           max(concurrent_times.values())))
+    print("%-28s %25.2f" % ("Speedup", sequential_ms / concurrent_ms))
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump({
+                "sessions": arguments.sessions,
+                "sequential_ms": sequential_ms,
+                "concurrent_ms": concurrent_ms,
+                "sequential_session_ms": sequential_times,
+                "concurrent_session_ms": concurrent_times,
+            },
+                      json_file,
+                      indent=2)
+
+
+if __name__ == '__main__':
+    main()
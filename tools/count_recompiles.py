@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Counts the executables compiled by openvino_tensorflow for a model taking
+random crops of fixed size from its input, i.e. a Slice whose begin is
+computed from data, with and without OPENVINO_TF_DYNAMIC_STATIC_INPUTS.
+
+Example:
+    python3 count_recompiles.py --iterations 100
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+
+# Runs in a separate process since the environment variable is read when the
+# graph is rewritten. Prints a single JSON line with the results.
+MODEL_SCRIPT = r'''
+import json, sys, time
+import numpy as np
+import tensorflow as tf
+import openvino_tensorflow as ovtf
+tf.compat.v1.disable_eager_execution()
+ovtf.set_backend(sys.argv[1])
+iterations, size, crop = int(sys.argv[2]), int(sys.argv[3]), int(sys.argv[4])
+x = tf.compat.v1.placeholder(tf.float32, shape=(size, size), name="x")
+offset = tf.compat.v1.placeholder(tf.int32, shape=(2,), name="offset")
+# The begin is computed from data, so its value is only known at runtime
+begin = tf.math.floormod(offset * 7, size - crop)
+y = tf.nn.relu(tf.slice(tf.abs(x), begin, [crop, crop])) * 2.0
+data = np.random.rand(size, size).astype(np.float32)
+rng = np.random.RandomState(0)
+with tf.compat.v1.Session() as session:
+    ovtf.reset_metrics()
+    start = time.time()
+    for _ in range(iterations):
+        session.run(y, feed_dict={
+            x: data,
+            offset: rng.randint(0, size, size=2).astype(np.int32)})
+    elapsed = time.time() - start
+metrics = ovtf.get_metrics()
+print(json.dumps({
+    "compiled_executables": metrics.get("compiled_executables", 0),
+    "ms_per_iteration": elapsed * 1000 / iterations,
+}))
+'''
+
+
+def run(arguments, dynamic):
+    env = dict(os.environ)
+    if dynamic:
+        env["OPENVINO_TF_DYNAMIC_STATIC_INPUTS"] = "1"
+    else:
+        env.pop("OPENVINO_TF_DYNAMIC_STATIC_INPUTS", None)
+    output = subprocess.check_output([
+        sys.executable, "-c", MODEL_SCRIPT, arguments.backend,
+        str(arguments.iterations),
+        str(arguments.size),
+        str(arguments.crop)
+    ],
+                                     env=env)
+    return json.loads(output.decode("utf-8").strip().splitlines()[-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--iterations', type=int, default=100, help="Number of runs\n")
+    parser.add_argument(
+        '--size', type=int, default=64, help="Size of the input\n")
+    parser.add_argument('--crop', type=int, default=16, help="Size of crops\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    arguments = parser.parse_args()
+
+    static_result = run(arguments, False)
+    dynamic_result = run(arguments, True)
+    print("%-24s %12s %12s" % ("", "static", "runtime"))
+    for key, label in [("compiled_executables", "Compiled executables"),
+                       ("ms_per_iteration", "Time per iteration (ms)")]:
+        print("%-24s %12.2f %12.2f" % (label, static_result[key],
+                                       dynamic_result[key]))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Measures the per-image latency of a two-stage detector style model, where
+every image brings new boxes to CropAndResize, with native TensorFlow and
+with openvino_tensorflow. Each configuration runs in its own process.
+
+The model is a small convolutional backbone whose feature map is cropped
+at the boxes fed for the image, followed by a convolutional head on the
+crops. The number of compiled executables shows whether new boxes trigger
+recompiles.
+
+Example:
+    python3 crop_and_resize_latency.py --images 100 --boxes 300
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+
+def run_worker(arguments):
+    """Runs the model in the current process and prints the latencies."""
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    graph = tf.Graph()
+    with graph.as_default():
+        image = tf.compat.v1.placeholder(
+            tf.float32, shape=(1, arguments.size, arguments.size, 3),
+            name="image")
+        boxes = tf.compat.v1.placeholder(
+            tf.float32, shape=(arguments.boxes, 4), name="boxes")
+        box_indices = tf.zeros((arguments.boxes,), dtype=tf.int32)
+        features = image
+        for i in range(3):
+            filters = tf.constant(
+                rng.rand(3, 3, features.shape[-1], 32).astype(np.float32) /
+                10,
+                name="backbone_%d" % i)
+            features = tf.nn.relu(
+                tf.nn.conv2d(features, filters, 2, padding="SAME"))
+        crops = tf.image.crop_and_resize(features, boxes, box_indices, (7, 7))
+        head = tf.constant(
+            rng.rand(3, 3, 32, 16).astype(np.float32) / 10, name="head")
+        y = tf.reduce_mean(
+            tf.nn.relu(tf.nn.conv2d(crops, head, 1, padding="SAME")),
+            axis=[1, 2])
+        y = tf.identity(y, name="y")
+
+    def feed():
+        y1x1 = rng.uniform(0, 0.7, size=(arguments.boxes, 2))
+        y2x2 = y1x1 + rng.uniform(0.05, 0.3, size=(arguments.boxes, 2))
+        return {
+            image:
+            rng.rand(1, arguments.size, arguments.size, 3).astype(np.float32),
+            boxes:
+            np.concatenate([y1x1, y2x2], axis=1).astype(np.float32)
+        }
+
+    with tf.compat.v1.Session(graph=graph) as sess:
+        start = time.time()
+        sess.run(y, feed_dict=feed())
+        first_run = time.time() - start
+        latencies = []
+        for _ in range(arguments.images):
+            feed_dict = feed()
+            start = time.time()
+            sess.run(y, feed_dict=feed_dict)
+            latencies.append(time.time() - start)
+
+    latencies = sorted(latencies)
+    metrics = ovtf.get_metrics()
+    print_result({
+        "first_run_ms": first_run * 1000,
+        "mean_ms": 1000 * sum(latencies) / len(latencies),
+        "p50_ms": 1000 * latencies[len(latencies) // 2],
+        "p99_ms": 1000 * latencies[min(
+            len(latencies) - 1, int(len(latencies) * 0.99))],
+        "compiled_executables": metrics.get("compiled_executables", 0),
+        "compile_ms": metrics.get("compile_us", 0) / 1000,
+    })
+
+
+def run_config(native, arguments):
+    env = dict(os.environ)
+    env.pop("OPENVINO_TF_DISABLE", None)
+    if native:
+        env["OPENVINO_TF_DISABLE"] = "1"
+    return run_in_subprocess(__file__, sys.argv[1:], env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--images',
+        type=int,
+        default=100,
+        help="Timed images, each with new boxes\n")
+    parser.add_argument(
+        '--boxes', type=int, default=100, help="Boxes per image\n")
+    parser.add_argument(
+        '--size', type=int, default=256, help="Height and width of images\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for name, native in [("tensorflow", True), ("openvino", False)]:
+        print("Running with %s" % name)
+        results[name] = run_config(native, arguments)
+
+    print()
+    print("%12s %13s %9s %9s %9s %12s %11s" %
+          ("runtime", "first run ms", "mean ms", "p50 ms", "p99 ms",
+           "executables", "compile ms"))
+    for name, result in results.items():
+        if "error" in result:
+            print("%12s failed:\n  %s" % (name, "\n  ".join(result["error"])))
+            continue
+        print("%12s %13.1f %9.2f %9.2f %9.2f %12d %11.1f" %
+              (name, result["first_run_ms"], result["mean_ms"],
+               result["p50_ms"], result["p99_ms"],
+               result["compiled_executables"], result["compile_ms"]))
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Measures the time spent encapsulating the clusters of a chain of
+element-wise operators split in blocks, where every fifth block is made of
+disabled operators and stays in TensorFlow, so that the other blocks form one
+cluster each. Each number of nodes runs in its own process, and the time is
+read from the encapsulate_us counter of openvino_tensorflow.get_metrics().
+
+Example:
+    python3 encapsulate_large_graph.py --nodes 10000,50000 --block_size 500
+"""
+
+import argparse
+import json
+import time
+
+from benchmark_utils import print_result, run_in_subprocess
+
+
+def run_worker(arguments):
+    """Builds and runs the chain in the current process and prints the
+    results."""
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+    ovtf.set_disabled_ops("Neg")
+
+    x = tf.compat.v1.placeholder(tf.float32, shape=(2, 3), name="x")
+    y = x
+    for i in range(arguments.nodes):
+        if (i // arguments.block_size) % 5 == 4:
+            y = tf.negative(y)
+        else:
+            y = tf.abs(y)
+    y = tf.identity(y, name="y")
+
+    feed = np.ones((2, 3), dtype=np.float32)
+    with tf.compat.v1.Session() as sess:
+        ovtf.reset_metrics()
+        start = time.time()
+        sess.run(y, feed_dict={x: feed})
+        first_run = time.time() - start
+        metrics = ovtf.get_metrics()
+
+    print_result({
+        "encapsulate_ms": metrics.get("encapsulate_us", 0) / 1000.0,
+        "clusters": metrics.get("compiled_executables", 0),
+        "first_run_ms": first_run * 1000,
+    })
+
+
+def run_nodes(nodes, arguments):
+    return run_in_subprocess(__file__, [
+        "--nodes",
+        str(nodes), "--block_size",
+        str(arguments.block_size), "--backend", arguments.backend
+    ])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--nodes',
+        default="10000,50000",
+        help="Comma separated numbers of nodes of the chain\n")
+    parser.add_argument(
+        '--block_size', type=int, default=500, help="Nodes per block\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        arguments.nodes = int(arguments.nodes)
+        run_worker(arguments)
+        return
+
+    results = {}
+    for nodes in [int(n) for n in arguments.nodes.split(",")]:
+        print("Running a chain of %d nodes" % nodes)
+        results[nodes] = run_nodes(nodes, arguments)
+
+    print()
+    print("%10s %10s %16s %16s" % ("nodes", "clusters", "encapsulate ms",
+                                   "first run ms"))
+    for nodes, result in results.items():
+        if "error" in result:
+            print("%10d failed:\n  %s" % (nodes, "\n  ".join(result["error"])))
+            continue
+        print("%10d %10d %16.2f %16.2f" %
+              (nodes, result["clusters"], result["encapsulate_ms"],
+               result["first_run_ms"]))
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
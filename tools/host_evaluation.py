@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares the time per step of a cluster that only computes shapes and
+indices when it is compiled to an OpenVINO network and when it is evaluated
+on the host (OPENVINO_TF_HOST_EVAL_MAX_NODES). Each configuration runs in its
+own process, since the evaluation is chosen when the clusters are compiled.
+
+The cluster reads the shape of a float tensor and an integer scalar, and
+builds index tensors from them with StridedSlice, Pack and Range.
+
+Example:
+    python3 host_evaluation.py --steps 2000
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+CONFIGS = ["network", "host"]
+
+
+def run_worker(arguments):
+    """Runs the integer cluster in the current process and prints the
+    results."""
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    graph = tf.Graph()
+    with graph.as_default():
+        x = tf.compat.v1.placeholder(tf.float32, shape=(None, None), name="x")
+        n = tf.compat.v1.placeholder(tf.int32, shape=(), name="n")
+        shape = tf.shape(x)
+        rows = shape[0]
+        cols = shape[1]
+        size = tf.stack([rows * n, cols + n])
+        indices = tf.range(0, rows * cols + n, 2)
+        size = tf.identity(size, name="size")
+        indices = tf.identity(indices, name="indices")
+
+    feed = {x: np.zeros((4, 8), dtype=np.float32), n: 3}
+    with tf.compat.v1.Session(graph=graph) as sess:
+        # Compiles the clusters
+        for _ in range(10):
+            sess.run([size, indices], feed_dict=feed)
+        step_times = []
+        for _ in range(arguments.steps):
+            start = time.time()
+            sess.run([size, indices], feed_dict=feed)
+            step_times.append(time.time() - start)
+
+    metrics = ovtf.get_metrics()
+    step_times = np.array(step_times) * 1e6
+    print_result({
+        "mean_us":
+        float(np.mean(step_times)),
+        "p50_us":
+        float(np.percentile(step_times, 50)),
+        "p99_us":
+        float(np.percentile(step_times, 99)),
+        "host_evaluated_executables":
+        metrics.get("host_evaluated_executables", 0),
+    })
+
+
+def run_config(config, arguments):
+    env = dict(os.environ)
+    if config == "network":
+        env["OPENVINO_TF_HOST_EVAL_MAX_NODES"] = "0"
+    else:
+        env.pop("OPENVINO_TF_HOST_EVAL_MAX_NODES", None)
+    return run_in_subprocess(__file__, sys.argv[1:], env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--steps', type=int, default=2000, help="Timed steps\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for config in CONFIGS:
+        print("Running with the %s configuration" % config)
+        results[config] = run_config(config, arguments)
+
+    print()
+    print("%10s %10s %10s %10s %10s" % ("config", "mean us", "p50 us",
+                                        "p99 us", "host exec."))
+    for config, result in results.items():
+        if "error" in result:
+            print("%10s failed:\n  %s" % (config,
+                                          "\n  ".join(result["error"])))
+            continue
+        print("%10s %10.1f %10.1f %10.1f %10d" %
+              (config, result["mean_us"], result["p50_us"], result["p99_us"],
+               result["host_evaluated_executables"]))
+    if all("error" not in result for result in results.values()):
+        saved = results["network"]["mean_us"] - results["host"]["mean_us"]
+        print("\nSaved per step: %.1f us" % saved)
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Measures the latency of a small model sharing the process with a heavier
+model that keeps compiling new input shapes and running large batches, with
+and without quotas on the resources of the heavy model. Each configuration
+runs in its own process.
+
+With the grappler optimizer, the quotas are only given to the heavy model
+through openvino_tensorflow.update_config(). Otherwise they are the default
+quotas of every model (OPENVINO_TF_MODEL_MAX_* variables), so they also apply
+to the small model.
+
+Example:
+    python3 noisy_neighbour.py --noisy_clients 2 --requests 200 \\
+        --max_threads_per_network 2 --max_concurrent_compiles 1 \\
+        --max_cache_mb 256
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+CONFIGS = ["alone", "no_quotas", "quotas"]
+
+
+def build_mlp(rng, batch_size, width, layers, name):
+    import numpy as np
+    import tensorflow as tf
+
+    graph = tf.Graph()
+    with graph.as_default():
+        x = tf.compat.v1.placeholder(
+            tf.float32, shape=(batch_size, width), name="x")
+        y = x
+        for i in range(layers):
+            w = tf.constant(
+                rng.rand(width, width).astype(np.float32) / width,
+                name="%s_w_%d" % (name, i))
+            y = tf.nn.relu(tf.matmul(y, w))
+        y = tf.identity(y, name="y")
+    return graph, x, y
+
+
+def run_worker(arguments):
+    """Runs both models in the current process and prints the results."""
+    import threading
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    victim_graph, victim_x, victim_y = build_mlp(rng, 1, arguments.width, 4,
+                                                 "victim")
+    # The batch dimension is left dynamic, so that each new batch size
+    # compiles a new executable
+    noisy_graph, noisy_x, noisy_y = build_mlp(
+        rng, None, arguments.noisy_width, arguments.noisy_layers, "noisy")
+
+    victim_config = tf.compat.v1.ConfigProto()
+    noisy_config = tf.compat.v1.ConfigProto()
+    if ovtf.is_grappler_enabled():
+        # Lifts the default quotas set by the parent for the small model
+        victim_config = ovtf.update_config(
+            victim_config,
+            backend_name=arguments.backend,
+            model_tag="victim",
+            model_quotas={
+                "max_cache_mb": 0,
+                "max_concurrent_compiles": 0,
+                "max_threads_per_network": 0
+            })
+        quotas = {}
+        if arguments.config == "quotas":
+            quotas = {
+                "max_cache_mb": arguments.max_cache_mb,
+                "max_concurrent_compiles": arguments.max_concurrent_compiles,
+                "max_threads_per_network": arguments.max_threads_per_network
+            }
+        noisy_config = ovtf.update_config(
+            noisy_config,
+            backend_name=arguments.backend,
+            model_tag="noisy",
+            model_quotas=quotas)
+
+    victim_feed = rng.rand(1, arguments.width).astype(np.float32)
+    stop = threading.Event()
+
+    def noisy_client(seed):
+        client_rng = np.random.RandomState(seed)
+        with tf.compat.v1.Session(
+                graph=noisy_graph, config=noisy_config) as sess:
+            while not stop.is_set():
+                batch_size = int(client_rng.randint(1, arguments.noisy_batch))
+                feed = client_rng.rand(batch_size, arguments.noisy_width)
+                sess.run(
+                    noisy_y, feed_dict={noisy_x: feed.astype(np.float32)})
+
+    latencies = []
+    with tf.compat.v1.Session(
+            graph=victim_graph, config=victim_config) as sess:
+        # Compiles the clusters of the small model
+        sess.run(victim_y, feed_dict={victim_x: victim_feed})
+
+        threads = []
+        if arguments.config != "alone":
+            threads = [
+                threading.Thread(target=noisy_client, args=(i, ))
+                for i in range(arguments.noisy_clients)
+            ]
+        for thread in threads:
+            thread.start()
+        for _ in range(arguments.requests):
+            start = time.time()
+            sess.run(victim_y, feed_dict={victim_x: victim_feed})
+            latencies.append(time.time() - start)
+        stop.set()
+        for thread in threads:
+            thread.join()
+
+    latencies = np.array(latencies) * 1000
+    print_result({
+        "mean_ms": float(np.mean(latencies)),
+        "p50_ms": float(np.percentile(latencies, 50)),
+        "p99_ms": float(np.percentile(latencies, 99)),
+        "per_model_quotas": bool(ovtf.is_grappler_enabled()),
+        "usage": ovtf.get_model_usage(),
+    })
+
+
+def run_config(config, arguments):
+    env = dict(os.environ)
+    if config == "quotas":
+        # Without the grappler optimizer the quotas can only be given to all
+        # the models; with it, the worker overrides them per model
+        env["OPENVINO_TF_MODEL_MAX_CACHE_MB"] = str(arguments.max_cache_mb)
+        env["OPENVINO_TF_MODEL_MAX_CONCURRENT_COMPILES"] = str(
+            arguments.max_concurrent_compiles)
+        env["OPENVINO_TF_MODEL_MAX_THREADS_PER_NETWORK"] = str(
+            arguments.max_threads_per_network)
+    return run_in_subprocess(__file__, ["--config", config] + sys.argv[1:],
+                             env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument('--config', default="alone", help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--requests',
+        type=int,
+        default=200,
+        help="Requests sent to the small model\n")
+    parser.add_argument(
+        '--width', type=int, default=256, help="Width of the small model\n")
+    parser.add_argument(
+        '--noisy_clients',
+        type=int,
+        default=2,
+        help="Clients sending requests to the heavy model\n")
+    parser.add_argument(
+        '--noisy_batch',
+        type=int,
+        default=64,
+        help="The batch size of the heavy model is drawn below this value\n")
+    parser.add_argument(
+        '--noisy_layers',
+        type=int,
+        default=16,
+        help="Layers of the heavy model\n")
+    parser.add_argument(
+        '--noisy_width',
+        type=int,
+        default=1024,
+        help="Width of the heavy model\n")
+    parser.add_argument(
+        '--max_cache_mb',
+        type=int,
+        default=256,
+        help="Cache quota of the heavy model\n")
+    parser.add_argument(
+        '--max_concurrent_compiles',
+        type=int,
+        default=1,
+        help="Compile quota of the heavy model\n")
+    parser.add_argument(
+        '--max_threads_per_network',
+        type=int,
+        default=2,
+        help="Thread quota of each network of the heavy model\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for config in CONFIGS:
+        print("Running the %s configuration" % config)
+        results[config] = run_config(config, arguments)
+
+    print()
+    print("%12s %10s %10s %10s" % ("config", "mean ms", "p50 ms", "p99 ms"))
+    for config, result in results.items():
+        if "error" in result:
+            print("%12s failed:\n  %s" % (config,
+                                          "\n  ".join(result["error"])))
+            continue
+        print("%12s %10.2f %10.2f %10.2f" % (config, result["mean_ms"],
+                                             result["p50_ms"],
+                                             result["p99_ms"]))
+    quotas = results["quotas"]
+    if "error" not in quotas and not quotas["per_model_quotas"]:
+        print("\nThe grappler optimizer is disabled, so the quotas also "
+              "applied to the small model")
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Measures the goodput of openvino_tensorflow under overload. More requests
+than the device can serve are issued concurrently, each with a deadline. Only
+the requests that complete within their deadline count towards the goodput;
+the others are cancelled by TensorFlow, and with cancellation honored their
+pending work no longer delays the requests that can still meet the deadline.
+
+Example:
+    python3 overload_goodput.py --threads 16 --timeout_ms 50 --duration 30
+"""
+
+import argparse
+import threading
+import time
+
+import numpy as np
+import tensorflow as tf
+import openvino_tensorflow as ovtf
+
+tf.compat.v1.disable_eager_execution()
+
+
+def build_graph(arguments):
+    x = tf.compat.v1.placeholder(
+        tf.float32, shape=(None, arguments.size, arguments.size), name="x")
+    y = x
+    for _ in range(arguments.depth):
+        y = tf.nn.relu(tf.matmul(y, y) / arguments.size)
+    return x, y
+
+
+def worker(session, x, y, arguments, stop_time, results, lock):
+    feed = {
+        x:
+        np.random.rand(arguments.batch, arguments.size,
+                       arguments.size).astype(np.float32)
+    }
+    options = tf.compat.v1.RunOptions(timeout_in_ms=arguments.timeout_ms)
+    completed, expired, latencies = 0, 0, []
+    while time.time() < stop_time:
+        start = time.time()
+        try:
+            session.run(y, feed_dict=feed, options=options)
+            completed += 1
+            latencies.append((time.time() - start) * 1000)
+        except tf.errors.DeadlineExceededError:
+            expired += 1
+        except tf.errors.CancelledError:
+            expired += 1
+    with lock:
+        results["completed"] += completed
+        results["expired"] += expired
+        results["latencies"].extend(latencies)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--threads', type=int, default=16, help="Concurrent requests\n")
+    parser.add_argument(
+        '--timeout_ms', type=int, default=50, help="Deadline per request\n")
+    parser.add_argument(
+        '--duration', type=float, default=30, help="Duration in seconds\n")
+    parser.add_argument(
+        '--size', type=int, default=256, help="Matrix size of the model\n")
+    parser.add_argument(
+        '--depth', type=int, default=8, help="Number of layers\n")
+    parser.add_argument('--batch', type=int, default=4, help="Batch size\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    arguments = parser.parse_args()
+
+    ovtf.set_backend(arguments.backend)
+    x, y = build_graph(arguments)
+    with tf.compat.v1.Session() as session:
+        # Warm-up outside of the measurement, without deadline
+        session.run(
+            y,
+            feed_dict={
+                x:
+                np.zeros((arguments.batch, arguments.size, arguments.size),
+                         dtype=np.float32)
+            })
+        ovtf.reset_metrics()
+
+        results = {"completed": 0, "expired": 0, "latencies": []}
+        lock = threading.Lock()
+        stop_time = time.time() + arguments.duration
+        threads = [
+            threading.Thread(
+                target=worker,
+                args=(session, x, y, arguments, stop_time, results, lock))
+            for _ in range(arguments.threads)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+    total = results["completed"] + results["expired"]
+    print("Requests:         %d" % total)
+    print("Completed:        %d" % results["completed"])
+    print("Deadline missed:  %d" % results["expired"])
+    print("Goodput (req/s):  %.2f" % (results["completed"] /
+                                      arguments.duration))
+    if results["latencies"]:
+        print("p50 latency (ms): %.2f" % np.percentile(results["latencies"],
+                                                      50))
+        print("p99 latency (ms): %.2f" % np.percentile(results["latencies"],
+                                                      99))
+    for name, value in sorted(ovtf.get_metrics().items()):
+        print("%-17s %d" % (name + ":", value))
+
+
+if __name__ == '__main__':
+    main()
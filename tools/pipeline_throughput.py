@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares the throughput of a large model compiled as a single executable
+with the same model split in a pipeline of stages pinned to disjoint core
+groups (OPENVINO_TF_PIPELINE_STAGES). Each configuration runs in its own
+process, since the pipelining is decided when the clusters are compiled.
+
+The model is a deep stack of dense layers, so that it forms one large
+cluster.
+
+Example:
+    python3 pipeline_throughput.py --stages 1,2,4 --batch_size 64 \\
+        --micro_batches 8
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+
+def run_worker(arguments):
+    """Runs the model in the current process and prints the throughput."""
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    graph = tf.Graph()
+    with graph.as_default():
+        x = tf.compat.v1.placeholder(
+            tf.float32, shape=(arguments.batch_size, arguments.width), name="x")
+        y = x
+        for i in range(arguments.layers):
+            w = tf.constant(
+                rng.rand(arguments.width, arguments.width).astype(np.float32) /
+                arguments.width,
+                name="w_%d" % i)
+            y = tf.nn.relu(tf.matmul(y, w))
+        y = tf.identity(y, name="y")
+
+    feed = rng.rand(arguments.batch_size, arguments.width).astype(np.float32)
+    with tf.compat.v1.Session(graph=graph) as sess:
+        # Compiles the clusters
+        sess.run(y, feed_dict={x: feed})
+        for _ in range(arguments.warmup):
+            sess.run(y, feed_dict={x: feed})
+        start = time.time()
+        for _ in range(arguments.iterations):
+            sess.run(y, feed_dict={x: feed})
+        elapsed = time.time() - start
+
+    metrics = ovtf.get_metrics()
+    print_result({
+        "throughput_per_s":
+        arguments.batch_size * arguments.iterations / elapsed,
+        "latency_ms": elapsed * 1000 / arguments.iterations,
+        "pipelined_executables": metrics.get("pipelined_executables", 0),
+    })
+
+
+def run_config(stages, arguments):
+    env = dict(os.environ)
+    env.pop("OPENVINO_TF_PIPELINE_STAGES", None)
+    if stages > 1:
+        env["OPENVINO_TF_PIPELINE_STAGES"] = str(stages)
+        env["OPENVINO_TF_PIPELINE_MICRO_BATCHES"] = str(
+            arguments.micro_batches or stages)
+        env["OPENVINO_TF_PIPELINE_QUEUE_DEPTH"] = str(arguments.queue_depth)
+    return run_in_subprocess(__file__, sys.argv[1:], env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--stages',
+        default="1,2,4",
+        help="Comma separated numbers of stages, 1 being the single\n"
+        "executable baseline\n")
+    parser.add_argument(
+        '--micro_batches',
+        type=int,
+        default=0,
+        help="Micro-batches per batch (the number of stages by default)\n")
+    parser.add_argument(
+        '--queue_depth',
+        type=int,
+        default=2,
+        help="Micro-batches queued between two stages\n")
+    parser.add_argument(
+        '--batch_size', type=int, default=64, help="Batch size\n")
+    parser.add_argument(
+        '--layers', type=int, default=64, help="Layers of the model\n")
+    parser.add_argument(
+        '--width', type=int, default=1024, help="Width of each layer\n")
+    parser.add_argument(
+        '--iterations', type=int, default=50, help="Timed iterations\n")
+    parser.add_argument(
+        '--warmup',
+        type=int,
+        default=5,
+        help="Untimed iterations after the first run\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for stages in [int(s) for s in arguments.stages.split(",")]:
+        print("Running with %d stage(s)" % stages)
+        results[stages] = run_config(stages, arguments)
+
+    baseline = results.get(1)
+    print()
+    print("%8s %14s %12s %10s" % ("stages", "throughput/s", "latency ms",
+                                  "speedup"))
+    for stages, result in results.items():
+        if "error" in result:
+            print("%8d failed:\n  %s" % (stages, "\n  ".join(result["error"])))
+            continue
+        speedup = ""
+        if baseline and "error" not in baseline:
+            speedup = "%9.2fx" % (result["throughput_per_s"] /
+                                  baseline["throughput_per_s"])
+        print("%8d %14.1f %12.2f %10s" % (stages, result["throughput_per_s"],
+                                          result["latency_ms"], speedup))
+        if stages > 1 and result["pipelined_executables"] == 0:
+            print("%8s the model was not pipelined" % "")
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares the compile time and latency of a model for several selections
+of the simplification passes run after translation
+(OPENVINO_TF_SIMPLIFY_PASSES). Each selection runs in its own process,
+since the passes run when the clusters are translated.
+
+The model is a stack of blocks with the redundancy left by translating each
+op on its own: repeated constants, duplicated subexpressions, transposes
+that undo each other, chains of reshapes and of widening casts.
+
+Example:
+    python3 simplify_passes.py --configs "0,constants,redundant_ops,cse,"
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+
+def run_worker(arguments):
+    """Runs the model in the current process and prints the measurements."""
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    weights = rng.rand(arguments.width, arguments.width).astype(
+        np.float32) / arguments.width
+    graph = tf.Graph()
+    with graph.as_default():
+        x = tf.compat.v1.placeholder(
+            tf.float32,
+            shape=(arguments.batch_size, arguments.width, arguments.width),
+            name="x")
+        y = x
+        for i in range(arguments.blocks):
+            # The same weights in two constants, read by two identical
+            # branches
+            a = tf.nn.relu(tf.matmul(y, tf.constant(weights)))
+            b = tf.nn.relu(tf.matmul(y, tf.constant(weights)))
+            y = a + b
+            y = tf.transpose(tf.transpose(y, [0, 2, 1]), [0, 2, 1])
+            y = tf.reshape(
+                tf.reshape(y, [-1, arguments.width]),
+                [arguments.batch_size, arguments.width, arguments.width])
+            y = y * tf.cast(tf.cast(tf.constant(i + 1, tf.int8), tf.int32),
+                            tf.float32)
+        y = tf.identity(y, name="y")
+
+    feed = rng.rand(arguments.batch_size, arguments.width,
+                    arguments.width).astype(np.float32)
+    with tf.compat.v1.Session(graph=graph) as sess:
+        start = time.time()
+        sess.run(y, feed_dict={x: feed})
+        first_run = time.time() - start
+        for _ in range(arguments.warmup):
+            sess.run(y, feed_dict={x: feed})
+        start = time.time()
+        for _ in range(arguments.iterations):
+            sess.run(y, feed_dict={x: feed})
+        elapsed = time.time() - start
+
+    metrics = ovtf.get_metrics()
+    print_result({
+        "first_run_ms": first_run * 1000,
+        "translate_ms": metrics.get("translate_us", 0) / 1000,
+        "compile_ms": metrics.get("compile_us", 0) / 1000,
+        "simplified_nodes": metrics.get("simplified_nodes", 0),
+        "latency_ms": elapsed * 1000 / arguments.iterations,
+    })
+
+
+def run_config(passes, arguments):
+    env = dict(os.environ)
+    env.pop("OPENVINO_TF_SIMPLIFY_PASSES", None)
+    if passes:
+        env["OPENVINO_TF_SIMPLIFY_PASSES"] = passes
+    return run_in_subprocess(__file__, sys.argv[1:], env)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--configs',
+        default="0,",
+        help="Comma separated values of OPENVINO_TF_SIMPLIFY_PASSES, each\n"
+        "selecting a single pass, \"0\" for none and an empty value for\n"
+        "all of them\n")
+    parser.add_argument(
+        '--batch_size', type=int, default=1, help="Batch size\n")
+    parser.add_argument(
+        '--blocks', type=int, default=32, help="Blocks of the model\n")
+    parser.add_argument(
+        '--width', type=int, default=64, help="Width of each block\n")
+    parser.add_argument(
+        '--iterations', type=int, default=100, help="Timed iterations\n")
+    parser.add_argument(
+        '--warmup',
+        type=int,
+        default=5,
+        help="Untimed iterations after the first run\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for passes in arguments.configs.split(","):
+        name = passes or "all"
+        print("Running with passes: %s" % name)
+        results[name] = run_config(passes, arguments)
+
+    print()
+    print("%14s %13s %12s %11s %10s %11s" %
+          ("passes", "first run ms", "translate ms", "compile ms",
+           "removed", "latency ms"))
+    for name, result in results.items():
+        if "error" in result:
+            print("%14s failed:\n  %s" % (name, "\n  ".join(result["error"])))
+            continue
+        print("%14s %13.1f %12.1f %11.1f %10d %11.3f" %
+              (name, result["first_run_ms"], result["translate_ms"],
+               result["compile_ms"], result["simplified_nodes"],
+               result["latency_ms"]))
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# ==============================================================================
+# Copyright (C) 2021 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Compares the clusters and the inference time of a graph exported with
+training-time debug ops (CheckNumerics, Print, StopGradient) between its
+layers, without stripping, with OPENVINO_TF_STRIP_DEBUG_OPS and with
+OPENVINO_TF_STRIP_ASSERTS as well. Each configuration runs in its own
+process, since the variables are read when the graph is rewritten.
+
+Example:
+    python3 strip_debug_ops.py --layers 8 --iterations 200
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+from benchmark_utils import print_result, run_in_subprocess
+
+CONFIGS = ["keep", "strip", "strip_asserts"]
+
+
+def run_worker(arguments):
+    """Runs the graph in the current process and prints the results."""
+    import time
+
+    import numpy as np
+    import tensorflow as tf
+    import openvino_tensorflow as ovtf
+
+    tf.compat.v1.disable_eager_execution()
+    ovtf.set_backend(arguments.backend)
+
+    rng = np.random.RandomState(0)
+    x = tf.compat.v1.placeholder(
+        tf.float32, shape=(arguments.batch_size, arguments.width), name="x")
+    y = x
+    for i in range(arguments.layers):
+        w = tf.constant(
+            rng.rand(arguments.width, arguments.width).astype(np.float32) /
+            arguments.width)
+        y = tf.nn.relu(tf.matmul(y, w))
+        y = tf.debugging.check_numerics(y, "layer %d" % i)
+        y = tf.compat.v1.Print(y, [tf.reduce_mean(y)], "layer %d: " % i)
+        y = tf.stop_gradient(y)
+    y = tf.identity(y, name="y")
+
+    feed = rng.rand(arguments.batch_size, arguments.width).astype(np.float32)
+    with tf.compat.v1.Session() as sess:
+        ovtf.reset_metrics()
+        # Compiles the clusters
+        sess.run(y, feed_dict={x: feed})
+        clusters = ovtf.get_metrics().get("compiled_executables", 0)
+        start = time.time()
+        for _ in range(arguments.iterations):
+            sess.run(y, feed_dict={x: feed})
+        elapsed = time.time() - start
+
+    print_result({
+        "clusters": clusters,
+        "ms_per_iteration": elapsed * 1000 / arguments.iterations,
+    })
+
+
+def run_config(config, arguments):
+    env = dict(os.environ)
+    env["OPENVINO_TF_LOG_PLACEMENT"] = "1"
+    env.pop("OPENVINO_TF_STRIP_DEBUG_OPS", None)
+    env.pop("OPENVINO_TF_STRIP_ASSERTS", None)
+    if config != "keep":
+        env["OPENVINO_TF_STRIP_DEBUG_OPS"] = "1"
+    if config == "strip_asserts":
+        env["OPENVINO_TF_STRIP_ASSERTS"] = "1"
+
+    def avoided_splits(output):
+        return {
+            "avoided_splits":
+            sum(
+                int(count) for count in re.findall(
+                    r"cluster splits avoided .*: (\d+)", output))
+        }
+
+    return run_in_subprocess(__file__, sys.argv[1:], env, avoided_splits)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        '--worker', action='store_true', help=argparse.SUPPRESS)
+    parser.add_argument(
+        '--layers',
+        type=int,
+        default=8,
+        help="Layers of the model, each followed by debug ops\n")
+    parser.add_argument(
+        '--width', type=int, default=256, help="Width of each layer\n")
+    parser.add_argument(
+        '--batch_size', type=int, default=1, help="Batch size\n")
+    parser.add_argument(
+        '--iterations', type=int, default=200, help="Timed iterations\n")
+    parser.add_argument(
+        '--backend', help="Backend to use (CPU by default)\n", default="CPU")
+    parser.add_argument(
+        '--json', help="Writes the results to this file\n", default=None)
+    arguments = parser.parse_args()
+
+    if arguments.worker:
+        run_worker(arguments)
+        return
+
+    results = {}
+    for config in CONFIGS:
+        print("Running the %s configuration" % config)
+        results[config] = run_config(config, arguments)
+
+    print()
+    print("%14s %10s %16s %16s" % ("config", "clusters", "splits avoided",
+                                   "ms/iteration"))
+    for config, result in results.items():
+        if "error" in result:
+            print("%14s failed:\n  %s" % (config,
+                                          "\n  ".join(result["error"])))
+            continue
+        print("%14s %10d %16d %16.2f" %
+              (config, result["clusters"], result["avoided_splits"],
+               result["ms_per_iteration"]))
+
+    if arguments.json:
+        with open(arguments.json, "w") as json_file:
+            json.dump(results, json_file, indent=2)
+
+
+if __name__ == '__main__':
+    main()